@@ -110,6 +110,121 @@ BrowserWindow.fromBrowserView = (browserView: BrowserView) => {
   return BrowserWindow.fromWebContents(browserView.webContents);
 };
 
+class BrowserWindowTemplate {
+  #options: Electron.BrowserWindowConstructorOptions;
+  #url?: string;
+  #file?: string;
+  #poolSize: number;
+  #warm: BWT[] = [];
+  // The window being warmed up, they are created one at a time.
+  #pending: BWT | null = null;
+  #replenishScheduled = false;
+  #destroyed = false;
+
+  constructor (options: Electron.BrowserWindowTemplateOptions) {
+    const { url, file, poolSize = 1, ...windowOptions } = options || {};
+    if (url != null && file != null) {
+      throw new Error('Only one of url and file can be set.');
+    }
+    if (!Number.isInteger(poolSize) || poolSize < 0) {
+      throw new Error('poolSize must be a non-negative integer.');
+    }
+    this.#options = windowOptions;
+    this.#url = url;
+    this.#file = file;
+    this.#poolSize = poolSize;
+    this.#scheduleReplenish();
+  }
+
+  get poolSize () {
+    return this.#poolSize;
+  }
+
+  get warmCount () {
+    return this.#warm.length;
+  }
+
+  claim (): BWT {
+    if (this.#destroyed) {
+      throw new Error('The window template is destroyed.');
+    }
+    const win = this.#warm.shift();
+    this.#scheduleReplenish();
+    if (!win) {
+      // Nothing is warm yet, so this is as fast as creating the window.
+      const cold = new BrowserWindow(this.#options);
+      this.#load(cold);
+      return cold;
+    }
+    win.removeListener('closed', this.#onWarmWindowGone);
+    win.webContents.removeListener('render-process-gone', this.#onWarmWindowGone);
+    if (this.#options.show !== false) win.show();
+    return win;
+  }
+
+  destroy () {
+    if (this.#destroyed) return;
+    this.#destroyed = true;
+    for (const win of [...this.#warm, this.#pending]) {
+      if (win && !win.isDestroyed()) win.destroy();
+    }
+    this.#warm = [];
+    this.#pending = null;
+  }
+
+  #load (win: BWT) {
+    const loaded = this.#file != null
+      ? win.loadFile(this.#file)
+      : win.loadURL(this.#url ?? 'about:blank');
+    return loaded.catch(() => {});
+  }
+
+  // The windows are warmed up after the current task, one at a time, so that
+  // claiming a window is not slowed down by its replacement.
+  #scheduleReplenish () {
+    if (this.#replenishScheduled) return;
+    this.#replenishScheduled = true;
+    setImmediate(() => {
+      this.#replenishScheduled = false;
+      this.#replenish();
+    });
+  }
+
+  async #replenish () {
+    if (this.#destroyed || this.#pending || this.#warm.length >= this.#poolSize) return;
+    const win = new BrowserWindow({ ...this.#options, show: false });
+    // Listen before loading, the renderer can crash while the page loads.
+    win.once('closed', this.#onWarmWindowGone);
+    win.webContents.once('render-process-gone', this.#onWarmWindowGone);
+    this.#pending = win;
+    await this.#load(win);
+    this.#pending = null;
+    // A window that did not survive its warm up is not replaced until the
+    // next claim, so that a crashing page is not reloaded in a loop.
+    if (this.#destroyed || win.isDestroyed() || win.webContents.isCrashed()) {
+      if (!win.isDestroyed()) win.destroy();
+      return;
+    }
+    this.#warm.push(win);
+    this.#scheduleReplenish();
+  }
+
+  #onWarmWindowGone = () => {
+    const gone = this.#warm.filter(win => win.isDestroyed() || win.webContents.isCrashed());
+    // The pending window is checked once it loaded.
+    if (gone.length === 0) return;
+    this.#warm = this.#warm.filter(win => !gone.includes(win));
+    for (const win of gone) {
+      if (!win.isDestroyed()) win.destroy();
+    }
+    this.#scheduleReplenish();
+  }
+}
+
+BrowserWindow.createTemplate = (options: Electron.BrowserWindowTemplateOptions) => {
+  return new BrowserWindowTemplate(options);
+};
+
 BrowserWindow.prototype.setTouchBar = function (touchBar) {
   (TouchBar as any)._setOnWindow(touchBar, this);
 };
@@ -1 +1,34 @@
-export default process._linkedBinding('electron_browser_content_tracing');
+import { Readable } from 'stream';
+
+const binding = process._linkedBinding('electron_browser_content_tracing');
+
+const createSnapshotStream = () => {
+  const stream = new Readable({ read () {} });
+  const started = binding.snapshotStream(
+    (chunk: Buffer) => { stream.push(chunk); },
+    (error: string) => {
+      if (error) {
+        stream.destroy(new Error(error));
+      } else {
+        stream.push(null);
+      }
+    });
+  if (!started) {
+    process.nextTick(() => {
+      stream.destroy(new Error('Failed to take a snapshot (is the flight recorder running?)'));
+    });
+  }
+  return stream;
+};
+
+export default {
+  getCategories: binding.getCategories,
+  startRecording: binding.startRecording,
+  stopRecording: binding.stopRecording,
+  getTraceBufferUsage: binding.getTraceBufferUsage,
+  startFlightRecorder: binding.startFlightRecorder,
+  stopFlightRecorder: binding.stopFlightRecorder,
+  isFlightRecorderRunning: binding.isFlightRecorderRunning,
+  snapshot: binding.snapshot,
+  createSnapshotStream
+};
@@ -1,4 +1,4 @@
-const { createDesktopCapturer } = process._linkedBinding('electron_browser_desktop_capturer');
+const { createDesktopCapturer, createSourceWatcher } = process._linkedBinding('electron_browser_desktop_capturer');
 
 const deepEqual = (a: ElectronInternal.GetSourcesOptions, b: ElectronInternal.GetSourcesOptions) => JSON.stringify(a) === JSON.stringify(b);
 
@@ -69,3 +69,16 @@ export async function getSources (args: Electron.SourcesOptions) {
 
   return getSources;
 }
+
+export function watchSources (args: Electron.WatchSourcesOptions) {
+  if (!isValid(args)) throw new Error('Invalid options');
+
+  const { thumbnailSize = { width: 150, height: 150 } } = args;
+  const { fetchWindowIcons = false, updateInterval = 1000 } = args;
+  if (typeof updateInterval !== 'number' || updateInterval <= 0) {
+    throw new Error('updateInterval must be a positive number');
+  }
+
+  return createSourceWatcher(args.types.includes('window'), args.types.includes('screen'),
+    thumbnailSize, fetchWindowIcons, updateInterval);
+}
@@ -1,5 +1,21 @@
 import { IpcMainImpl } from '@electron/internal/browser/ipc-main-impl';
 
-const ipcMain = new IpcMainImpl();
+const ipcMainBinding = process._linkedBinding('electron_browser_ipc_main');
+
+class IpcMain extends IpcMainImpl {
+  constructor () {
+    super('global');
+  }
+
+  getChannelStats () {
+    return ipcMainBinding.getChannelStats();
+  }
+
+  resetChannelStats () {
+    ipcMainBinding.resetChannelStats();
+  }
+}
+
+const ipcMain = new IpcMain();
 
 export default ipcMain;
@@ -37,6 +37,11 @@ const MenuItem = function (this: any, options: any) {
   this.overrideProperty('acceleratorWorksWhenHidden', true);
   this.overrideProperty('registerAccelerator', roles.shouldRegisterAccelerator(this.role));
 
+  // The native menu caches these, push their changes to it.
+  for (const name of MenuItem.commandStateProperties) {
+    this.trackCommandStateProperty(name);
+  }
+
   if (!MenuItem.types.includes(this.type)) {
     throw new Error(`Unknown menu item type: ${this.type}`);
   }
@@ -71,6 +76,7 @@ const MenuItem = function (this: any, options: any) {
 };
 
 MenuItem.types = ['normal', 'separator', 'submenu', 'checkbox', 'radio'];
+MenuItem.commandStateProperties = ['enabled', 'visible', 'checked', 'acceleratorWorksWhenHidden', 'registerAccelerator'];
 
 MenuItem.prototype.getDefaultRoleAccelerator = function () {
   return roles.getDefaultAccelerator(this.role);
@@ -81,6 +87,34 @@ MenuItem.prototype.getCheckStatus = function () {
   return roles.getCheckStatus(this.role);
 };
 
+MenuItem.prototype.getCommandState = function () {
+  const dynamicChecked = roles.shouldOverrideCheckStatus(this.role);
+  return {
+    commandId: this.commandId,
+    checked: dynamicChecked ? false : this.checked,
+    dynamicChecked,
+    enabled: this.enabled,
+    visible: this.visible,
+    acceleratorWorksWhenHidden: !!this.acceleratorWorksWhenHidden,
+    registerAccelerator: this.registerAccelerator,
+    accelerator: this.accelerator,
+    defaultAccelerator: this.accelerator == null ? this.getDefaultRoleAccelerator() : undefined
+  };
+};
+
+MenuItem.prototype.trackCommandStateProperty = function (name: string) {
+  let value = this[name];
+  Object.defineProperty(this, name, {
+    enumerable: true,
+    configurable: true,
+    get: () => value,
+    set: (newValue) => {
+      value = newValue;
+      if (this.menu) this.menu._updateCommandStates([this]);
+    }
+  });
+};
+
 MenuItem.prototype.overrideProperty = function (name: string, defaultValue: any = null) {
   if (this[name] == null) {
     this[name] = defaultValue;
@@ -15,6 +15,24 @@ Menu.prototype._init = function () {
   this.commandsMap = {};
   this.groupsMap = {};
   this.items = [];
+  this._pendingCommandStates = [];
+};
+
+// The native menu answers queries about the state of its items from a cache,
+// which is filled in bulk and updated whenever an item changes. Items without
+// a cached state are queried with the methods below.
+Menu.prototype._updateCommandStates = function (items) {
+  this._setCommandStates(items.map(item => item.getCommandState()));
+};
+
+Menu.prototype._flushCommandStates = function () {
+  if (this._pendingCommandStates.length > 0) {
+    this._updateCommandStates(this._pendingCommandStates);
+    this._pendingCommandStates = [];
+  }
+  for (const item of this.items) {
+    if (item.submenu) item.submenu._flushCommandStates();
+  }
 };
 
 Menu.prototype._isCommandIdChecked = function (id) {
@@ -59,10 +77,16 @@ Menu.prototype._executeCommand = function (event, id) {
 
 Menu.prototype._menuWillShow = function () {
   // Ensure radio groups have at least one menu item selected
+  const changed: MenuItem[] = [];
   for (const id of Object.keys(this.groupsMap)) {
     const found = this.groupsMap[id].find(item => item.checked) || null;
-    if (!found) checked.set(this.groupsMap[id][0], true);
+    if (!found) {
+      checked.set(this.groupsMap[id][0], true);
+      changed.push(this.groupsMap[id][0]);
+    }
   }
+  if (changed.length > 0) this._updateCommandStates(changed);
+  this._flushCommandStates();
 };
 
 Menu.prototype.popup = function (options = {}) {
@@ -91,6 +115,7 @@ Menu.prototype.popup = function (options = {}) {
     }
   }
 
+  this._flushCommandStates();
   this.popupAt(window as unknown as BaseWindow, x, y, positioningItem, callback);
   return { browserWindow: window, x, y, position: positioningItem };
 };
@@ -148,6 +173,7 @@ Menu.prototype.insert = function (pos, item) {
   // Remember the items.
   this.items.splice(pos, 0, item);
   this.commandsMap[item.commandId] = item;
+  this._pendingCommandStates.push(item);
 };
 
 Menu.prototype._callMenuWillShow = function () {
@@ -171,6 +197,7 @@ Menu.setApplicationMenu = function (menu: MenuType) {
 
   applicationMenu = menu;
   setApplicationMenuWasSet();
+  if (menu) menu._flushCommandStates();
 
   if (process.platform === 'darwin') {
     if (!menu) return;
@@ -202,6 +229,7 @@ Menu.buildFromTemplate = function (template) {
       menu.append(new MenuItem(item));
     }
   });
+  menu._flushCommandStates();
 
   return menu;
 };
@@ -280,11 +308,13 @@ function insertItemByType (this: MenuType, item: MenuItem, pos: number) {
       Object.defineProperty(item, 'checked', {
         enumerable: true,
         get: () => checked.get(item),
+        configurable: true,
         set: () => {
           this.groupsMap[item.groupId].forEach(other => {
             if (other !== item) checked.set(other, false);
           });
           checked.set(item, true);
+          this._updateCommandStates(this.groupsMap[item.groupId]);
         }
       });
       this.insertRadioItem(pos, item.commandId, item.label, item.groupId);
@@ -40,10 +40,12 @@ class IncomingMessage extends Readable {
   _data: (Buffer | null)[] = [];
   _responseHead: NodeJS.ResponseHead;
   _resume: (() => void) | null = null;
+  _urlLoader: NodeJS.URLLoader;
 
-  constructor (responseHead: NodeJS.ResponseHead) {
+  constructor (responseHead: NodeJS.ResponseHead, urlLoader: NodeJS.URLLoader) {
     super();
     this._responseHead = responseHead;
+    this._urlLoader = urlLoader;
   }
 
   get statusCode () {
@@ -113,6 +115,19 @@ class IncomingMessage extends Readable {
     throw new Error('HTTP trailers are not supported');
   }
 
+  pipeToFile (filePath: string) {
+    if (typeof filePath !== 'string') {
+      throw new TypeError('`filePath` should be a string in pipeToFile(filePath)');
+    }
+    if (this._data.length > 0 || this.readableFlowing !== null) {
+      throw new Error('pipeToFile() must be called before the response body is read');
+    }
+    this._urlLoader.pipeToFile(filePath);
+    // No data will be pushed, but keep the stream flowing so that 'end' is
+    // emitted once the whole body has been written.
+    this.resume();
+  }
+
   _storeInternalData (chunk: Buffer | null, resume: (() => void) | null) {
     // save the network callback for use in _pushInternalData
     this._resume = resume;
@@ -437,11 +452,11 @@ export class ClientRequest extends Writable implements Electron.ClientRequest {
     const opts = { ...this._urlLoaderOptions, extraHeaders: stringifyValues(this._urlLoaderOptions.headers) };
     this._urlLoader = createURLLoader(opts);
     this._urlLoader.on('response-started', (event, finalUrl, responseHead) => {
-      const response = this._response = new IncomingMessage(responseHead);
+      const response = this._response = new IncomingMessage(responseHead, this._urlLoader!);
       this.emit('response', response);
     });
     this._urlLoader.on('data', (event, data, resume) => {
-      this._response!._storeInternalData(Buffer.from(data), resume);
+      this._response!._storeInternalData(data, resume);
     });
     this._urlLoader.on('complete', () => {
       if (this._response) { this._response._storeInternalData(null, null); }
@@ -1,7 +1,9 @@
 import { EventEmitter } from 'events';
 import { Duplex, PassThrough } from 'stream';
 import { Socket } from 'net';
+import * as os from 'os';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
+import { SharedMemoryChannel } from '@electron/internal/browser/shared-memory-channel';
 const { _fork } = process._linkedBinding('electron_browser_utility_process');
 
 class ForkUtilityProcess extends EventEmitter {
@@ -88,6 +90,28 @@ class ForkUtilityProcess extends EventEmitter {
       }
     }
 
+    if (options.output != null) {
+      if (typeof options.output !== 'object') {
+        throw new Error('output must be an object.');
+      }
+      const { framing, flushInterval, maxBytesPerSecond, logFile } = options.output;
+      if (framing != null && !['line', 'length-prefixed', 'none'].includes(framing)) {
+        throw new Error('output.framing must be of the following values: line, length-prefixed, none');
+      }
+      if (flushInterval != null && !(typeof flushInterval === 'number' && flushInterval >= 0)) {
+        throw new Error('output.flushInterval must be a non-negative number.');
+      }
+      if (maxBytesPerSecond != null && !(typeof maxBytesPerSecond === 'number' && maxBytesPerSecond >= 0)) {
+        throw new Error('output.maxBytesPerSecond must be a non-negative number.');
+      }
+      if (logFile != null && typeof logFile !== 'string') {
+        throw new Error('output.logFile must be a string.');
+      }
+      // The piped streams are read natively and emitted as 'output' events.
+      this.#stdout = null;
+      this.#stderr = null;
+    }
+
     this.#handle = _fork({ options, modulePath, args });
     this.#handle!.emit = (channel: string | symbol, ...args: any[]) => {
       if (channel === 'exit') {
@@ -137,6 +161,13 @@ class ForkUtilityProcess extends EventEmitter {
     return this.#handle?.postMessage(message);
   }
 
+  createSharedMemoryChannel (options?: Electron.CreateSharedMemoryChannelOptions) {
+    if (this.#handle === null) {
+      throw new Error('The utility process has exited');
+    }
+    return new SharedMemoryChannel(this.#handle.createSharedMemoryChannel(options));
+  }
+
   kill () : boolean {
     if (this.#handle === null) {
       return false;
@@ -148,3 +179,244 @@ class ForkUtilityProcess extends EventEmitter {
 export function fork (modulePath: string, args?: string[], options?: Electron.ForkOptions) {
   return new ForkUtilityProcess(modulePath, args, options);
 }
+
+type PoolTask = {
+  resolve: (reply: any) => void;
+  reject: (error: Error) => void;
+};
+
+type PoolWorker = {
+  child: ForkUtilityProcess;
+  // Dispatched tasks waiting for a reply, oldest first.
+  tasks: PoolTask[];
+  completedTasks: number;
+  spawnTime: number;
+};
+
+type PendingPoolTask = PoolTask & {
+  message: any;
+  transfer?: MessagePortMain[];
+};
+
+// A process that exits this soon after it was spawned, without completing a
+// task, failed to start. The pool waits longer and longer before replacing
+// such processes, and gives up after too many of them in a row.
+const kPoolStartupTimeout = 1000;
+const kPoolMaxFailedStarts = 5;
+const kPoolInitialBackoff = 100;
+const kPoolMaxBackoff = 5000;
+
+class UtilityProcessPool extends EventEmitter {
+  #modulePath: string;
+  #args?: string[];
+  #forkOptions?: Electron.ForkOptions;
+  #size: number;
+  #spareCount: number;
+  #strategy: 'least-loaded' | 'round-robin';
+  #respawn: boolean;
+  #workers: PoolWorker[] = [];
+  #spares: PoolWorker[] = [];
+  // Tasks waiting for a worker while the workers are respawned.
+  #pendingTasks: PendingPoolTask[] = [];
+  #nextWorker = 0;
+  #failedStarts = 0;
+  #refillTimer: NodeJS.Timeout | null = null;
+  #closed = false;
+
+  constructor (modulePath: string, args?: string[], options?: Electron.UtilityProcessPoolOptions) {
+    super();
+
+    if (args != null && typeof args === 'object' && !Array.isArray(args)) {
+      options = args;
+      args = undefined;
+    }
+
+    const { size = Math.max(1, os.cpus().length - 1), spares = 1, strategy = 'least-loaded', respawn = true, ...forkOptions } = options || {};
+    if (!Number.isInteger(size) || size < 1) {
+      throw new Error('size must be a positive integer.');
+    }
+    if (!Number.isInteger(spares) || spares < 0) {
+      throw new Error('spares must be a non-negative integer.');
+    }
+    if (strategy !== 'least-loaded' && strategy !== 'round-robin') {
+      throw new Error('strategy must be one of least-loaded, round-robin.');
+    }
+
+    this.#modulePath = modulePath;
+    this.#args = args;
+    this.#forkOptions = forkOptions;
+    this.#size = size;
+    this.#spareCount = spares;
+    this.#strategy = strategy;
+    this.#respawn = respawn;
+
+    for (let i = 0; i < size; i++) {
+      this.#workers.push(this.#spawn());
+    }
+    this.#replenishSpares();
+  }
+
+  get size () {
+    return this.#size;
+  }
+
+  run (message: any, transfer?: MessagePortMain[]): Promise<any> {
+    if (this.#closed) {
+      return Promise.reject(new Error('The utility process pool is closed.'));
+    }
+    return new Promise((resolve, reject) => {
+      if (this.#workers.length === 0) {
+        this.#pendingTasks.push({ message, transfer, resolve, reject });
+        return;
+      }
+      this.#dispatch(this.#pickWorker(), { resolve, reject }, message, transfer);
+    });
+  }
+
+  getWorkerMetrics (): Electron.UtilityProcessPoolWorkerMetrics[] {
+    return this.#workers.map(({ child, tasks, completedTasks }) => ({
+      pid: child.pid,
+      queueDepth: tasks.length,
+      completedTasks
+    }));
+  }
+
+  close () {
+    if (this.#closed) return;
+    this.#closed = true;
+    if (this.#refillTimer) {
+      clearTimeout(this.#refillTimer);
+      this.#refillTimer = null;
+    }
+    const error = new Error('The utility process pool was closed.');
+    for (const worker of [...this.#workers, ...this.#spares]) {
+      this.#failTasks(worker, error);
+      worker.child.kill();
+    }
+    const pendingTasks = this.#pendingTasks;
+    this.#workers = [];
+    this.#spares = [];
+    this.#pendingTasks = [];
+    for (const task of pendingTasks) task.reject(error);
+  }
+
+  #dispatch (worker: PoolWorker, task: PoolTask, message: any, transfer?: MessagePortMain[]) {
+    worker.tasks.push(task);
+    worker.child.postMessage(message, transfer);
+  }
+
+  #spawn (): PoolWorker {
+    const child = new ForkUtilityProcess(this.#modulePath, this.#args, this.#forkOptions);
+    const worker: PoolWorker = { child, tasks: [], completedTasks: 0, spawnTime: Date.now() };
+    // Workers handle their messages in order and reply to each of them once,
+    // so a reply settles the oldest task.
+    child.on('message', (reply: any) => {
+      const task = worker.tasks.shift();
+      if (task) {
+        worker.completedTasks++;
+        task.resolve(reply);
+      } else {
+        this.emit('message', reply, child.pid);
+      }
+    });
+    child.once('exit', (code: number) => this.#onExit(worker, code));
+    return worker;
+  }
+
+  #replenishSpares () {
+    while (this.#spares.length < this.#spareCount) {
+      this.#spares.push(this.#spawn());
+    }
+  }
+
+  #pickWorker (): PoolWorker {
+    const count = this.#workers.length;
+    const start = this.#nextWorker++ % count;
+    let picked = this.#workers[start];
+    if (this.#strategy === 'least-loaded') {
+      // Start from the round-robin position to spread ties.
+      for (let i = 1; i < count; i++) {
+        const worker = this.#workers[(start + i) % count];
+        if (worker.tasks.length < picked.tasks.length) picked = worker;
+      }
+    }
+    return picked;
+  }
+
+  #failTasks (worker: PoolWorker, error: Error) {
+    const { tasks } = worker;
+    worker.tasks = [];
+    for (const task of tasks) task.reject(error);
+  }
+
+  #onExit (worker: PoolWorker, code: number) {
+    if (this.#closed) return;
+    if (worker.completedTasks === 0 && Date.now() - worker.spawnTime < kPoolStartupTimeout) {
+      this.#failedStarts++;
+    } else {
+      this.#failedStarts = 0;
+    }
+
+    const spareIndex = this.#spares.indexOf(worker);
+    if (spareIndex !== -1) {
+      this.#spares.splice(spareIndex, 1);
+    } else {
+      const index = this.#workers.indexOf(worker);
+      if (index === -1) return;
+      this.#failTasks(worker, new Error(`The utility process exited with code ${code}.`));
+      this.#workers.splice(index, 1);
+      if (this.#respawn && this.#spares.length > 0) {
+        // A warm spare takes over right away.
+        this.#workers.splice(index, 0, this.#spares.shift()!);
+      }
+    }
+    this.emit('worker-exit', code, worker.child.pid);
+
+    if (!this.#respawn) {
+      if (this.#workers.length === 0) this.close();
+      return;
+    }
+    if (this.#failedStarts >= kPoolMaxFailedStarts) {
+      const error = new Error(`The utility processes of the pool failed to start ${this.#failedStarts} times in a row.`);
+      this.close();
+      // Emitting 'error' without a listener would throw from the exit handler,
+      // and the pending tasks are already rejected.
+      if (this.listenerCount('error') > 0) this.emit('error', error);
+      return;
+    }
+    this.#scheduleRefill();
+  }
+
+  #scheduleRefill () {
+    if (this.#refillTimer) return;
+    if (this.#failedStarts === 0) {
+      this.#refill();
+      return;
+    }
+    const delay = Math.min(kPoolInitialBackoff * 2 ** (this.#failedStarts - 1), kPoolMaxBackoff);
+    this.#refillTimer = setTimeout(() => {
+      this.#refillTimer = null;
+      this.#refill();
+    }, delay);
+  }
+
+  #refill () {
+    if (this.#closed) return;
+    while (this.#workers.length < this.#size) {
+      this.#workers.push(this.#spawn());
+    }
+    this.#replenishSpares();
+    const pendingTasks = this.#pendingTasks;
+    this.#pendingTasks = [];
+    for (const { message, transfer, resolve, reject } of pendingTasks) {
+      this.#dispatch(this.#pickWorker(), { resolve, reject }, message, transfer);
+    }
+  }
+}
+
+export function createPool (modulePath: string, args?: string[], options?: Electron.UtilityProcessPoolOptions) {
+  if (!modulePath) {
+    throw new Error('Missing UtilityProcess entry script.');
+  }
+  return new UtilityProcessPool(modulePath, args, options);
+}
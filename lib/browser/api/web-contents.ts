@@ -3,6 +3,7 @@ import type { BrowserWindowConstructorOptions, LoadURLOptions } from 'electron/m
 
 import * as url from 'url';
 import * as path from 'path';
+import { Readable } from 'stream';
 import { openGuestWindow, makeWebPreferences, parseContentTypeFormat } from '@electron/internal/browser/guest-window-manager';
 import { parseFeatures } from '@electron/internal/browser/parse-features-string';
 import { ipcMainInternal } from '@electron/internal/browser/ipc-main-internal';
@@ -18,6 +19,7 @@ import * as deprecate from '@electron/internal/common/deprecate';
 session
 
 const webFrameMainBinding = process._linkedBinding('electron_browser_web_frame_main');
+const ipcMainBinding = process._linkedBinding('electron_browser_ipc_main');
 
 let nextId = 0;
 const getNextId = function () {
@@ -188,9 +190,7 @@ WebContents.prototype.executeJavaScriptInIsolatedWorld = async function (worldId
 };
 
 // Translate the options of printToPDF.
-
-let pendingPromise: Promise<any> | undefined;
-WebContents.prototype.printToPDF = async function (options) {
+function getPrintToPDFSettings (options: Electron.PrintToPDFOptions) {
   const printSettings: Record<string, any> = {
     requestID: getNextId(),
     landscape: false,
@@ -211,28 +211,28 @@ WebContents.prototype.printToPDF = async function (options) {
 
   if (options.landscape !== undefined) {
     if (typeof options.landscape !== 'boolean') {
-      return Promise.reject(new Error('landscape must be a Boolean'));
+      throw new Error('landscape must be a Boolean');
     }
     printSettings.landscape = options.landscape;
   }
 
   if (options.displayHeaderFooter !== undefined) {
     if (typeof options.displayHeaderFooter !== 'boolean') {
-      return Promise.reject(new Error('displayHeaderFooter must be a Boolean'));
+      throw new Error('displayHeaderFooter must be a Boolean');
     }
     printSettings.displayHeaderFooter = options.displayHeaderFooter;
   }
 
   if (options.printBackground !== undefined) {
     if (typeof options.printBackground !== 'boolean') {
-      return Promise.reject(new Error('printBackground must be a Boolean'));
+      throw new Error('printBackground must be a Boolean');
     }
     printSettings.shouldPrintBackgrounds = options.printBackground;
   }
 
   if (options.scale !== undefined) {
     if (typeof options.scale !== 'number') {
-      return Promise.reject(new Error('scale must be a Number'));
+      throw new Error('scale must be a Number');
     }
     printSettings.scale = options.scale;
   }
@@ -242,53 +242,53 @@ WebContents.prototype.printToPDF = async function (options) {
     if (typeof pageSize === 'string') {
       const format = paperFormats[pageSize.toLowerCase()];
       if (!format) {
-        return Promise.reject(new Error(`Invalid pageSize ${pageSize}`));
+        throw new Error(`Invalid pageSize ${pageSize}`);
       }
 
       printSettings.paperWidth = format.width;
       printSettings.paperHeight = format.height;
     } else if (typeof options.pageSize === 'object') {
       if (!pageSize.height || !pageSize.width) {
-        return Promise.reject(new Error('height and width properties are required for pageSize'));
+        throw new Error('height and width properties are required for pageSize');
       }
 
       printSettings.paperWidth = pageSize.width;
       printSettings.paperHeight = pageSize.height;
     } else {
-      return Promise.reject(new Error('pageSize must be a String or Object'));
+      throw new Error('pageSize must be a String or Object');
     }
   }
 
   const { margins } = options;
   if (margins !== undefined) {
     if (typeof margins !== 'object') {
-      return Promise.reject(new Error('margins must be an Object'));
+      throw new Error('margins must be an Object');
     }
 
     if (margins.top !== undefined) {
       if (typeof margins.top !== 'number') {
-        return Promise.reject(new Error('margins.top must be a Number'));
+        throw new Error('margins.top must be a Number');
       }
       printSettings.marginTop = margins.top;
     }
 
     if (margins.bottom !== undefined) {
       if (typeof margins.bottom !== 'number') {
-        return Promise.reject(new Error('margins.bottom must be a Number'));
+        throw new Error('margins.bottom must be a Number');
       }
       printSettings.marginBottom = margins.bottom;
     }
 
     if (margins.left !== undefined) {
       if (typeof margins.left !== 'number') {
-        return Promise.reject(new Error('margins.left must be a Number'));
+        throw new Error('margins.left must be a Number');
       }
       printSettings.marginLeft = margins.left;
     }
 
     if (margins.right !== undefined) {
       if (typeof margins.right !== 'number') {
-        return Promise.reject(new Error('margins.right must be a Number'));
+        throw new Error('margins.right must be a Number');
       }
       printSettings.marginRight = margins.right;
     }
@@ -296,43 +296,138 @@ WebContents.prototype.printToPDF = async function (options) {
 
   if (options.pageRanges !== undefined) {
     if (typeof options.pageRanges !== 'string') {
-      return Promise.reject(new Error('pageRanges must be a String'));
+      throw new Error('pageRanges must be a String');
     }
     printSettings.pageRanges = options.pageRanges;
   }
 
   if (options.headerTemplate !== undefined) {
     if (typeof options.headerTemplate !== 'string') {
-      return Promise.reject(new Error('headerTemplate must be a String'));
+      throw new Error('headerTemplate must be a String');
     }
     printSettings.headerTemplate = options.headerTemplate;
   }
 
   if (options.footerTemplate !== undefined) {
     if (typeof options.footerTemplate !== 'string') {
-      return Promise.reject(new Error('footerTemplate must be a String'));
+      throw new Error('footerTemplate must be a String');
     }
     printSettings.footerTemplate = options.footerTemplate;
   }
 
   if (options.preferCSSPageSize !== undefined) {
     if (typeof options.preferCSSPageSize !== 'boolean') {
-      return Promise.reject(new Error('footerTemplate must be a String'));
+      throw new Error('footerTemplate must be a String');
     }
     printSettings.preferCSSPageSize = options.preferCSSPageSize;
   }
 
-  if (this._printToPDF) {
-    if (pendingPromise) {
-      pendingPromise = pendingPromise.then(() => this._printToPDF(printSettings));
-    } else {
-      pendingPromise = this._printToPDF(printSettings);
+  return printSettings;
+}
+
+// Print jobs of the same WebContents run one after another, while different
+// WebContents print in parallel.
+const pendingPrintJobs = new WeakMap<Electron.WebContents, Promise<any>>();
+function queuePrintJob<T> (webContents: Electron.WebContents, job: () => Promise<T>): Promise<T> {
+  const pending = pendingPrintJobs.get(webContents);
+  const promise = pending ? pending.then(job, job) : job();
+  pendingPrintJobs.set(webContents, promise);
+  return promise;
+}
+
+WebContents.prototype.printToPDF = async function (options) {
+  const printSettings = getPrintToPDFSettings(options);
+  if (!this._printToPDF) {
+    throw new Error('Printing feature is disabled');
+  }
+  return queuePrintJob(this, () => this._printToPDF(printSettings));
+};
+
+WebContents.prototype.printToPDFFile = async function (filePath, options = {}) {
+  if (typeof filePath !== 'string') {
+    throw new Error('filePath must be a String');
+  }
+  const printSettings = getPrintToPDFSettings(options);
+  if (!this._printToPDFFile) {
+    throw new Error('Printing feature is disabled');
+  }
+  return queuePrintJob(this, () => this._printToPDFFile(printSettings, filePath));
+};
+
+const screenshotFormats = ['png', 'jpeg', 'webp'];
+
+// Scrolls the page and resolves with the resulting scroll position once the
+// scrolled content has been drawn.
+function scrollPageTo (webContents: Electron.WebContents, x: number, y: number): Promise<[number, number]> {
+  return webContents.executeJavaScript(`new Promise(resolve => {
+    window.scrollTo(${x}, ${y});
+    requestAnimationFrame(() => requestAnimationFrame(() => resolve([window.scrollX, window.scrollY])));
+  })`);
+}
+
+WebContents.prototype.captureScreenshot = async function (options = {}) {
+  const { format = 'png', quality = 90, fullPage = false, rect, path: filePath } = options;
+  if (!screenshotFormats.includes(format)) {
+    throw new Error(`Invalid format ${format}`);
+  }
+  if (typeof quality !== 'number' || quality < 0 || quality > 100) {
+    throw new Error('quality must be a Number between 0 and 100');
+  }
+  if (filePath !== undefined && typeof filePath !== 'string') {
+    throw new Error('path must be a String');
+  }
+  if (fullPage && rect) {
+    throw new Error('rect can not be used together with fullPage');
+  }
+
+  if (!fullPage) {
+    const area = rect || { x: 0, y: 0, width: 0, height: 0 };
+    const capture = this._createPageCapture({ width: area.width, height: area.height });
+    await capture.captureTile(area, { x: 0, y: 0 });
+    return capture.encode(format, quality, filePath);
+  }
+
+  // Scroll through the page one viewport at a time and stitch the tiles
+  // together. Page metrics are in CSS pixels, captures in DIPs.
+  const zoomFactor = this.getZoomFactor();
+  const metrics = await this.executeJavaScript(`({
+    width: document.documentElement.scrollWidth,
+    height: document.documentElement.scrollHeight,
+    viewportWidth: document.documentElement.clientWidth,
+    viewportHeight: document.documentElement.clientHeight,
+    scrollX: window.scrollX,
+    scrollY: window.scrollY
+  })`);
+  const capture = this._createPageCapture({
+    width: Math.ceil(metrics.width * zoomFactor),
+    height: Math.ceil(metrics.height * zoomFactor)
+  });
+  const viewport = {
+    x: 0,
+    y: 0,
+    width: Math.floor(metrics.viewportWidth * zoomFactor),
+    height: Math.floor(metrics.viewportHeight * zoomFactor)
+  };
+  // The page could not be scrolled through an empty viewport.
+  if (viewport.width <= 0 || viewport.height <= 0) {
+    throw new Error('The page can not be captured with an empty viewport');
+  }
+  try {
+    for (let y = 0; y < metrics.height; y += metrics.viewportHeight) {
+      for (let x = 0; x < metrics.width; x += metrics.viewportWidth) {
+        // The last tiles overlap the previous ones when the page can not be
+        // scrolled further.
+        const [scrollX, scrollY] = await scrollPageTo(this, x, y);
+        await capture.captureTile(viewport, {
+          x: Math.round(scrollX * zoomFactor),
+          y: Math.round(scrollY * zoomFactor)
+        });
+      }
     }
-    return pendingPromise;
-  } else {
-    const error = new Error('Printing feature is disabled');
-    return Promise.reject(error);
+  } finally {
+    await scrollPageTo(this, metrics.scrollX, metrics.scrollY);
   }
+  return capture.encode(format, quality, filePath);
 };
 
 WebContents.prototype.print = function (options: ElectronInternal.WebContentsPrintOptions = {}, callback) {
@@ -401,6 +496,36 @@ WebContents.prototype.getPrintersAsync = async function () {
   }
 };
 
+WebContents.prototype.createHeapSnapshotStream = function (options = {}) {
+  const { compress = true } = options;
+  // The snapshot is only read from the renderer as fast as it is consumed.
+  let resume: (() => void) | undefined;
+  const stream = new Readable({
+    read () { resume?.(); },
+    // The rest of the snapshot is discarded, so the renderer does not wait.
+    destroy (error, callback) {
+      resume?.();
+      callback(error);
+    }
+  });
+  try {
+    resume = this._streamHeapSnapshot(
+      compress,
+      (chunk: Buffer) => stream.destroyed || stream.push(chunk),
+      (progress: Electron.HeapSnapshotProgress) => { stream.emit('progress', progress); },
+      (error: string) => {
+        if (error) {
+          stream.destroy(new Error(error));
+        } else {
+          stream.push(null);
+        }
+      });
+  } catch (error) {
+    process.nextTick(() => { stream.destroy(error as Error); });
+  }
+  return stream;
+};
+
 WebContents.prototype.loadFile = function (filePath, options = {}) {
   if (typeof filePath !== 'string') {
     throw new Error('Must pass filePath as a string');
@@ -556,6 +681,22 @@ const addSenderFrameToEvent = (event: Electron.IpcMainEvent | Electron.IpcMainIn
   });
 };
 
+const addInvokeReplyToEvent = (event: Electron.IpcMainInvokeEvent, channel: string) => {
+  event._reply = (result: any) => event.sendReply({ result });
+  event._throw = (error: Error) => {
+    console.error(`Error occurred in handler for '${channel}':`, error);
+    event.sendReply({ error: error.toString() });
+  };
+};
+
+// Invoke requests for channels which are only handled by ipcMain are
+// dispatched here directly from native code, see IpcMainInvokeRegistry.
+ipcMainBinding.setInvokeDispatcher((event: Electron.IpcMainInvokeEvent, channel: string, handler: Function, args: any[]) => {
+  addSenderFrameToEvent(event);
+  addInvokeReplyToEvent(event, channel);
+  handler(event, ...args);
+});
+
 const addReturnValueToEvent = (event: Electron.IpcMainEvent) => {
   Object.defineProperty(event, 'returnValue', {
     set: (value) => event.sendReply(value),
@@ -591,11 +732,13 @@ WebContents.prototype._init = function () {
 
   this._windowOpenHandler = null;
 
-  const ipc = new IpcMainImpl();
+  const ipc = new IpcMainImpl('scoped');
   Object.defineProperty(this, 'ipc', {
     get () { return ipc; },
     enumerable: true
   });
+  // Release the channels of this WebContents in the native invoke registry.
+  this.once('destroyed', () => ipc._removeAllHandlers());
 
   // Dispatch IPC messages to the ipc module.
   this.on('-ipc-message' as any, function (this: Electron.WebContents, event: Electron.IpcMainEvent, internal: boolean, channel: string, args: any[]) {
@@ -614,11 +757,7 @@ WebContents.prototype._init = function () {
 
   this.on('-ipc-invoke' as any, function (event: Electron.IpcMainInvokeEvent, internal: boolean, channel: string, args: any[]) {
     addSenderFrameToEvent(event);
-    event._reply = (result: any) => event.sendReply({ result });
-    event._throw = (error: Error) => {
-      console.error(`Error occurred in handler for '${channel}':`, error);
-      event.sendReply({ error: error.toString() });
-    };
+    addInvokeReplyToEvent(event, channel);
     const maybeWebFrame = getWebFrameForEvent(event);
     const targets: (ElectronInternal.IpcMainInternal| undefined)[] = internal ? [ipcMainInternal] : [maybeWebFrame?.ipc, ipc, ipcMain];
     const target = targets.find(target => target && (target as any)._invokeHandlers.has(channel));
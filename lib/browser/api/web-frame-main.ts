@@ -5,8 +5,10 @@ const { WebFrameMain, fromId } = process._linkedBinding('electron_browser_web_fr
 
 Object.defineProperty(WebFrameMain.prototype, 'ipc', {
   get () {
-    const ipc = new IpcMainImpl();
+    const ipc = new IpcMainImpl('scoped');
     Object.defineProperty(this, 'ipc', { value: ipc });
+    // Release the channels of this frame in the native invoke registry.
+    this.once('-destroyed' as any, () => ipc._removeAllHandlers());
     return ipc;
   }
 });
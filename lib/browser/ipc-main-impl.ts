@@ -1,11 +1,23 @@
 import { EventEmitter } from 'events';
 import { IpcMainInvokeEvent } from 'electron/main';
 
+const ipcMainBinding = process._linkedBinding('electron_browser_ipc_main');
+
+// How the handlers of an IpcMainImpl are mirrored in the native invoke
+// registry, which dispatches invoke requests without going through the
+// '-ipc-invoke' event when only ipcMain handles a channel.
+//  * 'global' - the handlers of ipcMain, called directly from native code.
+//  * 'scoped' - the handlers of webContents.ipc and webFrameMain.ipc, which
+//               take precedence over ipcMain and so disable the direct path.
+type NativeRegistration = 'global' | 'scoped';
+
 export class IpcMainImpl extends EventEmitter {
   private _invokeHandlers: Map<string, (e: IpcMainInvokeEvent, ...args: any[]) => void> = new Map();
+  private _nativeRegistration?: NativeRegistration;
 
-  constructor () {
+  constructor (nativeRegistration?: NativeRegistration) {
     super();
+    this._nativeRegistration = nativeRegistration;
 
     // Do not throw exception when channel name is "error".
     this.on('error', () => {});
@@ -18,13 +30,19 @@ export class IpcMainImpl extends EventEmitter {
     if (typeof fn !== 'function') {
       throw new Error(`Expected handler to be a function, but found type '${typeof fn}'`);
     }
-    this._invokeHandlers.set(method, async (e, ...args) => {
+    const handler = async (e: IpcMainInvokeEvent, ...args: any[]) => {
       try {
         e._reply(await Promise.resolve(fn(e, ...args)));
       } catch (err) {
         e._throw(err as Error);
       }
-    });
+    };
+    this._invokeHandlers.set(method, handler);
+    if (this._nativeRegistration === 'global') {
+      ipcMainBinding.addInvokeHandler(method, handler);
+    } else if (this._nativeRegistration === 'scoped') {
+      ipcMainBinding.addScopedInvokeHandler(method);
+    }
   }
 
   handleOnce: Electron.IpcMain['handleOnce'] = (method, fn) => {
@@ -35,6 +53,17 @@ export class IpcMainImpl extends EventEmitter {
   }
 
   removeHandler (method: string) {
-    this._invokeHandlers.delete(method);
+    if (!this._invokeHandlers.delete(method)) return;
+    if (this._nativeRegistration === 'global') {
+      ipcMainBinding.removeInvokeHandler(method);
+    } else if (this._nativeRegistration === 'scoped') {
+      ipcMainBinding.removeScopedInvokeHandler(method);
+    }
+  }
+
+  _removeAllHandlers () {
+    for (const method of [...this._invokeHandlers.keys()]) {
+      this.removeHandler(method);
+    }
   }
 }
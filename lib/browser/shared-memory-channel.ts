@@ -0,0 +1,99 @@
+import { Duplex } from 'stream';
+
+type PendingWrite = {
+  chunk: Buffer;
+  callback: (error?: Error | null) => void;
+};
+
+// Exposes an end of a native shared memory channel as a byte stream.
+export class SharedMemoryChannel extends Duplex {
+  #channel: ElectronInternal.SharedMemoryChannel | null;
+  #reading = false;
+  #peerEnded = false;
+  #pendingWrite: PendingWrite | null = null;
+
+  constructor (channel: ElectronInternal.SharedMemoryChannel) {
+    super({ allowHalfOpen: false });
+    this.#channel = channel;
+    channel.emit = (event: string | symbol) => {
+      switch (event) {
+        case 'readable':
+          this.#drain();
+          break;
+        case 'writable':
+          this.#flushWrite();
+          break;
+        case 'end':
+          // The peer closed the channel, what it wrote before can still be
+          // read, so the stream only ends once the ring is drained.
+          this.#peerEnded = true;
+          this.#drain();
+          this.#flushWrite();
+          break;
+        case 'close':
+          this.#channel = null;
+          break;
+      }
+      return true;
+    };
+  }
+
+  get capacity () {
+    return this.#channel?.capacity;
+  }
+
+  _read () {
+    this.#reading = true;
+    this.#drain();
+  }
+
+  _write (chunk: Buffer, encoding: BufferEncoding, callback: (error?: Error | null) => void) {
+    this.#pendingWrite = { chunk, callback };
+    this.#flushWrite();
+  }
+
+  _final (callback: (error?: Error | null) => void) {
+    // The rings cannot be half-closed, so ending the stream closes the
+    // channel.
+    callback();
+    this.destroy();
+  }
+
+  _destroy (error: Error | null, callback: (error: Error | null) => void) {
+    if (this.#channel) this.#channel.close();
+    this.#channel = null;
+    callback(error);
+  }
+
+  #drain () {
+    while (this.#reading && this.#channel) {
+      const chunk = this.#channel.read();
+      if (chunk === null) {
+        // The channel emits 'readable' once more data is written, unless the
+        // peer is gone.
+        if (this.#peerEnded) this.push(null);
+        return;
+      }
+      this.#reading = this.push(chunk);
+    }
+  }
+
+  #flushWrite () {
+    const pending = this.#pendingWrite;
+    if (!pending) return;
+    try {
+      if (!this.#channel) throw new Error('The channel is closed');
+      const written = this.#channel.write(pending.chunk);
+      if (written < pending.chunk.length) {
+        // The channel emits 'writable' once the peer has read some data.
+        pending.chunk = pending.chunk.subarray(written);
+        return;
+      }
+      this.#pendingWrite = null;
+      pending.callback();
+    } catch (error) {
+      this.#pendingWrite = null;
+      pending.callback(error as Error);
+    }
+  }
+}
@@ -1,19 +1,39 @@
 import { EventEmitter } from 'events';
 import { MessagePortMain } from '@electron/internal/browser/message-port-main';
+import { SharedMemoryChannel } from '@electron/internal/browser/shared-memory-channel';
 const { createParentPort } = process._linkedBinding('electron_utility_parent_port');
 
 export class ParentPort extends EventEmitter {
   #port: ParentPort
+  // Channels opened before a 'channel' listener was added.
+  #pendingChannels: SharedMemoryChannel[] = [];
   constructor () {
     super();
     this.#port = createParentPort();
-    this.#port.emit = (channel: string | symbol, event: { ports: any[] }) => {
+    this.#port.emit = (channel: string | symbol, event: any) => {
       if (channel === 'message') {
-        event = { ...event, ports: event.ports.map(p => new MessagePortMain(p)) };
+        event = { ...event, ports: event.ports.map((p: any) => new MessagePortMain(p)) };
+      } else if (channel === 'channel') {
+        const stream = new SharedMemoryChannel(event);
+        if (this.listenerCount('channel') === 0) {
+          this.#pendingChannels.push(stream);
+          return false;
+        }
+        event = stream;
       }
       this.emit(channel, event);
       return false;
     };
+    this.on('newListener', (name: string) => {
+      if (name === 'channel' && this.#pendingChannels.length > 0) {
+        // Emit once the listener has been added.
+        process.nextTick(() => {
+          const channels = this.#pendingChannels;
+          this.#pendingChannels = [];
+          for (const stream of channels) this.emit('channel', stream);
+        });
+      }
+    });
   }
 
   start () : void {
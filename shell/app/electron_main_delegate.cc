@@ -41,6 +41,7 @@
 #include "shell/common/options_switches.h"
 #include "shell/common/platform_util.h"
 #include "shell/common/process_util.h"
+#include "shell/common/startup_marks.h"
 #include "shell/renderer/electron_renderer_client.h"
 #include "shell/renderer/electron_sandboxed_renderer_client.h"
 #include "shell/utility/electron_content_utility_client.h"
@@ -238,6 +239,7 @@ const size_t ElectronMainDelegate::kNonWildcardDomainNonPortSchemesSize =
     std::size(kNonWildcardDomainNonPortSchemes);
 
 absl::optional<int> ElectronMainDelegate::BasicStartupComplete() {
+  AddStartupMarkOnce("ElectronMainDelegate::BasicStartupComplete");
   auto* command_line = base::CommandLine::ForCurrentProcess();
 
 #if BUILDFLAG(IS_WIN)
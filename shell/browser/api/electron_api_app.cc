@@ -4,6 +4,7 @@
 
 #include "shell/browser/api/electron_api_app.h"
 
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -17,6 +18,8 @@
 #include "base/files/file_util.h"
 #include "base/path_service.h"
 #include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/thread_restrictions.h"
 #include "base/values.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/browser/icon_manager.h"
@@ -54,6 +57,7 @@
 #include "shell/browser/javascript_environment.h"
 #include "shell/browser/login_handler.h"
 #include "shell/browser/relauncher.h"
+#include "shell/browser/startup_timeline.h"
 #include "shell/common/application_info.h"
 #include "shell/common/electron_command_line.h"
 #include "shell/common/electron_paths.h"
@@ -462,6 +466,10 @@ gin::WrapperInfo App::kWrapperInfo = {gin::kEmbedderNativeGin};
 
 namespace {
 
+// The most samples kept for each process by app.startResourceSampling(), an
+// hour at the default interval.
+constexpr int kMaxResourceSamples = 3600;
+
 IconLoader::IconSize GetIconSizeByString(const std::string& size) {
   if (size == "small") {
     return IconLoader::IconSize::SMALL;
@@ -641,6 +649,106 @@ void OnIconDataAvailable(gin_helper::Promise<gfx::Image> promise,
   }
 }
 
+std::unique_ptr<ProcessMetric> CreateProcessMetric(
+    int process_type,
+    base::ProcessHandle handle,
+    const std::string& service_name = std::string(),
+    const std::string& name = std::string()) {
+#if BUILDFLAG(IS_MAC)
+  auto metrics = base::ProcessMetrics::CreateProcessMetrics(
+      handle, content::BrowserChildProcessHost::GetPortProvider());
+#else
+  auto metrics = base::ProcessMetrics::CreateProcessMetrics(handle);
+#endif
+  return std::make_unique<ProcessMetric>(
+      process_type, handle, std::move(metrics), service_name, name);
+}
+
+gin_helper::Dictionary MemoryInfoToDict(v8::Isolate* isolate,
+                                        const ProcessMemoryInfo& memory_info) {
+  gin_helper::Dictionary memory_dict = gin::Dictionary::CreateEmpty(isolate);
+  memory_dict.SetHidden("simple", true);
+  memory_dict.Set("workingSetSize",
+                  static_cast<double>(memory_info.working_set_size >> 10));
+  memory_dict.Set("peakWorkingSetSize",
+                  static_cast<double>(memory_info.peak_working_set_size >> 10));
+
+#if BUILDFLAG(IS_WIN)
+  memory_dict.Set("privateBytes",
+                  static_cast<double>(memory_info.private_bytes >> 10));
+#elif BUILDFLAG(IS_LINUX)
+  memory_dict.Set("swap", static_cast<double>(memory_info.swap >> 10));
+  if (memory_info.proportional_set_size) {
+    memory_dict.Set(
+        "proportionalSetSize",
+        static_cast<double>(*memory_info.proportional_set_size >> 10));
+    memory_dict.Set("uniqueSetSize",
+                    static_cast<double>(*memory_info.unique_set_size >> 10));
+    memory_dict.Set("privateDirty",
+                    static_cast<double>(*memory_info.private_dirty >> 10));
+    memory_dict.Set("sharedDirty",
+                    static_cast<double>(*memory_info.shared_dirty >> 10));
+  }
+#endif
+
+  return memory_dict;
+}
+
+gin_helper::Dictionary ProcessMetricToDict(
+    v8::Isolate* isolate,
+    const ProcessMetric& process_metric,
+    const ProcessMemoryInfo* memory_info,
+    int processor_count) {
+  gin_helper::Dictionary pid_dict = gin::Dictionary::CreateEmpty(isolate);
+  gin_helper::Dictionary cpu_dict = gin::Dictionary::CreateEmpty(isolate);
+
+  pid_dict.SetHidden("simple", true);
+  cpu_dict.SetHidden("simple", true);
+  cpu_dict.Set("percentCPUUsage",
+               process_metric.metrics->GetPlatformIndependentCPUUsage() /
+                   processor_count);
+
+#if !BUILDFLAG(IS_WIN)
+  cpu_dict.Set("idleWakeupsPerSecond",
+               process_metric.metrics->GetIdleWakeupsPerSecond());
+#else
+  // Chrome's underlying process_metrics.cc will throw a non-fatal warning
+  // that this method isn't implemented on Windows, so set it to 0 instead
+  // of calling it
+  cpu_dict.Set("idleWakeupsPerSecond", 0);
+#endif
+
+  pid_dict.Set("cpu", cpu_dict);
+  pid_dict.Set("pid", process_metric.process.Pid());
+  pid_dict.Set("type",
+               content::GetProcessTypeNameInEnglish(process_metric.type));
+  pid_dict.Set("creationTime",
+               process_metric.process.CreationTime().ToJsTime());
+
+  if (!process_metric.service_name.empty()) {
+    pid_dict.Set("serviceName", process_metric.service_name);
+  }
+
+  if (!process_metric.name.empty()) {
+    pid_dict.Set("name", process_metric.name);
+  }
+
+  // Missing when it was not read yet, see App::GetAppMetrics().
+  if (memory_info)
+    pid_dict.Set("memory", MemoryInfoToDict(isolate, *memory_info));
+
+#if BUILDFLAG(IS_MAC)
+  pid_dict.Set("sandboxed", process_metric.IsSandboxed());
+#elif BUILDFLAG(IS_WIN)
+  auto integrity_level = process_metric.GetIntegrityLevel();
+  auto sandboxed = ProcessMetric::IsSandboxed(integrity_level);
+  pid_dict.Set("integrityLevel", integrity_level);
+  pid_dict.Set("sandboxed", sandboxed);
+#endif
+
+  return pid_dict;
+}
+
 }  // namespace
 
 App::App() {
@@ -947,18 +1055,18 @@ void App::ChildProcessLaunched(int process_type,
                                base::ProcessHandle handle,
                                const std::string& service_name,
                                const std::string& name) {
-#if BUILDFLAG(IS_MAC)
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(
-      handle, content::BrowserChildProcessHost::GetPortProvider());
-#else
-  auto metrics = base::ProcessMetrics::CreateProcessMetrics(handle);
-#endif
-  app_metrics_[pid] = std::make_unique<electron::ProcessMetric>(
-      process_type, handle, std::move(metrics), service_name, name);
+  app_metrics_[pid] =
+      CreateProcessMetric(process_type, handle, service_name, name);
+  if (resource_sampler_) {
+    resource_sampler_->AddProcess(
+        pid, CreateProcessMetric(process_type, handle, service_name, name));
+  }
 }
 
 void App::ChildProcessDisconnected(int pid) {
   app_metrics_.erase(pid);
+  if (resource_sampler_)
+    resource_sampler_->RemoveProcess(pid);
 }
 
 base::FilePath App::GetAppPath() const {
@@ -1391,80 +1499,280 @@ std::vector<gin_helper::Dictionary> App::GetAppMetrics(v8::Isolate* isolate) {
   result.reserve(app_metrics_.size());
   int processor_count = base::SysInfo::NumberOfProcessors();
 
+#if BUILDFLAG(IS_LINUX)
+  // Reading the memory info from procfs can take long for large processes,
+  // so it is read in the background and the last values read are reported.
+  RefreshMemoryInfo();
+  for (const auto& process_metric : app_metrics_) {
+    auto it = memory_info_.find(process_metric.second->process.Pid());
+    result.push_back(ProcessMetricToDict(
+        isolate, *process_metric.second,
+        it == memory_info_.end() ? nullptr : &it->second, processor_count));
+  }
+#else
   for (const auto& process_metric : app_metrics_) {
-    gin_helper::Dictionary pid_dict = gin::Dictionary::CreateEmpty(isolate);
-    gin_helper::Dictionary cpu_dict = gin::Dictionary::CreateEmpty(isolate);
+    ProcessMemoryInfo memory_info = process_metric.second->GetMemoryInfo();
+    result.push_back(ProcessMetricToDict(isolate, *process_metric.second,
+                                         &memory_info, processor_count));
+  }
+#endif
 
-    pid_dict.SetHidden("simple", true);
-    cpu_dict.SetHidden("simple", true);
-    cpu_dict.Set(
-        "percentCPUUsage",
-        process_metric.second->metrics->GetPlatformIndependentCPUUsage() /
-            processor_count);
+  return result;
+}
 
-#if !BUILDFLAG(IS_WIN)
-    cpu_dict.Set("idleWakeupsPerSecond",
-                 process_metric.second->metrics->GetIdleWakeupsPerSecond());
+void App::StartAppMetricsSampling(gin::Arguments* args) {
+  int interval = 0;
+  if (!args->GetNext(&interval) || interval <= 0) {
+    args->ThrowTypeError("interval must be a positive number");
+    return;
+  }
+  metrics_sampling_timer_.Start(
+      FROM_HERE, base::Milliseconds(interval),
+      base::BindRepeating(&App::SampleAppMetrics, base::Unretained(this)));
+}
+
+void App::StopAppMetricsSampling() {
+  metrics_sampling_timer_.Stop();
+}
+
+void App::SampleAppMetrics() {
+  // A sample that takes longer than the interval skips the next ticks
+  // instead of piling up.
+  if (metrics_sample_pending_)
+    return;
+  metrics_sample_pending_ = true;
+
+#if BUILDFLAG(IS_LINUX)
+  ReadMemoryInfoInBackground(
+      base::BindOnce(&App::OnAppMetricsSampled, weak_factory_.GetWeakPtr()));
 #else
-    // Chrome's underlying process_metrics.cc will throw a non-fatal warning
-    // that this method isn't implemented on Windows, so set it to 0 instead
-    // of calling it
-    cpu_dict.Set("idleWakeupsPerSecond", 0);
+  // The memory info is cheap to get on the other platforms.
+  ProcessMemoryInfoMap memory_info;
+  for (const auto& process_metric : app_metrics_) {
+    memory_info[process_metric.second->process.Pid()] =
+        process_metric.second->GetMemoryInfo();
+  }
+  OnAppMetricsSampled(std::move(memory_info));
 #endif
+}
 
-    pid_dict.Set("cpu", cpu_dict);
-    pid_dict.Set("pid", process_metric.second->process.Pid());
-    pid_dict.Set("type", content::GetProcessTypeNameInEnglish(
-                             process_metric.second->type));
-    pid_dict.Set("creationTime",
-                 process_metric.second->process.CreationTime().ToJsTime());
+#if BUILDFLAG(IS_LINUX)
+void App::ReadMemoryInfoInBackground(
+    base::OnceCallback<void(ProcessMemoryInfoMap)> callback) {
+  if (!memory_task_runner_) {
+    memory_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  }
+  std::vector<base::ProcessId> pids;
+  pids.reserve(app_metrics_.size());
+  for (const auto& process_metric : app_metrics_)
+    pids.push_back(process_metric.second->process.Pid());
+  memory_task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(
+          [](const std::vector<base::ProcessId>& pids) {
+            ProcessMemoryInfoMap result;
+            for (base::ProcessId pid : pids)
+              result[pid] = ProcessMetric::ReadMemoryInfo(pid);
+            return result;
+          },
+          std::move(pids)),
+      std::move(callback));
+}
+
+void App::RefreshMemoryInfo() {
+  if (memory_info_refresh_pending_)
+    return;
+  memory_info_refresh_pending_ = true;
+  ReadMemoryInfoInBackground(
+      base::BindOnce(&App::OnMemoryInfoRefreshed, weak_factory_.GetWeakPtr()));
+}
 
-    if (!process_metric.second->service_name.empty()) {
-      pid_dict.Set("serviceName", process_metric.second->service_name);
-    }
+void App::OnMemoryInfoRefreshed(ProcessMemoryInfoMap memory_info) {
+  memory_info_refresh_pending_ = false;
+  memory_info_ = std::move(memory_info);
+}
+#endif
 
-    if (!process_metric.second->name.empty()) {
-      pid_dict.Set("name", process_metric.second->name);
-    }
+void App::StartResourceSampling(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  args->GetNext(&options);
+  int interval = 1000;
+  int capacity = 60;
+  options.Get("interval", &interval);
+  options.Get("capacity", &capacity);
+  if (interval <= 0 || capacity <= 0) {
+    args->ThrowTypeError("interval and capacity must be positive numbers");
+    return;
+  }
+  // The samples of every process are kept in memory.
+  if (capacity > kMaxResourceSamples) {
+    args->ThrowTypeError("capacity must not be greater than 3600");
+    return;
+  }
+  resource_sampler_ = std::make_unique<ResourceSampler>(
+      base::Milliseconds(interval), capacity,
+      base::BindRepeating(&App::OnResourceUsage, base::Unretained(this)));
+  for (const auto& process_metric : app_metrics_) {
+    const ProcessMetric& metric = *process_metric.second;
+    resource_sampler_->AddProcess(
+        process_metric.first,
+        CreateProcessMetric(metric.type, metric.process.Handle(),
+                            metric.service_name, metric.name));
+  }
+}
 
-#if !BUILDFLAG(IS_LINUX)
-    auto memory_info = process_metric.second->GetMemoryInfo();
+void App::StopResourceSampling() {
+  resource_sampler_.reset();
+}
 
-    gin_helper::Dictionary memory_dict = gin::Dictionary::CreateEmpty(isolate);
-    memory_dict.SetHidden("simple", true);
-    memory_dict.Set("workingSetSize",
-                    static_cast<double>(memory_info.working_set_size >> 10));
-    memory_dict.Set(
-        "peakWorkingSetSize",
-        static_cast<double>(memory_info.peak_working_set_size >> 10));
+v8::Local<v8::Value> App::GetResourceSamples(v8::Isolate* isolate,
+                                             base::ProcessId pid) {
+  int type = 0;
+  std::vector<double> samples;
+  if (!resource_sampler_ ||
+      !resource_sampler_->GetSamples(pid, &type, &samples))
+    return v8::Null(isolate);
 
-#if BUILDFLAG(IS_WIN)
-    memory_dict.Set("privateBytes",
-                    static_cast<double>(memory_info.private_bytes >> 10));
-#endif
+  std::vector<std::string> fields;
+  for (int i = 0; i < ResourceSampler::kFieldCount; ++i) {
+    fields.emplace_back(ResourceSampler::GetFieldName(
+        static_cast<ResourceSampler::Field>(i)));
+  }
+  auto buffer = v8::ArrayBuffer::New(isolate, samples.size() * sizeof(double));
+  if (!samples.empty()) {
+    memcpy(buffer->GetBackingStore()->Data(), samples.data(),
+           samples.size() * sizeof(double));
+  }
 
-    pid_dict.Set("memory", memory_dict);
-#endif
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.SetHidden("simple", true);
+  dict.Set("pid", pid);
+  dict.Set("type", content::GetProcessTypeNameInEnglish(type));
+  dict.Set("fields", fields);
+  dict.Set("samples",
+           v8::Float64Array::New(buffer, 0, samples.size()).As<v8::Value>());
+  return dict.GetHandle();
+}
 
-#if BUILDFLAG(IS_MAC)
-    pid_dict.Set("sandboxed", process_metric.second->IsSandboxed());
-#elif BUILDFLAG(IS_WIN)
-    auto integrity_level = process_metric.second->GetIntegrityLevel();
-    auto sandboxed = ProcessMetric::IsSandboxed(integrity_level);
-    pid_dict.Set("integrityLevel", integrity_level);
-    pid_dict.Set("sandboxed", sandboxed);
-#endif
+void App::OnResourceUsage(const ResourceSampler::Summary& summary) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.SetHidden("simple", true);
+  dict.Set("timestamp", summary.timestamp);
+  dict.Set("processCount", static_cast<int>(summary.process_count));
+  dict.Set("percentCPUUsage", summary.percent_cpu_usage);
+  dict.Set("workingSetSize", summary.working_set_size);
+  dict.Set("readTransferCount", summary.read_transfer_count);
+  dict.Set("writeTransferCount", summary.write_transfer_count);
+  Emit("resource-usage", dict);
+}
 
-    result.push_back(pid_dict);
+void App::StartMainThreadWatchdog(gin::Arguments* args) {
+  gin_helper::Dictionary options;
+  args->GetNext(&options);
+  int threshold = 100;
+  bool sample_stacks = true;
+  options.Get("threshold", &threshold);
+  options.Get("sampleStacks", &sample_stacks);
+  if (threshold <= 0) {
+    args->ThrowTypeError("threshold must be a positive number");
+    return;
   }
+  main_thread_watchdog_.reset();
+  main_thread_watchdog_ = std::make_unique<MainThreadWatchdog>(
+      args->isolate(), base::Milliseconds(threshold), sample_stacks,
+      base::BindRepeating(&App::OnMainThreadBlocked, base::Unretained(this)));
+}
 
-  return result;
+void App::StopMainThreadWatchdog() {
+  main_thread_watchdog_.reset();
+}
+
+void App::OnMainThreadBlocked(
+    const MainThreadWatchdog::BlockedTask& blocked_task) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  gin_helper::Dictionary details = gin::Dictionary::CreateEmpty(isolate);
+  details.SetHidden("simple", true);
+  details.Set("startTime", blocked_task.start_time.ToJsTime());
+  details.Set("duration", blocked_task.duration.InMillisecondsF());
+  details.Set("location", blocked_task.location);
+  if (!blocked_task.js_stack.empty())
+    details.Set("jsStack", blocked_task.js_stack);
+  if (!blocked_task.native_stack.empty())
+    details.Set("nativeStack", blocked_task.native_stack);
+  Emit("main-thread-blocked", details);
+}
+
+void App::OnAppMetricsSampled(ProcessMemoryInfoMap memory_info) {
+  metrics_sample_pending_ = false;
+#if BUILDFLAG(IS_LINUX)
+  memory_info_ = memory_info;
+#endif
+  if (!metrics_sampling_timer_.IsRunning())
+    return;
+
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  int processor_count = base::SysInfo::NumberOfProcessors();
+  std::vector<gin_helper::Dictionary> metrics;
+  metrics.reserve(app_metrics_.size());
+  for (const auto& process_metric : app_metrics_) {
+    // Processes launched while sampling are part of the next sample.
+    auto it = memory_info.find(process_metric.second->process.Pid());
+    if (it == memory_info.end())
+      continue;
+    metrics.push_back(ProcessMetricToDict(isolate, *process_metric.second,
+                                          &it->second, processor_count));
+  }
+  Emit("app-metrics", metrics);
 }
 
 v8::Local<v8::Value> App::GetGPUFeatureStatus(v8::Isolate* isolate) {
   return gin::ConvertToV8(isolate, content::GetFeatureStatus());
 }
 
+v8::Local<v8::Promise> App::GetStartupTimeline(v8::Isolate* isolate) {
+  gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+  CollectStartupTimeline(base::BindOnce(
+      [](gin_helper::Promise<std::vector<gin_helper::Dictionary>> promise,
+         std::vector<ProcessStartupMarks> processes) {
+        // The times are relative to the first mark of the browser process,
+        // which comes first, the clock is the same in all processes.
+        base::TimeTicks origin;
+        if (!processes.empty() && !processes.front().marks.empty())
+          origin = processes.front().marks.front().start;
+
+        v8::Isolate* isolate = promise.isolate();
+        v8::HandleScope handle_scope(isolate);
+        v8::Context::Scope context_scope(promise.GetContext());
+        std::vector<gin_helper::Dictionary> result;
+        for (const auto& process : processes) {
+          std::vector<gin_helper::Dictionary> marks;
+          for (const auto& mark : process.marks) {
+            gin_helper::Dictionary dict =
+                gin::Dictionary::CreateEmpty(isolate);
+            dict.Set("name", mark.name);
+            dict.Set("startTime", (mark.start - origin).InMillisecondsF());
+            dict.Set("duration", mark.duration.InMillisecondsF());
+            marks.push_back(dict);
+          }
+          gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+          dict.Set("type", process.type);
+          dict.Set("pid", process.pid);
+          dict.Set("marks", marks);
+          result.push_back(dict);
+        }
+        promise.Resolve(result);
+      },
+      std::move(promise)));
+  return handle;
+}
+
 v8::Local<v8::Promise> App::GetGPUInfo(v8::Isolate* isolate,
                                        const std::string& info_type) {
   auto* const gpu_data_manager = content::GpuDataManagerImpl::GetInstance();
@@ -1824,8 +2132,16 @@ gin::ObjectTemplateBuilder App::GetObjectTemplateBuilder(v8::Isolate* isolate) {
                  &App::DisableDomainBlockingFor3DAPIs)
       .SetMethod("getFileIcon", &App::GetFileIcon)
       .SetMethod("getAppMetrics", &App::GetAppMetrics)
+      .SetMethod("startAppMetricsSampling", &App::StartAppMetricsSampling)
+      .SetMethod("stopAppMetricsSampling", &App::StopAppMetricsSampling)
+      .SetMethod("startResourceSampling", &App::StartResourceSampling)
+      .SetMethod("stopResourceSampling", &App::StopResourceSampling)
+      .SetMethod("getResourceSamples", &App::GetResourceSamples)
+      .SetMethod("startMainThreadWatchdog", &App::StartMainThreadWatchdog)
+      .SetMethod("stopMainThreadWatchdog", &App::StopMainThreadWatchdog)
       .SetMethod("getGPUFeatureStatus", &App::GetGPUFeatureStatus)
       .SetMethod("getGPUInfo", &App::GetGPUInfo)
+      .SetMethod("getStartupTimeline", &App::GetStartupTimeline)
 #if defined(MAS_BUILD)
       .SetMethod("startAccessingSecurityScopedResource",
                  &App::StartAccessingSecurityScopedResource)
@@ -10,7 +10,10 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/weak_ptr.h"
 #include "base/task/cancelable_task_tracker.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/timer/timer.h"
 #include "chrome/browser/icon_manager.h"
 #include "chrome/browser/process_singleton.h"
 #include "content/public/browser/browser_child_process_observer.h"
@@ -26,6 +29,8 @@
 #include "shell/browser/browser_observer.h"
 #include "shell/browser/electron_browser_client.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/browser/main_thread_watchdog.h"
+#include "shell/browser/resource_sampler.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/promise.h"
@@ -214,6 +219,23 @@ class App : public ElectronBrowserClient::Delegate,
                                      gin::Arguments* args);
 
   std::vector<gin_helper::Dictionary> GetAppMetrics(v8::Isolate* isolate);
+  // Emits "app-metrics" with the metrics of all the processes every
+  // |interval| milliseconds, reading them off the UI thread where possible.
+  void StartAppMetricsSampling(gin::Arguments* args);
+  void StopAppMetricsSampling();
+  // Samples the resource usage of all the processes on a worker thread into
+  // a ring buffer per process.
+  void StartResourceSampling(gin::Arguments* args);
+  void StopResourceSampling();
+  v8::Local<v8::Value> GetResourceSamples(v8::Isolate* isolate,
+                                          base::ProcessId pid);
+  void OnResourceUsage(const ResourceSampler::Summary& summary);
+  // Emits "main-thread-blocked" for the tasks of the main thread that run
+  // for longer than a threshold.
+  void StartMainThreadWatchdog(gin::Arguments* args);
+  void StopMainThreadWatchdog();
+  void OnMainThreadBlocked(const MainThreadWatchdog::BlockedTask& blocked_task);
+  v8::Local<v8::Promise> GetStartupTimeline(v8::Isolate* isolate);
   v8::Local<v8::Value> GetGPUFeatureStatus(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetGPUInfo(v8::Isolate* isolate,
                                     const std::string& info_type);
@@ -263,9 +285,36 @@ class App : public ElectronBrowserClient::Delegate,
       std::map<int, std::unique_ptr<electron::ProcessMetric>>;
   ProcessMetricMap app_metrics_;
 
+  using ProcessMemoryInfoMap =
+      std::map<base::ProcessId, electron::ProcessMemoryInfo>;
+  void SampleAppMetrics();
+  void OnAppMetricsSampled(ProcessMemoryInfoMap memory_info);
+
+  base::RepeatingTimer metrics_sampling_timer_;
+  bool metrics_sample_pending_ = false;
+
+#if BUILDFLAG(IS_LINUX)
+  // Reading the memory info of a process from procfs may block, so it is only
+  // read on |memory_task_runner_|.
+  void ReadMemoryInfoInBackground(
+      base::OnceCallback<void(ProcessMemoryInfoMap)> callback);
+  void RefreshMemoryInfo();
+  void OnMemoryInfoRefreshed(ProcessMemoryInfoMap memory_info);
+
+  scoped_refptr<base::SequencedTaskRunner> memory_task_runner_;
+  // The memory info read last, reported by getAppMetrics().
+  ProcessMemoryInfoMap memory_info_;
+  bool memory_info_refresh_pending_ = false;
+#endif
+
+  std::unique_ptr<ResourceSampler> resource_sampler_;
+  std::unique_ptr<MainThreadWatchdog> main_thread_watchdog_;
+
   bool disable_hw_acceleration_ = false;
   bool disable_domain_blocking_for_3DAPIs_ = false;
   bool watch_singleton_socket_on_ready_ = false;
+
+  base::WeakPtrFactory<App> weak_factory_{this};
 };
 
 }  // namespace api
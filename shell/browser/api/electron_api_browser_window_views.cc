@@ -4,7 +4,10 @@
 
 #include "shell/browser/api/electron_api_browser_window.h"
 
+#include <utility>
+
 #include "content/browser/web_contents/web_contents_impl.h"  // nogncheck
+#include "mojo/public/cpp/bindings/equals_traits.h"
 #include "shell/browser/native_window_views.h"
 #include "ui/aura/window.h"
 
@@ -15,6 +18,7 @@ void BrowserWindow::UpdateDraggableRegions(
   if (window_->has_frame())
     return;
 
+  auto* native_window = static_cast<NativeWindowViews*>(window_.get());
   if (&draggable_regions_ != &regions && web_contents()) {
     auto* view =
         static_cast<content::WebContentsImpl*>(web_contents())->GetView();
@@ -26,12 +30,15 @@ void BrowserWindow::UpdateDraggableRegions(
         snapped_region->bounds.Offset(offset.x(), offset.y());
       }
 
-      draggable_regions_ = mojo::Clone(snapped_regions);
+      // Skip rebuilding the window's region when nothing moved.
+      if (native_window->draggable_region() &&
+          mojo::Equals(snapped_regions, draggable_regions_))
+        return;
+      draggable_regions_ = std::move(snapped_regions);
     }
   }
 
-  static_cast<NativeWindowViews*>(window_.get())
-      ->UpdateDraggableRegions(draggable_regions_);
+  native_window->UpdateDraggableRegions(draggable_regions_);
 }
 
 }  // namespace electron::api
@@ -2,15 +2,23 @@
 // Use of this source code is governed by the MIT license that can be
 // found in the LICENSE file.
 
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
 
 #include "base/files/file_util.h"
+#include "base/strings/string_piece.h"
+#include "base/task/bind_post_task.h"
+#include "base/task/sequenced_task_runner.h"
 #include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/trace_event/trace_config.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
 #include "content/public/browser/tracing_controller.h"
+#include "shell/browser/flight_recorder.h"
+#include "shell/browser/gzip_compressor.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
@@ -21,8 +29,26 @@
 
 using content::TracingController;
 
+namespace {
+
+// A chunk of compressed trace data, passed to JS as a Buffer.
+struct TraceChunk {
+  std::string data;
+};
+
+}  // namespace
+
 namespace gin {
 
+template <>
+struct Converter<TraceChunk> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const TraceChunk& chunk) {
+    return node::Buffer::Copy(isolate, chunk.data.data(), chunk.data.size())
+        .ToLocalChecked();
+  }
+};
+
 template <>
 struct Converter<base::trace_event::TraceConfig> {
   static bool FromV8(v8::Isolate* isolate,
@@ -58,6 +84,68 @@ struct Converter<base::trace_event::TraceConfig> {
 namespace {
 
 using CompletionCallback = base::OnceCallback<void(const base::FilePath&)>;
+using electron::FlightRecorder;
+
+// Compresses the trace data with gzip on a worker sequence as it is
+// produced, and hands the compressed chunks to |on_data| on the UI thread.
+// |on_end| gets an error message when the data could not be compressed, and an
+// empty one otherwise.
+class GzipStreamEndpoint : public TracingController::TraceDataEndpoint {
+ public:
+  using DataCallback = base::RepeatingCallback<void(TraceChunk)>;
+  using EndCallback = base::OnceCallback<void(const std::string& error)>;
+
+  // The callbacks run and are destroyed on the UI thread, wherever the last
+  // reference to the endpoint goes away.
+  GzipStreamEndpoint(DataCallback on_data, EndCallback on_end)
+      : on_data_(base::BindPostTask(content::GetUIThreadTaskRunner({}),
+                                    std::move(on_data))),
+        on_end_(base::BindPostTask(content::GetUIThreadTaskRunner({}),
+                                   std::move(on_end))),
+        task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+            {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+             base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+  // disable copy
+  GzipStreamEndpoint(const GzipStreamEndpoint&) = delete;
+  GzipStreamEndpoint& operator=(const GzipStreamEndpoint&) = delete;
+
+  // TracingController::TraceDataEndpoint:
+  void ReceiveTraceChunk(std::unique_ptr<std::string> chunk) override {
+    task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&GzipStreamEndpoint::Compress, this,
+                                  std::move(chunk), false));
+  }
+
+  void ReceivedTraceFinalContents() override {
+    task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&GzipStreamEndpoint::Compress, this,
+                                  std::make_unique<std::string>(), true));
+  }
+
+ private:
+  ~GzipStreamEndpoint() override = default;
+
+  // Runs on |task_runner_|.
+  void Compress(std::unique_ptr<std::string> input, bool finish) {
+    if (!on_end_)
+      return;
+    TraceChunk output;
+    if (!compressor_.Compress(*input, finish, &output.data)) {
+      std::move(on_end_).Run("Failed to compress the trace data");
+      return;
+    }
+    if (!output.data.empty())
+      on_data_.Run(std::move(output));
+    if (finish)
+      std::move(on_end_).Run(std::string());
+  }
+
+  DataCallback on_data_;
+  EndCallback on_end_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  electron::GzipCompressor compressor_;
+};
 
 absl::optional<base::FilePath> CreateTemporaryFileOnIO() {
   base::FilePath temp_file_path;
@@ -83,7 +171,9 @@ void StopTracing(gin_helper::Promise<base::FilePath> promise,
     auto endpoint = TracingController::CreateFileEndpoint(
         *file_path,
         base::BindOnce(std::move(split_callback.first), absl::nullopt));
-    if (!TracingController::GetInstance()->StopTracing(endpoint)) {
+    if (TracingController::GetInstance()->StopTracing(endpoint)) {
+      FlightRecorder::GetInstance()->OnTracingStopped();
+    } else {
       std::move(split_callback.second)
           .Run(absl::make_optional(
               "Failed to stop tracing (was a trace in progress?)"));
@@ -144,6 +234,97 @@ v8::Local<v8::Promise> StartTracing(
   return handle;
 }
 
+void SettlePromise(gin_helper::Promise<void> promise,
+                   absl::optional<std::string> error) {
+  if (error) {
+    promise.RejectWithErrorMessage(error.value());
+  } else {
+    promise.Resolve();
+  }
+}
+
+v8::Local<v8::Promise> StartFlightRecorder(
+    v8::Isolate* isolate,
+    const base::trace_event::TraceConfig& trace_config) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto split_callback = base::SplitOnceCallback(
+      base::BindOnce(&SettlePromise, std::move(promise)));
+  if (!FlightRecorder::GetInstance()->Start(
+          trace_config,
+          base::BindOnce(std::move(split_callback.first), absl::nullopt))) {
+    std::move(split_callback.second)
+        .Run(absl::make_optional(std::string(
+            "Failed to start the flight recorder (is a trace in progress?)")));
+  }
+  return handle;
+}
+
+v8::Local<v8::Promise> StopFlightRecorder(v8::Isolate* isolate) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto split_callback = base::SplitOnceCallback(
+      base::BindOnce(&SettlePromise, std::move(promise)));
+  if (!FlightRecorder::GetInstance()->Stop(
+          base::BindOnce(std::move(split_callback.first), absl::nullopt))) {
+    std::move(split_callback.second)
+        .Run(absl::make_optional(std::string(
+            "Failed to stop the flight recorder (is it running?)")));
+  }
+  return handle;
+}
+
+void SnapshotToFile(gin_helper::Promise<base::FilePath> promise,
+                    absl::optional<base::FilePath> file_path) {
+  if (!file_path) {
+    promise.RejectWithErrorMessage(
+        "Failed to create temporary file for trace data");
+    return;
+  }
+  FlightRecorder::GetInstance()->SnapshotToFile(
+      *file_path, base::BindOnce(
+                      [](gin_helper::Promise<base::FilePath> promise,
+                         const base::FilePath& path,
+                         absl::optional<std::string> error) {
+                        if (error) {
+                          promise.RejectWithErrorMessage(error.value());
+                        } else {
+                          promise.Resolve(path);
+                        }
+                      },
+                      std::move(promise), *file_path));
+}
+
+v8::Local<v8::Promise> Snapshot(gin_helper::Arguments* args) {
+  gin_helper::Promise<base::FilePath> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  base::FilePath path;
+  if (args->GetNext(&path) && !path.empty()) {
+    SnapshotToFile(std::move(promise), absl::make_optional(path));
+  } else {
+    base::ThreadPool::PostTaskAndReplyWithResult(
+        FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+        base::BindOnce(CreateTemporaryFileOnIO),
+        base::BindOnce(SnapshotToFile, std::move(promise)));
+  }
+
+  return handle;
+}
+
+bool SnapshotStream(GzipStreamEndpoint::DataCallback on_data,
+                    GzipStreamEndpoint::EndCallback on_end) {
+  return FlightRecorder::GetInstance()->Snapshot(
+      base::MakeRefCounted<GzipStreamEndpoint>(std::move(on_data),
+                                               std::move(on_end)));
+}
+
+bool IsFlightRecorderRunning() {
+  return FlightRecorder::GetInstance()->is_recording();
+}
+
 void OnTraceBufferUsageAvailable(
     gin_helper::Promise<gin_helper::Dictionary> promise,
     float percent_full,
@@ -174,6 +355,11 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("startRecording", &StartTracing);
   dict.SetMethod("stopRecording", &StopRecording);
   dict.SetMethod("getTraceBufferUsage", &GetTraceBufferUsage);
+  dict.SetMethod("startFlightRecorder", &StartFlightRecorder);
+  dict.SetMethod("stopFlightRecorder", &StopFlightRecorder);
+  dict.SetMethod("isFlightRecorderRunning", &IsFlightRecorderRunning);
+  dict.SetMethod("snapshot", &Snapshot);
+  dict.SetMethod("snapshotStream", &SnapshotStream);
 }
 
 }  // namespace
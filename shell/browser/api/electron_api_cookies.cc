@@ -4,8 +4,13 @@
 
 #include "shell/browser/api/electron_api_cookies.h"
 
+#include <memory>
 #include <utility>
+#include <vector>
 
+#include "base/barrier_callback.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_util.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
@@ -95,49 +100,63 @@ namespace electron::api {
 
 namespace {
 
-// Returns whether |domain| matches |filter|.
-bool MatchesDomain(std::string filter, const std::string& domain) {
-  // Add a leading '.' character to the filter domain if it doesn't exist.
-  if (net::cookie_util::DomainIsHostOnly(filter))
-    filter.insert(0, ".");
+// A cookie filter parsed once from the JS filter object, so that matching a
+// large cookie list does not repeat dictionary lookups for every cookie.
+struct CookieFilter {
+  explicit CookieFilter(const base::Value::Dict& filter) {
+    const std::string* str;
+    if ((str = filter.FindString("name")))
+      name = *str;
+    if ((str = filter.FindString("path")))
+      path = *str;
+    if ((str = filter.FindString("domain"))) {
+      domain = *str;
+      // Add a leading '.' character to the filter domain if it doesn't exist.
+      if (net::cookie_util::DomainIsHostOnly(*domain))
+        domain->insert(0, ".");
+    }
+    secure = filter.FindBool("secure");
+    session = filter.FindBool("session");
+  }
+
+  absl::optional<std::string> name;
+  absl::optional<std::string> path;
+  absl::optional<std::string> domain;
+  absl::optional<bool> secure;
+  absl::optional<bool> session;
+};
 
-  std::string sub_domain(domain);
+// Returns whether |domain| matches |filter|, which must be normalized to
+// start with a '.' character.
+bool MatchesDomain(base::StringPiece filter, base::StringPiece domain) {
   // Strip any leading '.' character from the input cookie domain.
-  if (!net::cookie_util::DomainIsHostOnly(sub_domain))
-    sub_domain = sub_domain.substr(1);
-
-  // Now check whether the domain argument is a subdomain of the filter domain.
-  for (sub_domain.insert(0, "."); sub_domain.length() >= filter.length();) {
-    if (sub_domain == filter)
-      return true;
-    const size_t next_dot = sub_domain.find('.', 1);  // Skip over leading dot.
-    sub_domain.erase(0, next_dot);
-  }
-  return false;
+  if (base::StartsWith(domain, "."))
+    domain.remove_prefix(1);
+
+  // The domain matches if it is the filter domain itself or one of its
+  // subdomains. Since |filter| starts with a '.', a suffix match always falls
+  // on a label boundary.
+  return domain == filter.substr(1) || base::EndsWith(domain, filter);
 }
 
 // Returns whether |cookie| matches |filter|.
-bool MatchesCookie(const base::Value::Dict& filter,
+bool MatchesCookie(const CookieFilter& filter,
                    const net::CanonicalCookie& cookie) {
-  const std::string* str;
-  if ((str = filter.FindString("name")) && *str != cookie.Name())
+  if (filter.name && *filter.name != cookie.Name())
     return false;
-  if ((str = filter.FindString("path")) && *str != cookie.Path())
+  if (filter.path && *filter.path != cookie.Path())
     return false;
-  if ((str = filter.FindString("domain")) &&
-      !MatchesDomain(*str, cookie.Domain()))
+  if (filter.domain && !MatchesDomain(*filter.domain, cookie.Domain()))
     return false;
-  absl::optional<bool> secure_filter = filter.FindBool("secure");
-  if (secure_filter && *secure_filter != cookie.IsSecure())
+  if (filter.secure && *filter.secure != cookie.IsSecure())
     return false;
-  absl::optional<bool> session_filter = filter.FindBool("session");
-  if (session_filter && *session_filter == cookie.IsPersistent())
+  if (filter.session && *filter.session == cookie.IsPersistent())
     return false;
   return true;
 }
 
 // Remove cookies from |list| not matching |filter|, and pass it to |callback|.
-void FilterCookies(base::Value::Dict filter,
+void FilterCookies(const CookieFilter& filter,
                    gin_helper::Promise<net::CookieList> promise,
                    const net::CookieList& cookies) {
   net::CookieList result;
@@ -149,11 +168,11 @@ void FilterCookies(base::Value::Dict filter,
 }
 
 void FilterCookieWithStatuses(
-    base::Value::Dict filter,
+    const CookieFilter& filter,
     gin_helper::Promise<net::CookieList> promise,
     const net::CookieAccessResultList& list,
     const net::CookieAccessResultList& excluded_list) {
-  FilterCookies(std::move(filter), std::move(promise),
+  FilterCookies(filter, std::move(promise),
                 net::cookie_util::StripAccessResults(list));
 }
 
@@ -209,6 +228,75 @@ std::string StringToCookieSameSite(const std::string* str_ptr,
   return "";
 }
 
+// A cookie which has been validated and is ready to be sent to the cookie
+// manager.
+struct PendingCookie {
+  std::unique_ptr<net::CanonicalCookie> cookie;
+  GURL url;
+  net::CookieOptions options;
+};
+
+// Converts the |details| passed to cookies.set() into a canonical cookie.
+// Returns nullptr and sets |error| if the details are invalid.
+std::unique_ptr<PendingCookie> CreateCookieFromDetails(
+    const base::Value::Dict& details,
+    std::string* error) {
+  const std::string* url_string = details.FindString("url");
+  if (!url_string) {
+    *error = "Missing required option 'url'";
+    return nullptr;
+  }
+  const std::string* name = details.FindString("name");
+  const std::string* value = details.FindString("value");
+  const std::string* domain = details.FindString("domain");
+  const std::string* path = details.FindString("path");
+  bool http_only = details.FindBool("httpOnly").value_or(false);
+  const std::string* same_site_string = details.FindString("sameSite");
+  net::CookieSameSite same_site;
+  *error = StringToCookieSameSite(same_site_string, &same_site);
+  if (!error->empty())
+    return nullptr;
+  bool secure = details.FindBool("secure").value_or(
+      same_site == net::CookieSameSite::NO_RESTRICTION);
+  bool same_party =
+      details.FindBool("sameParty")
+          .value_or(secure && same_site != net::CookieSameSite::STRICT_MODE);
+
+  auto result = std::make_unique<PendingCookie>();
+  result->url = GURL(*url_string);
+  if (!result->url.is_valid()) {
+    *error = InclusionStatusToString(net::CookieInclusionStatus(
+        net::CookieInclusionStatus::EXCLUDE_INVALID_DOMAIN));
+    return nullptr;
+  }
+
+  net::CookieInclusionStatus status;
+  result->cookie = net::CanonicalCookie::CreateSanitizedCookie(
+      result->url, name ? *name : "", value ? *value : "",
+      domain ? *domain : "", path ? *path : "",
+      ParseTimeProperty(details.FindDouble("creationDate")),
+      ParseTimeProperty(details.FindDouble("expirationDate")),
+      ParseTimeProperty(details.FindDouble("lastAccessDate")), secure,
+      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT, same_party,
+      absl::nullopt, &status);
+
+  if (!result->cookie || !result->cookie->IsCanonical()) {
+    *error = InclusionStatusToString(
+        !status.IsInclude()
+            ? status
+            : net::CookieInclusionStatus(
+                  net::CookieInclusionStatus::EXCLUDE_FAILURE_TO_STORE));
+    return nullptr;
+  }
+
+  if (http_only) {
+    result->options.set_include_httponly();
+  }
+  result->options.set_same_site_cookie_context(
+      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
+  return result;
+}
+
 }  // namespace
 
 gin::WrapperInfo Cookies::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -237,8 +325,8 @@ v8::Local<v8::Promise> Cookies::Get(v8::Isolate* isolate,
   std::string url;
   filter.Get("url", &url);
   if (url.empty()) {
-    manager->GetAllCookies(
-        base::BindOnce(&FilterCookies, std::move(dict), std::move(promise)));
+    manager->GetAllCookies(base::BindOnce(
+        &FilterCookies, CookieFilter(dict), std::move(promise)));
   } else {
     net::CookieOptions options;
     options.set_include_httponly();
@@ -249,7 +337,8 @@ v8::Local<v8::Promise> Cookies::Get(v8::Isolate* isolate,
     manager->GetCookieList(GURL(url), options,
                            net::CookiePartitionKeyCollection::Todo(),
                            base::BindOnce(&FilterCookieWithStatuses,
-                                          std::move(dict), std::move(promise)));
+                                          CookieFilter(dict),
+                                          std::move(promise)));
   }
 
   return handle;
@@ -284,66 +373,17 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
 
-  const std::string* url_string = details.FindString("url");
-  if (!url_string) {
-    promise.RejectWithErrorMessage("Missing required option 'url'");
-    return handle;
-  }
-  const std::string* name = details.FindString("name");
-  const std::string* value = details.FindString("value");
-  const std::string* domain = details.FindString("domain");
-  const std::string* path = details.FindString("path");
-  bool http_only = details.FindBool("httpOnly").value_or(false);
-  const std::string* same_site_string = details.FindString("sameSite");
-  net::CookieSameSite same_site;
-  std::string error = StringToCookieSameSite(same_site_string, &same_site);
-  if (!error.empty()) {
+  std::string error;
+  auto cookie = CreateCookieFromDetails(details, &error);
+  if (!cookie) {
     promise.RejectWithErrorMessage(error);
     return handle;
   }
-  bool secure = details.FindBool("secure").value_or(
-      same_site == net::CookieSameSite::NO_RESTRICTION);
-  bool same_party =
-      details.FindBool("sameParty")
-          .value_or(secure && same_site != net::CookieSameSite::STRICT_MODE);
-
-  GURL url(url_string ? *url_string : "");
-  if (!url.is_valid()) {
-    promise.RejectWithErrorMessage(
-        InclusionStatusToString(net::CookieInclusionStatus(
-            net::CookieInclusionStatus::EXCLUDE_INVALID_DOMAIN)));
-    return handle;
-  }
-
-  net::CookieInclusionStatus status;
-  auto canonical_cookie = net::CanonicalCookie::CreateSanitizedCookie(
-      url, name ? *name : "", value ? *value : "", domain ? *domain : "",
-      path ? *path : "", ParseTimeProperty(details.FindDouble("creationDate")),
-      ParseTimeProperty(details.FindDouble("expirationDate")),
-      ParseTimeProperty(details.FindDouble("lastAccessDate")), secure,
-      http_only, same_site, net::COOKIE_PRIORITY_DEFAULT, same_party,
-      absl::nullopt, &status);
-
-  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
-    promise.RejectWithErrorMessage(InclusionStatusToString(
-        !status.IsInclude()
-            ? status
-            : net::CookieInclusionStatus(
-                  net::CookieInclusionStatus::EXCLUDE_FAILURE_TO_STORE)));
-    return handle;
-  }
-
-  net::CookieOptions options;
-  if (http_only) {
-    options.set_include_httponly();
-  }
-  options.set_same_site_cookie_context(
-      net::CookieOptions::SameSiteCookieContext::MakeInclusive());
 
   auto* storage_partition = browser_context_->GetDefaultStoragePartition();
   auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
   manager->SetCanonicalCookie(
-      *canonical_cookie, url, options,
+      *cookie->cookie, cookie->url, cookie->options,
       base::BindOnce(
           [](gin_helper::Promise<void> promise, net::CookieAccessResult r) {
             if (r.status.IsInclude()) {
@@ -357,6 +397,114 @@ v8::Local<v8::Promise> Cookies::Set(v8::Isolate* isolate,
   return handle;
 }
 
+v8::Local<v8::Promise> Cookies::SetMany(v8::Isolate* isolate,
+                                        base::Value::List details_list) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // Validate every cookie before issuing any request, so that a malformed
+  // entry does not leave the store partially updated.
+  std::vector<std::unique_ptr<PendingCookie>> cookies;
+  cookies.reserve(details_list.size());
+  for (const auto& details : details_list) {
+    if (!details.is_dict()) {
+      promise.RejectWithErrorMessage("Each cookie must be an object");
+      return handle;
+    }
+    std::string error;
+    auto cookie = CreateCookieFromDetails(details.GetDict(), &error);
+    if (!cookie) {
+      promise.RejectWithErrorMessage(error);
+      return handle;
+    }
+    cookies.push_back(std::move(cookie));
+  }
+
+  if (cookies.empty()) {
+    promise.Resolve();
+    return handle;
+  }
+
+  // All requests are pipelined over the cookie manager connection and the
+  // promise settles once the network service has answered every one of them.
+  auto barrier = base::BarrierCallback<net::CookieAccessResult>(
+      cookies.size(),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise,
+             std::vector<net::CookieAccessResult> results) {
+            for (const auto& r : results) {
+              if (!r.status.IsInclude()) {
+                promise.RejectWithErrorMessage(
+                    InclusionStatusToString(r.status));
+                return;
+              }
+            }
+            promise.Resolve();
+          },
+          std::move(promise)));
+
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+  for (const auto& cookie : cookies) {
+    manager->SetCanonicalCookie(*cookie->cookie, cookie->url, cookie->options,
+                                barrier);
+  }
+
+  return handle;
+}
+
+v8::Local<v8::Promise> Cookies::RemoveMany(v8::Isolate* isolate,
+                                           base::Value::List cookies) {
+  gin_helper::Promise<uint32_t> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::vector<network::mojom::CookieDeletionFilterPtr> filters;
+  filters.reserve(cookies.size());
+  for (const auto& cookie : cookies) {
+    const std::string* url_string =
+        cookie.is_dict() ? cookie.GetDict().FindString("url") : nullptr;
+    if (!url_string) {
+      promise.RejectWithErrorMessage("Missing required option 'url'");
+      return handle;
+    }
+    GURL url(*url_string);
+    if (!url.is_valid()) {
+      promise.RejectWithErrorMessage("Invalid url: " + *url_string);
+      return handle;
+    }
+    auto filter = network::mojom::CookieDeletionFilter::New();
+    filter->url = url;
+    // Omitting the name removes every cookie associated with |url|.
+    if (const std::string* name = cookie.GetDict().FindString("name"))
+      filter->cookie_name = *name;
+    filters.push_back(std::move(filter));
+  }
+
+  if (filters.empty()) {
+    promise.Resolve(0);
+    return handle;
+  }
+
+  auto barrier = base::BarrierCallback<uint32_t>(
+      filters.size(),
+      base::BindOnce(
+          [](gin_helper::Promise<uint32_t> promise,
+             std::vector<uint32_t> num_deleted) {
+            uint32_t total = 0;
+            for (uint32_t n : num_deleted)
+              total += n;
+            promise.Resolve(total);
+          },
+          std::move(promise)));
+
+  auto* storage_partition = browser_context_->GetDefaultStoragePartition();
+  auto* manager = storage_partition->GetCookieManagerForBrowserProcess();
+  for (auto& filter : filters)
+    manager->DeleteCookies(std::move(filter), barrier);
+
+  return handle;
+}
+
 v8::Local<v8::Promise> Cookies::FlushStore(v8::Isolate* isolate) {
   gin_helper::Promise<void> promise(isolate);
   v8::Local<v8::Promise> handle = promise.GetHandle();
@@ -392,6 +540,8 @@ gin::ObjectTemplateBuilder Cookies::GetObjectTemplateBuilder(
       .SetMethod("get", &Cookies::Get)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
+      .SetMethod("setMany", &Cookies::SetMany)
+      .SetMethod("removeMany", &Cookies::RemoveMany)
       .SetMethod("flushStore", &Cookies::FlushStore);
 }
 
@@ -52,6 +52,8 @@ class Cookies : public gin::Wrappable<Cookies>,
   v8::Local<v8::Promise> Remove(v8::Isolate*,
                                 const GURL& url,
                                 const std::string& name);
+  v8::Local<v8::Promise> SetMany(v8::Isolate*, base::Value::List details);
+  v8::Local<v8::Promise> RemoveMany(v8::Isolate*, base::Value::List cookies);
   v8::Local<v8::Promise> FlushStore(v8::Isolate*);
 
   // CookieChangeNotifier subscription:
@@ -9,8 +9,11 @@
 #include <utility>
 #include <vector>
 
+#include "base/containers/contains.h"
+#include "base/memory/raw_ptr.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_restrictions.h"
 #include "chrome/browser/media/webrtc/desktop_media_list.h"
 #include "chrome/browser/media/webrtc/window_icon_util.h"
@@ -186,15 +189,6 @@ void DesktopCapturer::StartHandling(bool capture_window,
                                     const gfx::Size& thumbnail_size,
                                     bool fetch_window_icons) {
   fetch_window_icons_ = fetch_window_icons;
-#if BUILDFLAG(IS_WIN)
-  if (content::desktop_capture::CreateDesktopCaptureOptions()
-          .allow_directx_capturer()) {
-    // DxgiDuplicatorController should be alive in this scope according to
-    // screen_capturer_win.cc.
-    auto duplicator = webrtc::DxgiDuplicatorController::Instance();
-    using_directx_capturer_ = webrtc::ScreenCapturerWinDirectx::IsSupported();
-  }
-#endif  // BUILDFLAG(IS_WIN)
 
   // clear any existing captured sources.
   captured_sources_.clear();
@@ -255,59 +249,15 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
       screen_sources.emplace_back(
           DesktopCapturer::Source{list->GetSource(i), std::string()});
     }
-#if BUILDFLAG(IS_WIN)
-    // Gather the same unique screen IDs used by the electron.screen API in
-    // order to provide an association between it and
-    // desktopCapturer/getUserMedia. This is only required when using the
-    // DirectX capturer, otherwise the IDs across the APIs already match.
-    if (using_directx_capturer_) {
-      std::vector<std::string> device_names;
-      // Crucially, this list of device names will be in the same order as
-      // |media_list_sources|.
-      if (!webrtc::DxgiDuplicatorController::Instance()->GetDeviceNames(
-              &device_names)) {
-        v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
-        v8::HandleScope scope(isolate);
-        gin_helper::CallMethod(this, "_onerror", "Failed to get sources.");
-
-        Unpin();
-
-        return;
-      }
+    if (!UpdateDisplayIds(&screen_sources)) {
+      v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+      v8::HandleScope scope(isolate);
+      gin_helper::CallMethod(this, "_onerror", "Failed to get sources.");
 
-      int device_name_index = 0;
-      for (auto& source : screen_sources) {
-        const auto& device_name = device_names[device_name_index++];
-        std::wstring wide_device_name;
-        base::UTF8ToWide(device_name.c_str(), device_name.size(),
-                         &wide_device_name);
-        const int64_t device_id =
-            display::win::internal::DisplayInfo::DeviceIdFromDeviceName(
-                wide_device_name.c_str());
-        source.display_id = base::NumberToString(device_id);
-      }
-    }
-#elif BUILDFLAG(IS_MAC)
-    // On Mac, the IDs across the APIs match.
-    for (auto& source : screen_sources) {
-      source.display_id = base::NumberToString(source.media_list_source.id.id);
-    }
-#elif BUILDFLAG(IS_LINUX)
-#if defined(USE_OZONE_PLATFORM_X11)
-    // On Linux, with X11, the source id is the numeric value of the
-    // display name atom and the display id is either the EDID or the
-    // loop index when that display was found (see
-    // BuildDisplaysFromXRandRInfo in ui/base/x/x11_display_util.cc)
-    std::map<int32_t, uint32_t> monitor_atom_to_display_id =
-        MonitorAtomIdToDisplayId();
-    for (auto& source : screen_sources) {
-      auto display_id_iter =
-          monitor_atom_to_display_id.find(source.media_list_source.id.id);
-      if (display_id_iter != monitor_atom_to_display_id.end())
-        source.display_id = base::NumberToString(display_id_iter->second);
+      Unpin();
+
+      return;
     }
-#endif  // defined(USE_OZONE_PLATFORM_X11)
-#endif  // BUILDFLAG(IS_WIN)
     std::move(screen_sources.begin(), screen_sources.end(),
               std::back_inserter(captured_sources_));
   }
@@ -321,6 +271,63 @@ void DesktopCapturer::UpdateSourcesList(DesktopMediaList* list) {
   }
 }
 
+// static
+bool DesktopCapturer::UpdateDisplayIds(std::vector<Source>* screen_sources) {
+#if BUILDFLAG(IS_WIN)
+  // Gather the same unique screen IDs used by the electron.screen API in
+  // order to provide an association between it and
+  // desktopCapturer/getUserMedia. This is only required when using the
+  // DirectX capturer, otherwise the IDs across the APIs already match.
+  if (!content::desktop_capture::CreateDesktopCaptureOptions()
+           .allow_directx_capturer())
+    return true;
+  // DxgiDuplicatorController should be alive in this scope according to
+  // screen_capturer_win.cc.
+  auto duplicator = webrtc::DxgiDuplicatorController::Instance();
+  if (!webrtc::ScreenCapturerWinDirectx::IsSupported())
+    return true;
+
+  std::vector<std::string> device_names;
+  // Crucially, this list of device names will be in the same order as
+  // |media_list_sources|.
+  if (!duplicator->GetDeviceNames(&device_names))
+    return false;
+
+  int device_name_index = 0;
+  for (auto& source : *screen_sources) {
+    const auto& device_name = device_names[device_name_index++];
+    std::wstring wide_device_name;
+    base::UTF8ToWide(device_name.c_str(), device_name.size(),
+                     &wide_device_name);
+    const int64_t device_id =
+        display::win::internal::DisplayInfo::DeviceIdFromDeviceName(
+            wide_device_name.c_str());
+    source.display_id = base::NumberToString(device_id);
+  }
+#elif BUILDFLAG(IS_MAC)
+  // On Mac, the IDs across the APIs match.
+  for (auto& source : *screen_sources) {
+    source.display_id = base::NumberToString(source.media_list_source.id.id);
+  }
+#elif BUILDFLAG(IS_LINUX)
+#if defined(USE_OZONE_PLATFORM_X11)
+  // On Linux, with X11, the source id is the numeric value of the
+  // display name atom and the display id is either the EDID or the
+  // loop index when that display was found (see
+  // BuildDisplaysFromXRandRInfo in ui/base/x/x11_display_util.cc)
+  std::map<int32_t, uint32_t> monitor_atom_to_display_id =
+      MonitorAtomIdToDisplayId();
+  for (auto& source : *screen_sources) {
+    auto display_id_iter =
+        monitor_atom_to_display_id.find(source.media_list_source.id.id);
+    if (display_id_iter != monitor_atom_to_display_id.end())
+      source.display_id = base::NumberToString(display_id_iter->second);
+  }
+#endif  // defined(USE_OZONE_PLATFORM_X11)
+#endif  // BUILDFLAG(IS_WIN)
+  return true;
+}
+
 // static
 gin::Handle<DesktopCapturer> DesktopCapturer::Create(v8::Isolate* isolate) {
   auto handle = gin::CreateHandle(isolate, new DesktopCapturer(isolate));
@@ -341,6 +348,246 @@ const char* DesktopCapturer::GetTypeName() {
   return "DesktopCapturer";
 }
 
+class DesktopCapturerSourceWatcher::ListObserver
+    : public DesktopMediaListObserver {
+ public:
+  ListObserver(DesktopCapturerSourceWatcher* watcher,
+               std::unique_ptr<DesktopMediaList> list)
+      : watcher_(watcher), list_(std::move(list)) {}
+
+  // disable copy
+  ListObserver(const ListObserver&) = delete;
+  ListObserver& operator=(const ListObserver&) = delete;
+
+  DesktopMediaList* list() const { return list_.get(); }
+
+  // DesktopMediaListObserver:
+  void OnSourceAdded(int index) override {
+    watcher_->OnSourceAdded(list(), index);
+  }
+  void OnSourceRemoved(int index) override {
+    watcher_->OnSourceRemoved(list(), index);
+  }
+  void OnSourceMoved(int old_index, int new_index) override {
+    watcher_->OnSourceMoved(list(), old_index, new_index);
+  }
+  void OnSourceNameChanged(int index) override {
+    watcher_->OnSourceNameChanged(list(), index);
+  }
+  void OnSourceThumbnailChanged(int index) override {
+    watcher_->OnSourceThumbnailChanged(list(), index);
+  }
+  void OnSourcePreviewChanged(size_t index) override {}
+  void OnDelegatedSourceListSelection() override {}
+  void OnDelegatedSourceListDismissed() override {}
+
+ private:
+  raw_ptr<DesktopCapturerSourceWatcher> watcher_;
+  std::unique_ptr<DesktopMediaList> list_;
+};
+
+gin::WrapperInfo DesktopCapturerSourceWatcher::kWrapperInfo = {
+    gin::kEmbedderNativeGin};
+
+DesktopCapturerSourceWatcher::DesktopCapturerSourceWatcher(
+    v8::Isolate* isolate,
+    const gfx::Size& thumbnail_size,
+    bool fetch_window_icons)
+    : thumbnail_size_(thumbnail_size),
+      fetch_window_icons_(fetch_window_icons) {}
+
+DesktopCapturerSourceWatcher::~DesktopCapturerSourceWatcher() = default;
+
+// static
+gin::Handle<DesktopCapturerSourceWatcher> DesktopCapturerSourceWatcher::Create(
+    v8::Isolate* isolate,
+    bool capture_window,
+    bool capture_screen,
+    const gfx::Size& thumbnail_size,
+    bool fetch_window_icons,
+    int update_interval_ms) {
+  auto handle = gin::CreateHandle(
+      isolate, new DesktopCapturerSourceWatcher(isolate, thumbnail_size,
+                                                fetch_window_icons));
+  auto update_period = base::Milliseconds(update_interval_ms);
+  if (capture_window) {
+    handle->StartList(DesktopMediaList::Type::kWindow,
+                      content::desktop_capture::CreateWindowCapturer(),
+                      update_period);
+  }
+  if (capture_screen) {
+    handle->StartList(DesktopMediaList::Type::kScreen,
+                      content::desktop_capture::CreateScreenCapturer(),
+                      update_period);
+  }
+
+  // Keep reference alive until the watcher is stopped.
+  handle->Pin(isolate);
+
+  return handle;
+}
+
+void DesktopCapturerSourceWatcher::StartList(
+    DesktopMediaList::Type type,
+    std::unique_ptr<webrtc::DesktopCapturer> capturer,
+    base::TimeDelta update_period) {
+  auto observer = std::make_unique<ListObserver>(
+      this,
+      std::make_unique<NativeDesktopMediaList>(type, std::move(capturer)));
+  DesktopMediaList* list = observer->list();
+  list->SetUpdatePeriod(update_period);
+  // No thumbnails are captured until some sources are visible.
+  list->SetThumbnailSize(gfx::Size());
+  lists_.push_back(std::move(observer));
+  list->StartUpdating(lists_.back().get());
+}
+
+bool DesktopCapturerSourceWatcher::IsVisible(
+    const content::DesktopMediaID& id) const {
+  return base::Contains(visible_sources_, id.ToString());
+}
+
+std::vector<DesktopCapturer::Source>
+DesktopCapturerSourceWatcher::GetListSources(DesktopMediaList* list) {
+  bool is_window = list->GetMediaListType() == DesktopMediaList::Type::kWindow;
+  std::vector<DesktopCapturer::Source> sources;
+  sources.reserve(list->GetSourceCount());
+  for (int i = 0; i < list->GetSourceCount(); i++) {
+    sources.push_back(
+        {list->GetSource(i), std::string(), is_window && fetch_window_icons_});
+  }
+  if (!is_window && !DesktopCapturer::UpdateDisplayIds(&sources)) {
+    for (auto& source : sources)
+      source.display_id.clear();
+  }
+  for (auto& source : sources) {
+    if (!IsVisible(source.media_list_source.id))
+      source.media_list_source.thumbnail = gfx::ImageSkia();
+  }
+  return sources;
+}
+
+DesktopCapturer::Source DesktopCapturerSourceWatcher::GetSource(
+    DesktopMediaList* list,
+    int index) {
+  if (list->GetMediaListType() != DesktopMediaList::Type::kWindow)
+    return std::move(GetListSources(list)[index]);
+  DesktopCapturer::Source source{list->GetSource(index), std::string(),
+                                 fetch_window_icons_};
+  if (!IsVisible(source.media_list_source.id))
+    source.media_list_source.thumbnail = gfx::ImageSkia();
+  return source;
+}
+
+void DesktopCapturerSourceWatcher::UpdateThumbnailSize() {
+  // Chromium captures the thumbnails of all the sources of a list at once,
+  // so thumbnails are only captured at all while some source is visible.
+  gfx::Size size = visible_sources_.empty() ? gfx::Size() : thumbnail_size_;
+  for (const auto& observer : lists_)
+    observer->list()->SetThumbnailSize(size);
+}
+
+void DesktopCapturerSourceWatcher::OnSourceAdded(DesktopMediaList* list,
+                                                 int index) {
+  auto& ids = source_ids_[list];
+  if (stopped_ || index < 0 || static_cast<size_t>(index) > ids.size())
+    return;
+  ids.insert(ids.begin() + index, list->GetSource(index).id.ToString());
+  Emit("source-added", GetSource(list, index));
+}
+
+void DesktopCapturerSourceWatcher::OnSourceRemoved(DesktopMediaList* list,
+                                                   int index) {
+  auto& ids = source_ids_[list];
+  if (stopped_ || index < 0 || static_cast<size_t>(index) >= ids.size())
+    return;
+  std::string id = ids[index];
+  ids.erase(ids.begin() + index);
+  Emit("source-removed", id);
+}
+
+void DesktopCapturerSourceWatcher::OnSourceMoved(DesktopMediaList* list,
+                                                 int old_index,
+                                                 int new_index) {
+  auto& ids = source_ids_[list];
+  if (stopped_ || old_index < 0 || new_index < 0 ||
+      static_cast<size_t>(old_index) >= ids.size() ||
+      static_cast<size_t>(new_index) >= ids.size()) {
+    return;
+  }
+  std::string id = ids[old_index];
+  ids.erase(ids.begin() + old_index);
+  ids.insert(ids.begin() + new_index, id);
+}
+
+void DesktopCapturerSourceWatcher::OnSourceNameChanged(DesktopMediaList* list,
+                                                       int index) {
+  if (stopped_ || index < 0 || index >= list->GetSourceCount())
+    return;
+  const auto& source = list->GetSource(index);
+  Emit("source-name-changed", source.id.ToString(),
+       base::UTF16ToUTF8(source.name));
+}
+
+void DesktopCapturerSourceWatcher::OnSourceThumbnailChanged(
+    DesktopMediaList* list,
+    int index) {
+  if (stopped_ || index < 0 || index >= list->GetSourceCount())
+    return;
+  const auto& source = list->GetSource(index);
+  if (!IsVisible(source.id) || source.thumbnail.isNull())
+    return;
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope scope(isolate);
+  Emit("thumbnail-changed", source.id.ToString(),
+       NativeImage::Create(isolate, gfx::Image(source.thumbnail)));
+}
+
+std::vector<DesktopCapturer::Source>
+DesktopCapturerSourceWatcher::GetSources() {
+  std::vector<DesktopCapturer::Source> sources;
+  for (const auto& observer : lists_) {
+    std::vector<DesktopCapturer::Source> list_sources =
+        GetListSources(observer->list());
+    std::move(list_sources.begin(), list_sources.end(),
+              std::back_inserter(sources));
+  }
+  return sources;
+}
+
+void DesktopCapturerSourceWatcher::SetVisibleSources(
+    const std::vector<std::string>& ids) {
+  visible_sources_ = std::set<std::string>(ids.begin(), ids.end());
+  UpdateThumbnailSize();
+}
+
+void DesktopCapturerSourceWatcher::Stop() {
+  // The lists may be reporting a change right now, e.g. when the watcher is
+  // stopped from an event listener.
+  stopped_ = true;
+  for (auto& observer : lists_) {
+    base::SequencedTaskRunnerHandle::Get()->DeleteSoon(FROM_HERE,
+                                                       std::move(observer));
+  }
+  lists_.clear();
+  source_ids_.clear();
+  Unpin();
+}
+
+gin::ObjectTemplateBuilder
+DesktopCapturerSourceWatcher::GetObjectTemplateBuilder(v8::Isolate* isolate) {
+  return gin_helper::EventEmitterMixin<
+             DesktopCapturerSourceWatcher>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("getSources", &DesktopCapturerSourceWatcher::GetSources)
+      .SetMethod("setVisibleSources",
+                 &DesktopCapturerSourceWatcher::SetVisibleSources)
+      .SetMethod("stop", &DesktopCapturerSourceWatcher::Stop);
+}
+
+const char* DesktopCapturerSourceWatcher::GetTypeName() {
+  return "DesktopCapturerSourceWatcher";
+}
+
 }  // namespace electron::api
 
 namespace {
@@ -352,6 +599,8 @@ void Initialize(v8::Local<v8::Object> exports,
   gin_helper::Dictionary dict(context->GetIsolate(), exports);
   dict.SetMethod("createDesktopCapturer",
                  &electron::api::DesktopCapturer::Create);
+  dict.SetMethod("createSourceWatcher",
+                 &electron::api::DesktopCapturerSourceWatcher::Create);
 }
 
 }  // namespace
@@ -5,7 +5,9 @@
 #ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DESKTOP_CAPTURER_H_
 #define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DESKTOP_CAPTURER_H_
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -13,6 +15,7 @@
 #include "chrome/browser/media/webrtc/native_desktop_media_list.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
+#include "shell/browser/event_emitter_mixin.h"
 #include "shell/common/gin_helper/pinnable.h"
 
 namespace electron::api {
@@ -32,6 +35,11 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
 
   static gin::Handle<DesktopCapturer> Create(v8::Isolate* isolate);
 
+  // Fills in the |display_id| of |screen_sources|, which must be all the
+  // sources of a screen list in order. Returns false if the ids could not be
+  // read.
+  static bool UpdateDisplayIds(std::vector<Source>* screen_sources);
+
   void StartHandling(bool capture_window,
                      bool capture_screen,
                      const gfx::Size& thumbnail_size,
@@ -70,13 +78,79 @@ class DesktopCapturer : public gin::Wrappable<DesktopCapturer>,
   bool capture_window_ = false;
   bool capture_screen_ = false;
   bool fetch_window_icons_ = false;
-#if BUILDFLAG(IS_WIN)
-  bool using_directx_capturer_ = false;
-#endif  // BUILDFLAG(IS_WIN)
 
   base::WeakPtrFactory<DesktopCapturer> weak_ptr_factory_{this};
 };
 
+// Keeps the source lists alive and reports changes to them as events, so a
+// source picker does not have to enumerate every source again to update.
+class DesktopCapturerSourceWatcher
+    : public gin::Wrappable<DesktopCapturerSourceWatcher>,
+      public gin_helper::EventEmitterMixin<DesktopCapturerSourceWatcher>,
+      public gin_helper::Pinnable<DesktopCapturerSourceWatcher> {
+ public:
+  static gin::Handle<DesktopCapturerSourceWatcher> Create(
+      v8::Isolate* isolate,
+      bool capture_window,
+      bool capture_screen,
+      const gfx::Size& thumbnail_size,
+      bool fetch_window_icons,
+      int update_interval_ms);
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // disable copy
+  DesktopCapturerSourceWatcher(const DesktopCapturerSourceWatcher&) = delete;
+  DesktopCapturerSourceWatcher& operator=(
+      const DesktopCapturerSourceWatcher&) = delete;
+
+ protected:
+  DesktopCapturerSourceWatcher(v8::Isolate* isolate,
+                               const gfx::Size& thumbnail_size,
+                               bool fetch_window_icons);
+  ~DesktopCapturerSourceWatcher() override;
+
+ private:
+  class ListObserver;
+
+  void StartList(DesktopMediaList::Type type,
+                 std::unique_ptr<webrtc::DesktopCapturer> capturer,
+                 base::TimeDelta update_period);
+  bool IsVisible(const content::DesktopMediaID& id) const;
+  // Builds the sources of |list| in one pass, since the display ids of the
+  // screens are resolved for the whole list at once.
+  std::vector<DesktopCapturer::Source> GetListSources(DesktopMediaList* list);
+  DesktopCapturer::Source GetSource(DesktopMediaList* list, int index);
+  void UpdateThumbnailSize();
+
+  // Called by the ListObserver of |list|.
+  void OnSourceAdded(DesktopMediaList* list, int index);
+  void OnSourceRemoved(DesktopMediaList* list, int index);
+  void OnSourceMoved(DesktopMediaList* list, int old_index, int new_index);
+  void OnSourceNameChanged(DesktopMediaList* list, int index);
+  void OnSourceThumbnailChanged(DesktopMediaList* list, int index);
+
+  // JS APIs.
+  std::vector<DesktopCapturer::Source> GetSources();
+  void SetVisibleSources(const std::vector<std::string>& ids);
+  void Stop();
+
+  std::vector<std::unique_ptr<ListObserver>> lists_;
+  // The ids of the sources whose thumbnails are reported.
+  std::set<std::string> visible_sources_;
+  // The ids of the sources in each list, to report removed sources by id.
+  std::map<DesktopMediaList*, std::vector<std::string>> source_ids_;
+  gfx::Size thumbnail_size_;
+  bool fetch_window_icons_ = false;
+  // The lists are deleted asynchronously, so they can still report changes
+  // after Stop().
+  bool stopped_ = false;
+};
+
 }  // namespace electron::api
 
 #endif  // ELECTRON_SHELL_BROWSER_API_ELECTRON_API_DESKTOP_CAPTURER_H_
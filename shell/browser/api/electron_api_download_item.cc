@@ -8,8 +8,10 @@
 
 #include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "content/public/browser/download_item_utils.h"
 #include "net/base/filename_util.h"
 #include "shell/browser/electron_browser_main_parts.h"
+#include "shell/browser/session_preferences.h"
 #include "shell/common/gin_converters/file_dialog_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
@@ -104,18 +106,57 @@ bool DownloadItem::CheckAlive() const {
   return true;
 }
 
+bool DownloadItem::ShouldCoalesceUpdate() {
+  auto* prefs = SessionPreferences::FromBrowserContext(
+      content::DownloadItemUtils::GetBrowserContext(download_item_));
+  if (!prefs || last_updated_time_.is_null())
+    return false;
+  // Changes of the state are never coalesced.
+  if (download_item_->GetState() != last_state_ ||
+      download_item_->IsPaused() != last_paused_)
+    return false;
+
+  // A download that is not receiving anything is updated when it does.
+  if (download_item_->GetReceivedBytes() - last_received_bytes_ <
+      prefs->download_progress_bytes())
+    return true;
+
+  base::TimeDelta elapsed = base::TimeTicks::Now() - last_updated_time_;
+  if (elapsed >= prefs->download_progress_interval())
+    return false;
+  if (!update_timer_.IsRunning()) {
+    update_timer_.Start(FROM_HERE,
+                        prefs->download_progress_interval() - elapsed, this,
+                        &DownloadItem::EmitUpdated);
+  }
+  return true;
+}
+
+void DownloadItem::EmitUpdated() {
+  if (!download_item_ || download_item_->IsDone())
+    return;
+  update_timer_.Stop();
+  last_state_ = download_item_->GetState();
+  last_paused_ = download_item_->IsPaused();
+  last_received_bytes_ = download_item_->GetReceivedBytes();
+  last_updated_time_ = base::TimeTicks::Now();
+  Emit("updated", last_state_);
+}
+
 void DownloadItem::OnDownloadUpdated(download::DownloadItem* item) {
   if (!CheckAlive())
     return;
   if (download_item_->IsDone()) {
+    update_timer_.Stop();
     Emit("done", item->GetState());
     Unpin();
-  } else {
-    Emit("updated", item->GetState());
+  } else if (!ShouldCoalesceUpdate()) {
+    EmitUpdated();
   }
 }
 
 void DownloadItem::OnDownloadDestroyed(download::DownloadItem* /*item*/) {
+  update_timer_.Stop();
   download_item_ = nullptr;
   Unpin();
 }
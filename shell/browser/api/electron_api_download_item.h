@@ -9,6 +9,8 @@
 
 #include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
 #include "components/download/public/common/download_item.h"
 #include "gin/handle.h"
 #include "gin/wrappable.h"
@@ -51,6 +53,11 @@ class DownloadItem : public gin::Wrappable<DownloadItem>,
 
   bool CheckAlive() const;
 
+  // Returns true when the "updated" event should be coalesced with a later
+  // one, as configured on the session.
+  bool ShouldCoalesceUpdate();
+  void EmitUpdated();
+
   // download::DownloadItem::Observer
   void OnDownloadUpdated(download::DownloadItem* item) override;
   void OnDownloadDestroyed(download::DownloadItem* item) override;
@@ -80,6 +87,15 @@ class DownloadItem : public gin::Wrappable<DownloadItem>,
   file_dialog::DialogSettings dialog_options_;
   download::DownloadItem* download_item_;
 
+  // What the last "updated" event reported.
+  download::DownloadItem::DownloadState last_state_ =
+      download::DownloadItem::IN_PROGRESS;
+  bool last_paused_ = false;
+  int64_t last_received_bytes_ = 0;
+  base::TimeTicks last_updated_time_;
+  // Emits the last coalesced update once the interval has passed.
+  base::OneShotTimer update_timer_;
+
   v8::Isolate* isolate_;
 
   base::WeakPtrFactory<DownloadItem> weak_factory_{this};
@@ -0,0 +1,150 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/electron_api_ipc_main.h"
+
+#include <vector>
+
+#include "gin/converter.h"
+#include "shell/browser/ipc_channel_stats.h"
+#include "shell/common/gin_converters/std_converter.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/microtasks_scope.h"
+#include "shell/common/node_includes.h"
+
+namespace electron::api {
+
+// static
+IpcMainInvokeRegistry* IpcMainInvokeRegistry::GetInstance() {
+  static base::NoDestructor<IpcMainInvokeRegistry> instance;
+  return instance.get();
+}
+
+IpcMainInvokeRegistry::IpcMainInvokeRegistry() = default;
+
+IpcMainInvokeRegistry::~IpcMainInvokeRegistry() = default;
+
+bool IpcMainInvokeRegistry::CanDispatch(const std::string& channel) const {
+  return !dispatcher_.IsEmpty() && handlers_.contains(channel) &&
+         !scoped_handler_counts_.contains(channel);
+}
+
+bool IpcMainInvokeRegistry::Dispatch(v8::Isolate* isolate,
+                                     v8::Local<v8::Object> event,
+                                     const std::string& channel,
+                                     v8::Local<v8::Value> args) {
+  if (!CanDispatch(channel))
+    return false;
+
+  v8::Local<v8::Value> argv[] = {
+      event, gin::StringToV8(isolate, channel),
+      handlers_.find(channel)->second.Get(isolate), args};
+  // Perform microtask checkpoint after running JavaScript.
+  gin_helper::MicrotasksScope microtasks_scope(isolate, true);
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  node::MakeCallback(isolate, context->Global(), dispatcher_.Get(isolate),
+                     node::arraysize(argv), argv, {0, 0});
+  return true;
+}
+
+void IpcMainInvokeRegistry::SetDispatcher(v8::Isolate* isolate,
+                                          v8::Local<v8::Function> dispatcher) {
+  dispatcher_.Reset(isolate, dispatcher);
+}
+
+void IpcMainInvokeRegistry::AddHandler(v8::Isolate* isolate,
+                                       const std::string& channel,
+                                       v8::Local<v8::Function> handler) {
+  handlers_[channel].Reset(isolate, handler);
+}
+
+void IpcMainInvokeRegistry::RemoveHandler(const std::string& channel) {
+  handlers_.erase(channel);
+}
+
+void IpcMainInvokeRegistry::AddScopedHandler(const std::string& channel) {
+  ++scoped_handler_counts_[channel];
+}
+
+void IpcMainInvokeRegistry::RemoveScopedHandler(const std::string& channel) {
+  auto it = scoped_handler_counts_.find(channel);
+  if (it != scoped_handler_counts_.end() && --it->second <= 0)
+    scoped_handler_counts_.erase(it);
+}
+
+}  // namespace electron::api
+
+namespace {
+
+using electron::api::IpcMainInvokeRegistry;
+
+void SetInvokeDispatcher(v8::Isolate* isolate,
+                         v8::Local<v8::Function> dispatcher) {
+  IpcMainInvokeRegistry::GetInstance()->SetDispatcher(isolate, dispatcher);
+}
+
+void AddInvokeHandler(v8::Isolate* isolate,
+                      const std::string& channel,
+                      v8::Local<v8::Function> handler) {
+  IpcMainInvokeRegistry::GetInstance()->AddHandler(isolate, channel, handler);
+}
+
+void RemoveInvokeHandler(const std::string& channel) {
+  IpcMainInvokeRegistry::GetInstance()->RemoveHandler(channel);
+}
+
+void AddScopedInvokeHandler(const std::string& channel) {
+  IpcMainInvokeRegistry::GetInstance()->AddScopedHandler(channel);
+}
+
+void RemoveScopedInvokeHandler(const std::string& channel) {
+  IpcMainInvokeRegistry::GetInstance()->RemoveScopedHandler(channel);
+}
+
+v8::Local<v8::Value> GetChannelStats(v8::Isolate* isolate) {
+  const auto& entries = electron::IpcChannelStats::GetInstance()->entries();
+  std::vector<v8::Local<v8::Value>> stats;
+  stats.reserve(entries.size());
+  for (const auto& [key, entry] : entries) {
+    const bool incoming =
+        key.second == electron::IpcChannelStats::Direction::kIncoming;
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("channel", key.first);
+    dict.Set("direction", incoming ? "incoming" : "outgoing");
+    dict.Set("count", static_cast<double>(entry.count));
+    dict.Set("bytes", static_cast<double>(entry.bytes));
+    dict.Set("serializeTime", entry.serialize_time.InMillisecondsF());
+    if (incoming) {
+      dict.Set("queueingTime", entry.queueing_time.InMillisecondsF());
+      dict.Set("handlerTime", entry.handler_time.InMillisecondsF());
+      std::vector<double> histogram(entry.handler_histogram.begin(),
+                                    entry.handler_histogram.end());
+      dict.Set("handlerTimeHistogram", histogram);
+    }
+    stats.push_back(dict.GetHandle());
+  }
+  return gin::ConvertToV8(isolate, stats);
+}
+
+void ResetChannelStats() {
+  electron::IpcChannelStats::GetInstance()->Reset();
+}
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  gin_helper::Dictionary dict(context->GetIsolate(), exports);
+  dict.SetMethod("setInvokeDispatcher", &SetInvokeDispatcher);
+  dict.SetMethod("addInvokeHandler", &AddInvokeHandler);
+  dict.SetMethod("removeInvokeHandler", &RemoveInvokeHandler);
+  dict.SetMethod("addScopedInvokeHandler", &AddScopedInvokeHandler);
+  dict.SetMethod("removeScopedInvokeHandler", &RemoveScopedInvokeHandler);
+  dict.SetMethod("getChannelStats", &GetChannelStats);
+  dict.SetMethod("resetChannelStats", &ResetChannelStats);
+}
+
+}  // namespace
+
+NODE_LINKED_MODULE_CONTEXT_AWARE(electron_browser_ipc_main, Initialize)
@@ -0,0 +1,66 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_IPC_MAIN_H_
+#define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_IPC_MAIN_H_
+
+#include <string>
+
+#include "base/containers/flat_map.h"
+#include "base/no_destructor.h"
+#include "v8/include/v8.h"
+
+namespace electron::api {
+
+// Native table of the handlers registered with ipcMain.handle().
+//
+// Invoke requests for a channel with a handler in this table are dispatched
+// straight to it from WebContents::Invoke, instead of being emitted as
+// '-ipc-invoke' on the WebContents and looked up by channel in JS.
+//
+// Handlers registered on webContents.ipc or webFrameMain.ipc take precedence
+// over ipcMain, so the table only counts them. A channel with any such handler
+// always takes the regular event path, which resolves the precedence.
+class IpcMainInvokeRegistry {
+ public:
+  static IpcMainInvokeRegistry* GetInstance();
+
+  // disable copy
+  IpcMainInvokeRegistry(const IpcMainInvokeRegistry&) = delete;
+  IpcMainInvokeRegistry& operator=(const IpcMainInvokeRegistry&) = delete;
+
+  // Calls the ipcMain handler for |channel| with |event| and |args|. Returns
+  // false if the request must go through the regular event path instead.
+  bool Dispatch(v8::Isolate* isolate,
+                v8::Local<v8::Object> event,
+                const std::string& channel,
+                v8::Local<v8::Value> args);
+
+  // Whether Dispatch() would handle a request for |channel|.
+  bool CanDispatch(const std::string& channel) const;
+
+  void SetDispatcher(v8::Isolate* isolate, v8::Local<v8::Function> dispatcher);
+  void AddHandler(v8::Isolate* isolate,
+                  const std::string& channel,
+                  v8::Local<v8::Function> handler);
+  void RemoveHandler(const std::string& channel);
+  void AddScopedHandler(const std::string& channel);
+  void RemoveScopedHandler(const std::string& channel);
+
+ private:
+  friend class base::NoDestructor<IpcMainInvokeRegistry>;
+
+  IpcMainInvokeRegistry();
+  ~IpcMainInvokeRegistry();
+
+  // JS function which prepares the event and calls the handler, invoked as
+  // dispatcher(event, channel, handler, args).
+  v8::Global<v8::Function> dispatcher_;
+  base::flat_map<std::string, v8::Global<v8::Function>> handlers_;
+  base::flat_map<std::string, int> scoped_handler_counts_;
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_ELECTRON_API_IPC_MAIN_H_
@@ -83,18 +83,27 @@ bool InvokeBoolMethod(const Menu* menu,
 }
 
 bool Menu::IsCommandIdChecked(int command_id) const {
+  const auto* state = model_->GetCommandState(command_id);
+  if (state && !state->dynamic_checked)
+    return state->checked;
   return InvokeBoolMethod(this, "_isCommandIdChecked", command_id);
 }
 
 bool Menu::IsCommandIdEnabled(int command_id) const {
+  if (const auto* state = model_->GetCommandState(command_id))
+    return state->enabled;
   return InvokeBoolMethod(this, "_isCommandIdEnabled", command_id);
 }
 
 bool Menu::IsCommandIdVisible(int command_id) const {
+  if (const auto* state = model_->GetCommandState(command_id))
+    return state->visible;
   return InvokeBoolMethod(this, "_isCommandIdVisible", command_id);
 }
 
 bool Menu::ShouldCommandIdWorkWhenHidden(int command_id) const {
+  if (const auto* state = model_->GetCommandState(command_id))
+    return state->works_when_hidden;
   return InvokeBoolMethod(this, "_shouldCommandIdWorkWhenHidden", command_id);
 }
 
@@ -102,6 +111,18 @@ bool Menu::GetAcceleratorForCommandIdWithParams(
     int command_id,
     bool use_default_accelerator,
     ui::Accelerator* accelerator) const {
+  if (const auto* state = model_->GetCommandState(command_id)) {
+    if (state->accelerator) {
+      *accelerator = *state->accelerator;
+      return true;
+    }
+    if (use_default_accelerator && state->default_accelerator) {
+      *accelerator = *state->default_accelerator;
+      return true;
+    }
+    return false;
+  }
+
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope scope(isolate);
   v8::Local<v8::Value> val = gin_helper::CallMethod(
@@ -111,6 +132,8 @@ bool Menu::GetAcceleratorForCommandIdWithParams(
 }
 
 bool Menu::ShouldRegisterAcceleratorForCommandId(int command_id) const {
+  if (const auto* state = model_->GetCommandState(command_id))
+    return state->register_accelerator;
   return InvokeBoolMethod(this, "_shouldRegisterAcceleratorForCommandId",
                           command_id);
 }
@@ -205,8 +228,32 @@ void Menu::SetRole(int index, const std::u16string& role) {
   model_->SetRole(index, role);
 }
 
+void Menu::SetCommandStates(
+    const std::vector<gin_helper::Dictionary>& states) {
+  for (const auto& dict : states) {
+    int command_id;
+    if (!dict.Get("commandId", &command_id))
+      continue;
+    ElectronMenuModel::CommandState state;
+    dict.Get("checked", &state.checked);
+    dict.Get("dynamicChecked", &state.dynamic_checked);
+    dict.Get("enabled", &state.enabled);
+    dict.Get("visible", &state.visible);
+    dict.Get("acceleratorWorksWhenHidden", &state.works_when_hidden);
+    dict.Get("registerAccelerator", &state.register_accelerator);
+    // Invalid accelerators are treated like missing ones.
+    ui::Accelerator accelerator;
+    if (dict.Get("accelerator", &accelerator))
+      state.accelerator = accelerator;
+    if (dict.Get("defaultAccelerator", &accelerator))
+      state.default_accelerator = accelerator;
+    model_->SetCommandState(command_id, std::move(state));
+  }
+}
+
 void Menu::Clear() {
   model_->Clear();
+  model_->ClearCommandStates();
 }
 
 int Menu::GetIndexOfCommandId(int command_id) const {
@@ -280,6 +327,7 @@ v8::Local<v8::ObjectTemplate> Menu::FillObjectTemplate(
       .SetMethod("setToolTip", &Menu::SetToolTip)
       .SetMethod("setRole", &Menu::SetRole)
       .SetMethod("clear", &Menu::Clear)
+      .SetMethod("_setCommandStates", &Menu::SetCommandStates)
       .SetMethod("getIndexOfCommandId", &Menu::GetIndexOfCommandId)
       .SetMethod("getItemCount", &Menu::GetItemCount)
       .SetMethod("getCommandIdAt", &Menu::GetCommandIdAt)
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/callback.h"
 #include "gin/arguments.h"
@@ -14,6 +15,7 @@
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/browser/ui/electron_menu_model.h"
 #include "shell/common/gin_helper/constructible.h"
+#include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/pinnable.h"
 
 namespace electron::api {
@@ -108,6 +110,8 @@ class Menu : public gin::Wrappable<Menu>,
   void SetSublabel(int index, const std::u16string& sublabel);
   void SetToolTip(int index, const std::u16string& toolTip);
   void SetRole(int index, const std::u16string& role);
+  // Caches the state of menu items, see ElectronMenuModel::CommandState.
+  void SetCommandStates(const std::vector<gin_helper::Dictionary>& states);
   void Clear();
   int GetIndexOfCommandId(int command_id) const;
   int GetItemCount() const;
@@ -0,0 +1,283 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/electron_api_page_capture.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_util.h"
+#include "base/task/thread_pool.h"
+#include "build/build_config.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_widget_host_view.h"
+#include "content/public/browser/web_contents.h"
+#include "gin/arguments.h"
+#include "gin/object_template_builder.h"
+#include "shell/common/gin_converters/file_path_converter.h"
+#include "shell/common/gin_converters/gfx_converter.h"
+#include "shell/common/gin_helper/locker.h"
+#include "shell/common/gin_helper/promise.h"
+#include "shell/common/node_includes.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "third_party/blink/public/mojom/page/page_visibility_state.mojom.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/display/screen.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/codec/webp_codec.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+namespace electron::api {
+
+namespace {
+
+enum class ImageFormat { kPng, kJpeg, kWebp };
+
+absl::optional<ImageFormat> ParseImageFormat(const std::string& format) {
+  if (format == "png")
+    return ImageFormat::kPng;
+  if (format == "jpeg")
+    return ImageFormat::kJpeg;
+  if (format == "webp")
+    return ImageFormat::kWebp;
+  return absl::nullopt;
+}
+
+}  // namespace
+
+// The stitched image, created on the first tile.
+class PageCapture::Canvas {
+ public:
+  explicit Canvas(const gfx::Size& size) : size_(size) {}
+
+  // disable copy
+  Canvas(const Canvas&) = delete;
+  Canvas& operator=(const Canvas&) = delete;
+
+  void DrawTile(const SkBitmap& tile, const gfx::Point& offset) {
+    if (!Allocate())
+      return;
+    // Parts of the tile outside of the image are clipped.
+    bitmap_.writePixels(tile.pixmap(), offset.x(), offset.y());
+  }
+
+  absl::optional<std::vector<unsigned char>> Encode(ImageFormat format,
+                                                    int quality) {
+    if (!Allocate())
+      return absl::nullopt;
+    std::vector<unsigned char> data;
+    bool success = false;
+    switch (format) {
+      case ImageFormat::kPng:
+        success = gfx::PNGCodec::EncodeBGRASkBitmap(
+            bitmap_, false /* discard_transparency */, &data);
+        break;
+      case ImageFormat::kJpeg:
+        success = gfx::JPEGCodec::Encode(bitmap_, quality, &data);
+        break;
+      case ImageFormat::kWebp:
+        success = gfx::WebpCodec::Encode(bitmap_, quality, &data);
+        break;
+    }
+    if (!success)
+      return absl::nullopt;
+    return data;
+  }
+
+  bool EncodeToFile(ImageFormat format,
+                    int quality,
+                    const base::FilePath& path) {
+    auto data = Encode(format, quality);
+    return data && base::WriteFile(path, *data);
+  }
+
+ private:
+  bool Allocate() {
+    if (!bitmap_.isNull())
+      return true;
+    if (allocation_failed_ || size_.IsEmpty())
+      return false;
+    allocation_failed_ =
+        !bitmap_.tryAllocN32Pixels(size_.width(), size_.height());
+    if (allocation_failed_)
+      return false;
+    bitmap_.eraseColor(SK_ColorTRANSPARENT);
+    return true;
+  }
+
+  gfx::Size size_;
+  SkBitmap bitmap_;
+  bool allocation_failed_ = false;
+};
+
+gin::WrapperInfo PageCapture::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+PageCapture::PageCapture(content::WebContents* web_contents,
+                         const gfx::Size& page_size,
+                         float scale_factor)
+    : content::WebContentsObserver(web_contents),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      canvas_(std::make_unique<Canvas>(
+          gfx::ScaleToCeiledSize(page_size, scale_factor))),
+      scale_factor_(scale_factor) {}
+
+PageCapture::~PageCapture() {
+  task_runner_->DeleteSoon(FROM_HERE, std::move(canvas_));
+}
+
+// static
+gin::Handle<PageCapture> PageCapture::Create(
+    v8::Isolate* isolate,
+    content::WebContents* web_contents,
+    const gfx::Size& page_size) {
+  gfx::Size size = page_size;
+  float scale_factor = 1.0f;
+  if (auto* view = web_contents->GetRenderWidgetHostView()) {
+    if (size.IsEmpty())
+      size = view->GetViewBounds().size();
+    // Capture all the pixel detail available on the current display, like
+    // webContents.capturePage() does.
+    scale_factor =
+        std::max(1.0f, display::Screen::GetScreen()
+                           ->GetDisplayNearestView(view->GetNativeView())
+                           .device_scale_factor());
+  }
+  return gin::CreateHandle(isolate,
+                           new PageCapture(web_contents, size, scale_factor));
+}
+
+v8::Local<v8::Promise> PageCapture::CaptureTile(v8::Isolate* isolate,
+                                                const gfx::Rect& view_rect,
+                                                const gfx::Point& offset) {
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* view =
+      web_contents() ? web_contents()->GetRenderWidgetHostView() : nullptr;
+  if (!view) {
+    promise.RejectWithErrorMessage("The page has no view to capture");
+    return handle;
+  }
+
+#if !BUILDFLAG(IS_MAC)
+  // See WebContents::CapturePage.
+  auto* rfh = web_contents()->GetPrimaryMainFrame();
+  if (rfh &&
+      rfh->GetVisibilityState() == blink::mojom::PageVisibilityState::kHidden) {
+    promise.RejectWithErrorMessage("The page is hidden");
+    return handle;
+  }
+#endif  // BUILDFLAG(IS_MAC)
+
+  gfx::Rect rect = view_rect;
+  if (rect.IsEmpty())
+    rect = gfx::Rect(view->GetViewBounds().size());
+  view->CopyFromSurface(
+      rect, gfx::ScaleToCeiledSize(rect.size(), scale_factor_),
+      base::BindOnce(&PageCapture::OnTileCaptured, weak_factory_.GetWeakPtr(),
+                     std::move(promise),
+                     gfx::ScaleToFlooredPoint(offset, scale_factor_)));
+  return handle;
+}
+
+void PageCapture::OnTileCaptured(gin_helper::Promise<void> promise,
+                                 const gfx::Point& offset,
+                                 const SkBitmap& bitmap) {
+  if (bitmap.drawsNothing()) {
+    promise.RejectWithErrorMessage("Failed to capture the page");
+    return;
+  }
+  task_runner_->PostTask(FROM_HERE,
+                         base::BindOnce(&Canvas::DrawTile,
+                                        base::Unretained(canvas_.get()),
+                                        bitmap, offset));
+  promise.Resolve();
+}
+
+v8::Local<v8::Promise> PageCapture::Encode(gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  std::string format_name;
+  int quality = 90;
+  base::FilePath path;
+  args->GetNext(&format_name);
+  args->GetNext(&quality);
+  args->GetNext(&path);
+
+  auto format = ParseImageFormat(format_name);
+  if (!format) {
+    promise.RejectWithErrorMessage("Unsupported image format: " + format_name);
+    return handle;
+  }
+
+  // The canvas is only deleted after this task, since it is deleted on the
+  // same sequence from the destructor.
+  if (!path.empty()) {
+    task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(&Canvas::EncodeToFile, base::Unretained(canvas_.get()),
+                       *format, quality, path),
+        base::BindOnce(
+            [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+               const base::FilePath& path, bool success) {
+              if (!success) {
+                promise.RejectWithErrorMessage("Failed to write image to " +
+                                               path.AsUTF8Unsafe());
+                return;
+              }
+              v8::Isolate* isolate = promise.isolate();
+              gin_helper::Locker locker(isolate);
+              v8::HandleScope handle_scope(isolate);
+              v8::Context::Scope context_scope(
+                  v8::Local<v8::Context>::New(isolate, promise.GetContext()));
+              promise.Resolve(gin::ConvertToV8(isolate, path));
+            },
+            std::move(promise), path));
+    return handle;
+  }
+
+  task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&Canvas::Encode, base::Unretained(canvas_.get()), *format,
+                     quality),
+      base::BindOnce(
+          [](gin_helper::Promise<v8::Local<v8::Value>> promise,
+             absl::optional<std::vector<unsigned char>> data) {
+            if (!data) {
+              promise.RejectWithErrorMessage("Failed to encode the image");
+              return;
+            }
+            v8::Isolate* isolate = promise.isolate();
+            gin_helper::Locker locker(isolate);
+            v8::HandleScope handle_scope(isolate);
+            v8::Context::Scope context_scope(
+                v8::Local<v8::Context>::New(isolate, promise.GetContext()));
+            promise.Resolve(
+                node::Buffer::Copy(isolate,
+                                   reinterpret_cast<const char*>(data->data()),
+                                   data->size())
+                    .ToLocalChecked());
+          },
+          std::move(promise)));
+  return handle;
+}
+
+gin::ObjectTemplateBuilder PageCapture::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<PageCapture>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("captureTile", &PageCapture::CaptureTile)
+      .SetMethod("encode", &PageCapture::Encode);
+}
+
+const char* PageCapture::GetTypeName() {
+  return "PageCapture";
+}
+
+}  // namespace electron::api
@@ -0,0 +1,85 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_ELECTRON_API_PAGE_CAPTURE_H_
+#define ELECTRON_SHELL_BROWSER_API_ELECTRON_API_PAGE_CAPTURE_H_
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "gin/handle.h"
+#include "gin/wrappable.h"
+#include "ui/gfx/geometry/point.h"
+#include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/size.h"
+
+class SkBitmap;
+
+namespace gin_helper {
+template <typename T>
+class Promise;
+}
+
+namespace electron::api {
+
+// Captures a page in tiles and stitches them into one image, which is then
+// encoded without ever being turned into a NativeImage. The tiles are
+// stitched and encoded on a worker sequence.
+class PageCapture : public gin::Wrappable<PageCapture>,
+                    public content::WebContentsObserver {
+ public:
+  static gin::WrapperInfo kWrapperInfo;
+
+  // |page_size| is the size of the whole image in DIPs, the view's size is
+  // used when it is empty.
+  static gin::Handle<PageCapture> Create(v8::Isolate* isolate,
+                                         content::WebContents* web_contents,
+                                         const gfx::Size& page_size);
+
+  // gin::Wrappable
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+  // disable copy
+  PageCapture(const PageCapture&) = delete;
+  PageCapture& operator=(const PageCapture&) = delete;
+
+ private:
+  class Canvas;
+
+  PageCapture(content::WebContents* web_contents,
+              const gfx::Size& page_size,
+              float scale_factor);
+  ~PageCapture() override;
+
+  // Copies |view_rect| of the view (the whole view if empty) into the image
+  // at |offset|, both in DIPs.
+  v8::Local<v8::Promise> CaptureTile(v8::Isolate* isolate,
+                                     const gfx::Rect& view_rect,
+                                     const gfx::Point& offset);
+  void OnTileCaptured(gin_helper::Promise<void> promise,
+                      const gfx::Point& offset,
+                      const SkBitmap& bitmap);
+
+  // Encodes the image as "png", "jpeg" or "webp" and resolves with a Buffer,
+  // or writes it to |path| when one is given.
+  v8::Local<v8::Promise> Encode(gin::Arguments* args);
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  // Only accessed on |task_runner_|.
+  std::unique_ptr<Canvas> canvas_;
+  float scale_factor_;
+
+  base::WeakPtrFactory<PageCapture> weak_factory_{this};
+};
+
+}  // namespace electron::api
+
+#endif  // ELECTRON_SHELL_BROWSER_API_ELECTRON_API_PAGE_CAPTURE_H_
@@ -13,10 +13,12 @@
 
 #include "base/command_line.h"
 #include "base/files/file_path.h"
+#include "base/files/file_util.h"
 #include "base/guid.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/task/thread_pool.h"
 #include "chrome/browser/browser_process.h"
 #include "chrome/common/chrome_switches.h"
 #include "chrome/common/pref_names.h"
@@ -55,6 +57,7 @@
 #include "shell/browser/api/electron_api_service_worker_context.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
 #include "shell/browser/api/electron_api_web_request.h"
+#include "shell/browser/batched_storage_clearer.h"
 #include "shell/browser/browser.h"
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/electron_browser_main_parts.h"
@@ -63,6 +66,7 @@
 #include "shell/browser/media/media_device_id_salt.h"
 #include "shell/browser/net/cert_verifier_client.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/content_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
@@ -108,6 +112,17 @@ struct ClearStorageDataOptions {
   uint32_t quota_types = StoragePartition::QUOTA_MANAGED_STORAGE_MASK_ALL;
 };
 
+// The storages that clearStorageDataInBatches() clears by default.
+constexpr uint32_t kBatchedStorageMask =
+    StoragePartition::REMOVE_DATA_MASK_COOKIES |
+    StoragePartition::REMOVE_DATA_MASK_FILE_SYSTEMS |
+    StoragePartition::REMOVE_DATA_MASK_INDEXEDDB |
+    StoragePartition::REMOVE_DATA_MASK_LOCAL_STORAGE |
+    StoragePartition::REMOVE_DATA_MASK_SHADER_CACHE |
+    StoragePartition::REMOVE_DATA_MASK_WEBSQL |
+    StoragePartition::REMOVE_DATA_MASK_SERVICE_WORKERS |
+    StoragePartition::REMOVE_DATA_MASK_CACHE_STORAGE;
+
 uint32_t GetStorageMask(const std::vector<std::string>& storage_types) {
   uint32_t storage_mask = 0;
   for (const auto& it : storage_types) {
@@ -170,6 +185,51 @@ base::Value::Dict createProxyConfig(ProxyPrefs::ProxyMode proxy_mode,
   return ProxyConfigDictionary::CreateFixedServers(proxy_server, bypass_list);
 }
 
+void OnCodeCacheSizeComputed(
+    gin_helper::Promise<gin_helper::Dictionary> promise,
+    int64_t http_cache_size,
+    uint64_t hits,
+    uint64_t misses,
+    int64_t code_cache_size) {
+  v8::Isolate* isolate = promise.isolate();
+  v8::HandleScope handle_scope(isolate);
+  gin_helper::Dictionary http_cache = gin::Dictionary::CreateEmpty(isolate);
+  http_cache.Set("size", http_cache_size);
+  http_cache.Set("hits", hits);
+  http_cache.Set("misses", misses);
+  uint64_t loads = hits + misses;
+  http_cache.Set("hitRate", loads ? static_cast<double>(hits) / loads : 0.0);
+  gin_helper::Dictionary code_cache = gin::Dictionary::CreateEmpty(isolate);
+  code_cache.Set("size", code_cache_size);
+  gin_helper::Dictionary stats = gin::Dictionary::CreateEmpty(isolate);
+  stats.Set("httpCache", http_cache);
+  stats.Set("codeCache", code_cache);
+  promise.Resolve(stats);
+}
+
+void OnHttpCacheSizeComputed(
+    gin_helper::Promise<gin_helper::Dictionary> promise,
+    uint64_t hits,
+    uint64_t misses,
+    base::FilePath code_cache_path,
+    bool is_upper_bound,
+    int64_t size_or_error) {
+  if (size_or_error < 0) {
+    promise.RejectWithErrorMessage(net::ErrorToString(size_or_error));
+    return;
+  }
+  if (code_cache_path.empty()) {
+    OnCodeCacheSizeComputed(std::move(promise), size_or_error, hits, misses,
+                            0);
+    return;
+  }
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&base::ComputeDirectorySize, code_cache_path),
+      base::BindOnce(&OnCodeCacheSizeComputed, std::move(promise),
+                     size_or_error, hits, misses));
+}
+
 }  // namespace
 
 namespace gin {
@@ -330,6 +390,20 @@ struct UserDataLink : base::SupportsUserData::Data {
 
 const void* kElectronApiSessionKey = &kElectronApiSessionKey;
 
+#if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
+int GetExtensionLoadFlags(gin::Arguments* args) {
+  int load_flags = extensions::Extension::FOLLOW_SYMLINKS_ANYWHERE;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    bool allowFileAccess = false;
+    options.Get("allowFileAccess", &allowFileAccess);
+    if (allowFileAccess)
+      load_flags |= extensions::Extension::ALLOW_FILE_ACCESS;
+  }
+  return load_flags;
+}
+#endif
+
 }  // namespace
 
 gin::WrapperInfo Session::kWrapperInfo = {gin::kEmbedderNativeGin};
@@ -448,6 +522,28 @@ v8::Local<v8::Promise> Session::GetCacheSize() {
   return handle;
 }
 
+v8::Local<v8::Promise> Session::GetCacheStats() {
+  gin_helper::Promise<gin_helper::Dictionary> promise(isolate_);
+  auto handle = promise.GetHandle();
+
+  // The code cache only exists on disk for persistent sessions.
+  base::FilePath code_cache_path;
+  if (!browser_context_->IsOffTheRecord() &&
+      !browser_context_->IsCodeCacheInMemory())
+    code_cache_path = browser_context_->GetCodeCachePath();
+
+  browser_context_->GetDefaultStoragePartition()
+      ->GetNetworkContext()
+      ->ComputeHttpCacheSize(
+          base::Time(), base::Time::Max(),
+          base::BindOnce(&OnHttpCacheSizeComputed, std::move(promise),
+                         browser_context_->http_cache_hits(),
+                         browser_context_->http_cache_misses(),
+                         std::move(code_cache_path)));
+
+  return handle;
+}
+
 v8::Local<v8::Promise> Session::ClearCache() {
   gin_helper::Promise<void> promise(isolate_);
   auto handle = promise.GetHandle();
@@ -484,6 +580,80 @@ v8::Local<v8::Promise> Session::ClearStorageData(gin::Arguments* args) {
   return handle;
 }
 
+v8::Local<v8::Promise> Session::ClearStorageDataInBatches(
+    gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  gin_helper::Promise<gin_helper::Dictionary> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  gin_helper::Dictionary options;
+  args->GetNext(&options);
+
+  BatchedStorageClearer::Options clear_options;
+  clear_options.storage_mask = kBatchedStorageMask;
+  clear_options.quota_mask = StoragePartition::QUOTA_MANAGED_STORAGE_MASK_ALL;
+  std::vector<std::string> origins, types;
+  options.Get("origins", &origins);
+  for (const std::string& origin : origins) {
+    url::Origin storage_origin = url::Origin::Create(GURL(origin));
+    if (storage_origin.opaque()) {
+      promise.RejectWithErrorMessage("Invalid origin: " + origin);
+      return handle;
+    }
+    clear_options.origins.push_back(storage_origin);
+  }
+  if (options.Get("storages", &types))
+    clear_options.storage_mask = GetStorageMask(types);
+  if (options.Get("quotas", &types))
+    clear_options.quota_mask = GetQuotaMask(types);
+  options.Get("idle", &clear_options.idle);
+  base::RepeatingCallback<void(v8::Local<v8::Value>)> on_progress;
+  options.Get("onProgress", &on_progress);
+
+  if (clear_options.storage_mask & StoragePartition::REMOVE_DATA_MASK_COOKIES) {
+    // Reset media device id salt when cookies are cleared.
+    // https://w3c.github.io/mediacapture-main/#dom-mediadeviceinfo-deviceid
+    MediaDeviceIDSalt::Reset(browser_context()->prefs());
+  }
+
+  BatchedStorageClearer::ProgressCallback progress_callback;
+  if (on_progress) {
+    progress_callback = base::BindRepeating(
+        [](v8::Isolate* isolate,
+           base::RepeatingCallback<void(v8::Local<v8::Value>)> on_progress,
+           size_t completed, size_t total) {
+          v8::HandleScope handle_scope(isolate);
+          gin_helper::Dictionary details =
+              gin::Dictionary::CreateEmpty(isolate);
+          details.Set("completed", static_cast<uint64_t>(completed));
+          details.Set("total", static_cast<uint64_t>(total));
+          on_progress.Run(details.GetHandle());
+        },
+        isolate, std::move(on_progress));
+  }
+
+  BatchedStorageClearer::Start(
+      browser_context(), std::move(clear_options),
+      std::move(progress_callback),
+      base::BindOnce(
+          [](gin_helper::Promise<gin_helper::Dictionary> promise,
+             absl::optional<int64_t> bytes_freed) {
+            if (!bytes_freed) {
+              promise.RejectWithErrorMessage(
+                  "The session was destroyed before the storage data was "
+                  "cleared");
+              return;
+            }
+            v8::HandleScope handle_scope(promise.isolate());
+            gin_helper::Dictionary result =
+                gin::Dictionary::CreateEmpty(promise.isolate());
+            result.Set("bytesFreed", *bytes_freed);
+            promise.Resolve(result);
+          },
+          std::move(promise)));
+  return handle;
+}
+
 void Session::FlushStorageData() {
   auto* storage_partition = browser_context()->GetStoragePartition(nullptr);
   storage_partition->Flush();
@@ -794,6 +964,22 @@ void Session::CreateInterruptedDownload(const gin_helper::Dictionary& options) {
       length, last_modified, etag, base::Time::FromDoubleT(start_time)));
 }
 
+void Session::SetDownloadProgressOptions(
+    const gin_helper::Dictionary& options) {
+  int64_t min_interval = 0, min_bytes = 0;
+  options.Get("minInterval", &min_interval);
+  options.Get("minBytes", &min_bytes);
+  if (min_interval < 0 || min_bytes < 0) {
+    isolate_->ThrowException(v8::Exception::Error(gin::StringToV8(
+        isolate_, "minInterval and minBytes must not be negative.")));
+    return;
+  }
+  auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
+  DCHECK(prefs);
+  prefs->set_download_progress_interval(base::Milliseconds(min_interval));
+  prefs->set_download_progress_bytes(min_bytes);
+}
+
 void Session::SetPreloads(const std::vector<base::FilePath>& preloads) {
   auto* prefs = SessionPreferences::FromBrowserContext(browser_context());
   DCHECK(prefs);
@@ -806,6 +992,28 @@ std::vector<base::FilePath> Session::GetPreloads() const {
   return prefs->preloads();
 }
 
+void Session::SetSpareRendererEnabled(bool enabled) {
+  auto* pool = SpareRendererPool::FromBrowserContext(browser_context());
+  if (!pool) {
+    if (!enabled)
+      return;
+    // Owned by the browser context.
+    pool = new SpareRendererPool(browser_context());
+  }
+  pool->SetEnabled(enabled);
+}
+
+v8::Local<v8::Value> Session::GetSpareRendererStats(v8::Isolate* isolate) {
+  SpareRendererPool::Stats stats;
+  if (auto* pool = SpareRendererPool::FromBrowserContext(browser_context()))
+    stats = pool->stats();
+  gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+  dict.Set("hits", stats.hits);
+  dict.Set("misses", stats.misses);
+  dict.Set("launched", stats.launched);
+  return dict.GetHandle();
+}
+
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
 v8::Local<v8::Promise> Session::LoadExtension(
     const base::FilePath& extension_path,
@@ -825,15 +1033,7 @@ v8::Local<v8::Promise> Session::LoadExtension(
     return handle;
   }
 
-  int load_flags = extensions::Extension::FOLLOW_SYMLINKS_ANYWHERE;
-  gin_helper::Dictionary options;
-  if (args->GetNext(&options)) {
-    bool allowFileAccess = false;
-    options.Get("allowFileAccess", &allowFileAccess);
-    if (allowFileAccess)
-      load_flags |= extensions::Extension::ALLOW_FILE_ACCESS;
-  }
-
+  int load_flags = GetExtensionLoadFlags(args);
   auto* extension_system = static_cast<extensions::ElectronExtensionSystem*>(
       extensions::ExtensionSystem::Get(browser_context()));
   extension_system->LoadExtension(
@@ -858,6 +1058,60 @@ v8::Local<v8::Promise> Session::LoadExtension(
   return handle;
 }
 
+v8::Local<v8::Promise> Session::LoadExtensions(
+    const std::vector<base::FilePath>& extension_paths,
+    gin::Arguments* args) {
+  gin_helper::Promise<std::vector<const extensions::Extension*>> promise(
+      isolate_);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  for (const auto& extension_path : extension_paths) {
+    if (!extension_path.IsAbsolute()) {
+      promise.RejectWithErrorMessage(
+          "The paths to the extensions in 'loadExtensions' must be absolute");
+      return handle;
+    }
+  }
+  std::set<base::FilePath> unique_paths(extension_paths.begin(),
+                                        extension_paths.end());
+  if (unique_paths.size() != extension_paths.size()) {
+    promise.RejectWithErrorMessage(
+        "The paths to the extensions in 'loadExtensions' must be unique");
+    return handle;
+  }
+
+  if (browser_context()->IsOffTheRecord()) {
+    promise.RejectWithErrorMessage(
+        "Extensions cannot be loaded in a temporary session");
+    return handle;
+  }
+
+  int load_flags = GetExtensionLoadFlags(args);
+  auto* extension_system = static_cast<extensions::ElectronExtensionSystem*>(
+      extensions::ExtensionSystem::Get(browser_context()));
+  extension_system->LoadExtensions(
+      extension_paths, load_flags,
+      base::BindOnce(
+          [](gin_helper::Promise<std::vector<const extensions::Extension*>>
+                 promise,
+             const std::vector<const extensions::Extension*>& extensions,
+             const std::string& warnings, const std::string& error) {
+            if (!error.empty()) {
+              promise.RejectWithErrorMessage(error);
+              return;
+            }
+            if (!warnings.empty()) {
+              node::Environment* env =
+                  node::Environment::GetCurrent(promise.isolate());
+              EmitWarning(env, warnings, "ExtensionLoadWarning");
+            }
+            promise.Resolve(extensions);
+          },
+          std::move(promise)));
+
+  return handle;
+}
+
 void Session::RemoveExtension(const std::string& extension_id) {
   auto* extension_system = static_cast<extensions::ElectronExtensionSystem*>(
       extensions::ExtensionSystem::Get(browser_context()));
@@ -1009,8 +1263,10 @@ void Session::SetCodeCachePath(gin::Arguments* args) {
           "Absolute path must be provided to store code cache.");
       return;
     }
-    code_cache_context->Initialize(
-        code_cache_path, 0 /* allows disk_cache to choose the size */);
+    browser_context_->set_code_cache_path(code_cache_path);
+    // A size of 0 allows disk_cache to choose the size.
+    code_cache_context->Initialize(code_cache_path,
+                                   browser_context_->GetMaxCodeCacheSize());
   }
 }
 
@@ -1213,8 +1469,11 @@ gin::ObjectTemplateBuilder Session::GetObjectTemplateBuilder(
              isolate)
       .SetMethod("resolveProxy", &Session::ResolveProxy)
       .SetMethod("getCacheSize", &Session::GetCacheSize)
+      .SetMethod("getCacheStats", &Session::GetCacheStats)
       .SetMethod("clearCache", &Session::ClearCache)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
+      .SetMethod("clearStorageDataInBatches",
+                 &Session::ClearStorageDataInBatches)
       .SetMethod("flushStorageData", &Session::FlushStorageData)
       .SetMethod("setProxy", &Session::SetProxy)
       .SetMethod("forceReloadProxyConfig", &Session::ForceReloadProxyConfig)
@@ -1244,10 +1503,15 @@ gin::ObjectTemplateBuilder Session::GetObjectTemplateBuilder(
       .SetMethod("downloadURL", &Session::DownloadURL)
       .SetMethod("createInterruptedDownload",
                  &Session::CreateInterruptedDownload)
+      .SetMethod("setDownloadProgressOptions",
+                 &Session::SetDownloadProgressOptions)
       .SetMethod("setPreloads", &Session::SetPreloads)
       .SetMethod("getPreloads", &Session::GetPreloads)
+      .SetMethod("setSpareRendererEnabled", &Session::SetSpareRendererEnabled)
+      .SetMethod("getSpareRendererStats", &Session::GetSpareRendererStats)
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
       .SetMethod("loadExtension", &Session::LoadExtension)
+      .SetMethod("loadExtensions", &Session::LoadExtensions)
       .SetMethod("removeExtension", &Session::RemoveExtension)
       .SetMethod("getExtension", &Session::GetExtension)
       .SetMethod("getAllExtensions", &Session::GetAllExtensions)
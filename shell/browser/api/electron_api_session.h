@@ -90,8 +90,10 @@ class Session : public gin::Wrappable<Session>,
   // Methods.
   v8::Local<v8::Promise> ResolveProxy(gin::Arguments* args);
   v8::Local<v8::Promise> GetCacheSize();
+  v8::Local<v8::Promise> GetCacheStats();
   v8::Local<v8::Promise> ClearCache();
   v8::Local<v8::Promise> ClearStorageData(gin::Arguments* args);
+  v8::Local<v8::Promise> ClearStorageDataInBatches(gin::Arguments* args);
   void FlushStorageData();
   v8::Local<v8::Promise> SetProxy(gin::Arguments* args);
   v8::Local<v8::Promise> ForceReloadProxyConfig();
@@ -118,8 +120,11 @@ class Session : public gin::Wrappable<Session>,
                                      const std::string& uuid);
   void DownloadURL(const GURL& url);
   void CreateInterruptedDownload(const gin_helper::Dictionary& options);
+  void SetDownloadProgressOptions(const gin_helper::Dictionary& options);
   void SetPreloads(const std::vector<base::FilePath>& preloads);
   std::vector<base::FilePath> GetPreloads() const;
+  void SetSpareRendererEnabled(bool enabled);
+  v8::Local<v8::Value> GetSpareRendererStats(v8::Isolate* isolate);
   v8::Local<v8::Value> Cookies(v8::Isolate* isolate);
   v8::Local<v8::Value> Protocol(v8::Isolate* isolate);
   v8::Local<v8::Value> ServiceWorkerContext(v8::Isolate* isolate);
@@ -144,6 +149,9 @@ class Session : public gin::Wrappable<Session>,
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   v8::Local<v8::Promise> LoadExtension(const base::FilePath& extension_path,
                                        gin::Arguments* args);
+  v8::Local<v8::Promise> LoadExtensions(
+      const std::vector<base::FilePath>& extension_paths,
+      gin::Arguments* args);
   void RemoveExtension(const std::string& extension_id);
   v8::Local<v8::Value> GetExtension(const std::string& extension_id);
   v8::Local<v8::Value> GetAllExtensions();
@@ -10,7 +10,10 @@
 #include <utility>
 #include <vector>
 
+#include "base/files/file.h"
+#include "base/files/file_path.h"
 #include "base/no_destructor.h"
+#include "base/task/thread_pool.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
@@ -27,6 +30,7 @@
 #include "shell/browser/electron_browser_context.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/callback_converter.h"
+#include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_converters/gurl_converter.h"
 #include "shell/common/gin_converters/net_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
@@ -76,10 +80,14 @@ namespace {
 
 class BufferDataSource : public mojo::DataPipeProducer::DataSource {
  public:
-  explicit BufferDataSource(base::span<char> buffer) {
-    buffer_.resize(buffer.size());
-    memcpy(buffer_.data(), buffer.data(), buffer_.size());
-  }
+  // Keeps |backing_store| alive instead of copying the chunk, the JS side must
+  // not modify the buffer until the write has completed.
+  BufferDataSource(std::shared_ptr<v8::BackingStore> backing_store,
+                   size_t offset,
+                   size_t length)
+      : backing_store_(std::move(backing_store)),
+        buffer_(static_cast<const char*>(backing_store_->Data()) + offset,
+                length) {}
   ~BufferDataSource() override = default;
 
  private:
@@ -102,7 +110,8 @@ class BufferDataSource : public mojo::DataPipeProducer::DataSource {
     return result;
   }
 
-  std::vector<char> buffer_;
+  std::shared_ptr<v8::BackingStore> backing_store_;
+  base::span<const char> buffer_;
 };
 
 class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
@@ -186,11 +195,9 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
     auto buffer = buffer_val.As<v8::ArrayBufferView>();
     is_writing_ = true;
     bytes_written_ += buffer->ByteLength();
-    auto backing_store = buffer->Buffer()->GetBackingStore();
-    auto buffer_span = base::make_span(
-        static_cast<char*>(backing_store->Data()) + buffer->ByteOffset(),
+    auto buffer_source = std::make_unique<BufferDataSource>(
+        buffer->Buffer()->GetBackingStore(), buffer->ByteOffset(),
         buffer->ByteLength());
-    auto buffer_source = std::make_unique<BufferDataSource>(buffer_span);
     data_producer_->Write(
         std::move(buffer_source),
         base::BindOnce(&JSChunkedDataPipeGetter::OnWriteChunkComplete,
@@ -242,6 +249,26 @@ class JSChunkedDataPipeGetter : public gin::Wrappable<JSChunkedDataPipeGetter>,
 gin::WrapperInfo JSChunkedDataPipeGetter::kWrapperInfo = {
     gin::kEmbedderNativeGin};
 
+void OpenFile(base::File* file, const base::FilePath& path) {
+  file->Initialize(path, base::File::FLAG_CREATE_ALWAYS |
+                             base::File::FLAG_WRITE);
+}
+
+bool WriteToFile(base::File* file, const std::string& data) {
+  if (!file->IsValid())
+    return false;
+  return file->WriteAtCurrentPos(data.data(), data.size()) ==
+         static_cast<int>(data.size());
+}
+
+bool FlushFile(base::File* file) {
+  if (!file->IsValid())
+    return false;
+  bool flushed = file->Flush();
+  file->Close();
+  return flushed;
+}
+
 const net::NetworkTrafficAnnotationTag kTrafficAnnotation =
     net::DefineNetworkTrafficAnnotation("electron_net_module", R"(
         semantics {
@@ -382,6 +409,7 @@ void SimpleURLLoaderWrapper::Clone(
 
 void SimpleURLLoaderWrapper::Cancel() {
   loader_.reset();
+  file_.reset();
   pinned_wrapper_.Reset();
   pinned_chunk_pipe_getter_.Reset();
   // This ensures that no further callbacks will be called, so there's no need
@@ -546,16 +574,39 @@ gin::Handle<SimpleURLLoaderWrapper> SimpleURLLoaderWrapper::Create(
 void SimpleURLLoaderWrapper::OnDataReceived(base::StringPiece string_piece,
                                             base::OnceClosure resume) {
   DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (file_) {
+    // The body goes straight to disk without entering JS, and the next chunk
+    // is only requested once this one has been written.
+    file_task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE,
+        base::BindOnce(&WriteToFile, base::Unretained(file_.get()),
+                       std::string(string_piece)),
+        base::BindOnce(&SimpleURLLoaderWrapper::OnFileWriteComplete,
+                       weak_factory_.GetWeakPtr(), std::move(resume)));
+    return;
+  }
   v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
   v8::HandleScope handle_scope(isolate);
-  auto array_buffer = v8::ArrayBuffer::New(isolate, string_piece.size());
-  auto backing_store = array_buffer->GetBackingStore();
-  memcpy(backing_store->Data(), string_piece.data(), string_piece.size());
-  Emit("data", array_buffer,
-       base::AdaptCallbackForRepeating(std::move(resume)));
+  // node::Buffer::Copy skips the zero-fill that v8::ArrayBuffer::New does,
+  // and the resulting Buffer is handed to the stream as is.
+  v8::Local<v8::Object> buffer;
+  if (!node::Buffer::Copy(isolate, string_piece.data(), string_piece.size())
+           .ToLocal(&buffer)) {
+    return;
+  }
+  Emit("data", buffer, base::AdaptCallbackForRepeating(std::move(resume)));
 }
 
 void SimpleURLLoaderWrapper::OnComplete(bool success) {
+  if (file_) {
+    // Report completion only after everything has reached the file.
+    int net_error = loader_->NetError();
+    file_task_runner_->PostTaskAndReplyWithResult(
+        FROM_HERE, base::BindOnce(&FlushFile, base::Unretained(file_.get())),
+        base::BindOnce(&SimpleURLLoaderWrapper::OnFileFlushed,
+                       weak_factory_.GetWeakPtr(), success, net_error));
+    return;
+  }
   if (success) {
     Emit("complete");
   } else {
@@ -566,6 +617,57 @@ void SimpleURLLoaderWrapper::OnComplete(bool success) {
   pinned_chunk_pipe_getter_.Reset();
 }
 
+void SimpleURLLoaderWrapper::PipeToFile(gin::Arguments* args,
+                                        const base::FilePath& path) {
+  if (!loader_) {
+    args->ThrowTypeError("The request has already finished");
+    return;
+  }
+  if (file_) {
+    args->ThrowTypeError("The response is already being piped to a file");
+    return;
+  }
+  file_task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  file_ = std::unique_ptr<base::File, base::OnTaskRunnerDeleter>(
+      new base::File(), base::OnTaskRunnerDeleter(file_task_runner_));
+  // Tasks on |file_task_runner_| run in order, so every write happens after
+  // the file has been opened and before it is destroyed.
+  file_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&OpenFile, base::Unretained(file_.get()), path));
+}
+
+void SimpleURLLoaderWrapper::OnFileWriteComplete(base::OnceClosure resume,
+                                                 bool success) {
+  if (success) {
+    std::move(resume).Run();
+    return;
+  }
+  loader_.reset();
+  file_.reset();
+  Emit("error", std::string("Failed to write response body to file"));
+  pinned_wrapper_.Reset();
+  pinned_chunk_pipe_getter_.Reset();
+}
+
+void SimpleURLLoaderWrapper::OnFileFlushed(bool success,
+                                           int net_error,
+                                           bool flushed) {
+  file_.reset();
+  if (success && flushed) {
+    Emit("complete");
+  } else if (!success) {
+    Emit("error", net::ErrorToString(net_error));
+  } else {
+    Emit("error", std::string("Failed to write response body to file"));
+  }
+  loader_.reset();
+  pinned_wrapper_.Reset();
+  pinned_chunk_pipe_getter_.Reset();
+}
+
 void SimpleURLLoaderWrapper::OnRetry(base::OnceClosure start_retry) {}
 
 void SimpleURLLoaderWrapper::OnResponseStarted(
@@ -605,7 +707,8 @@ gin::ObjectTemplateBuilder SimpleURLLoaderWrapper::GetObjectTemplateBuilder(
     v8::Isolate* isolate) {
   return gin_helper::EventEmitterMixin<
              SimpleURLLoaderWrapper>::GetObjectTemplateBuilder(isolate)
-      .SetMethod("cancel", &SimpleURLLoaderWrapper::Cancel);
+      .SetMethod("cancel", &SimpleURLLoaderWrapper::Cancel)
+      .SetMethod("pipeToFile", &SimpleURLLoaderWrapper::PipeToFile);
 }
 
 const char* SimpleURLLoaderWrapper::GetTypeName() {
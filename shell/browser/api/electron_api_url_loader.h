@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
 #include "gin/wrappable.h"
 #include "mojo/public/cpp/bindings/receiver_set.h"
 #include "net/base/auth.h"
@@ -22,6 +23,11 @@
 #include "url/gurl.h"
 #include "v8/include/v8.h"
 
+namespace base {
+class File;
+class FilePath;
+}  // namespace base
+
 namespace gin {
 class Arguments;
 template <typename T>
@@ -112,10 +118,20 @@ class SimpleURLLoaderWrapper
   void Pin();
   void PinBodyGetter(v8::Local<v8::Value>);
 
+  // Writes the response body to |path| on a background sequence instead of
+  // emitting "data" events.
+  void PipeToFile(gin::Arguments* args, const base::FilePath& path);
+  void OnFileWriteComplete(base::OnceClosure resume, bool success);
+  void OnFileFlushed(bool success, int net_error, bool flushed);
+
   std::unique_ptr<network::SimpleURLLoader> loader_;
   v8::Global<v8::Value> pinned_wrapper_;
   v8::Global<v8::Value> pinned_chunk_pipe_getter_;
 
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  std::unique_ptr<base::File, base::OnTaskRunnerDeleter> file_{
+      nullptr, base::OnTaskRunnerDeleter(nullptr)};
+
   mojo::ReceiverSet<network::mojom::URLLoaderNetworkServiceObserver>
       url_loader_network_observer_receivers_;
   base::WeakPtrFactory<SimpleURLLoaderWrapper> weak_factory_{this};
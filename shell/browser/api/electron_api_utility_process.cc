@@ -13,18 +13,24 @@
 #include "base/process/kill.h"
 #include "base/process/launch.h"
 #include "base/process/process.h"
+#include "base/strings/string_number_conversions.h"
 #include "content/public/browser/service_process_host.h"
 #include "content/public/common/child_process_host.h"
 #include "content/public/common/result_codes.h"
+#include "gin/converter.h"
+#include "gin/dictionary.h"
 #include "gin/handle.h"
 #include "gin/object_template_builder.h"
 #include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "shell/browser/api/message_port.h"
+#include "shell/browser/api/shared_memory_channel.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/callback_converter.h"
 #include "shell/common/gin_converters/file_path_converter.h"
 #include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/gin_helper/error_thrower.h"
 #include "shell/common/gin_helper/object_template_builder.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/v8_value_serializer.h"
@@ -62,7 +68,8 @@ UtilityProcessWrapper::UtilityProcessWrapper(
     std::map<IOHandle, IOType> stdio,
     base::EnvironmentMap env_map,
     base::FilePath current_working_directory,
-    bool use_plugin_helper) {
+    bool use_plugin_helper,
+    absl::optional<UtilityOutputReader::Options> output) {
 #if BUILDFLAG(IS_WIN)
   base::win::ScopedHandle stdout_write(nullptr);
   base::win::ScopedHandle stderr_write(nullptr);
@@ -90,14 +97,24 @@ UtilityProcessWrapper::UtilityProcessWrapper(
       }
       if (io_handle == IOHandle::STDOUT) {
         stdout_write.Set(write);
-        stdout_read_handle_ = read;
-        stdout_read_fd_ =
-            _open_osfhandle(reinterpret_cast<intptr_t>(read), _O_RDONLY);
+        if (output) {
+          stdout_reader_ =
+              CreateOutputReader(base::File(read), "stdout", *output);
+        } else {
+          stdout_read_handle_ = read;
+          stdout_read_fd_ =
+              _open_osfhandle(reinterpret_cast<intptr_t>(read), _O_RDONLY);
+        }
       } else if (io_handle == IOHandle::STDERR) {
         stderr_write.Set(write);
-        stderr_read_handle_ = read;
-        stderr_read_fd_ =
-            _open_osfhandle(reinterpret_cast<intptr_t>(read), _O_RDONLY);
+        if (output) {
+          stderr_reader_ =
+              CreateOutputReader(base::File(read), "stderr", *output);
+        } else {
+          stderr_read_handle_ = read;
+          stderr_read_fd_ =
+              _open_osfhandle(reinterpret_cast<intptr_t>(read), _O_RDONLY);
+        }
       }
 #elif BUILDFLAG(IS_POSIX)
       int pipe_fd[2];
@@ -107,10 +124,20 @@ UtilityProcessWrapper::UtilityProcessWrapper(
       }
       if (io_handle == IOHandle::STDOUT) {
         fds_to_remap.push_back(std::make_pair(pipe_fd[1], STDOUT_FILENO));
-        stdout_read_fd_ = pipe_fd[0];
+        if (output) {
+          stdout_reader_ =
+              CreateOutputReader(base::File(pipe_fd[0]), "stdout", *output);
+        } else {
+          stdout_read_fd_ = pipe_fd[0];
+        }
       } else if (io_handle == IOHandle::STDERR) {
         fds_to_remap.push_back(std::make_pair(pipe_fd[1], STDERR_FILENO));
-        stderr_read_fd_ = pipe_fd[0];
+        if (output) {
+          stderr_reader_ =
+              CreateOutputReader(base::File(pipe_fd[0]), "stderr", *output);
+        } else {
+          stderr_read_fd_ = pipe_fd[0];
+        }
       }
 #endif
     } else if (io_type == IOType::IO_IGNORE) {
@@ -220,7 +247,8 @@ void UtilityProcessWrapper::OnServiceProcessDisconnected(
   CloseConnectorPort();
   // Emit 'exit' event
   EmitWithoutCustomEvent("exit", error_code);
-  Unpin();
+  exited_ = true;
+  MaybeUnpin();
 }
 
 void UtilityProcessWrapper::CloseConnectorPort() {
@@ -239,7 +267,54 @@ void UtilityProcessWrapper::Shutdown(int exit_code) {
   CloseConnectorPort();
   // Emit 'exit' event
   EmitWithoutCustomEvent("exit", exit_code);
-  Unpin();
+  exited_ = true;
+  MaybeUnpin();
+}
+
+void UtilityProcessWrapper::MaybeUnpin() {
+  if (exited_ && open_output_streams_ == 0)
+    Unpin();
+}
+
+std::unique_ptr<UtilityOutputReader> UtilityProcessWrapper::CreateOutputReader(
+    base::File pipe,
+    const char* stream,
+    const UtilityOutputReader::Options& options) {
+  ++open_output_streams_;
+  bool binary = options.framing != UtilityOutputReader::Framing::kLine;
+  return std::make_unique<UtilityOutputReader>(
+      std::move(pipe), options,
+      base::BindRepeating(&UtilityProcessWrapper::OnOutput,
+                          weak_factory_.GetWeakPtr(), stream, binary));
+}
+
+void UtilityProcessWrapper::OnOutput(const char* stream,
+                                     bool binary,
+                                     UtilityOutputReader::Batch batch) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  if (!batch.records.empty() || batch.dropped_bytes) {
+    std::vector<v8::Local<v8::Value>> records;
+    records.reserve(batch.records.size());
+    for (const std::string& record : batch.records) {
+      if (binary) {
+        records.push_back(
+            node::Buffer::Copy(isolate, record.data(), record.size())
+                .ToLocalChecked());
+      } else {
+        records.push_back(gin::StringToV8(isolate, record));
+      }
+    }
+    gin_helper::Dictionary details = gin::Dictionary::CreateEmpty(isolate);
+    details.Set("stream", stream);
+    details.Set("records", records);
+    details.Set("droppedBytes", static_cast<double>(batch.dropped_bytes));
+    EmitWithoutCustomEvent("output", details);
+  }
+  if (batch.end) {
+    --open_output_streams_;
+    MaybeUnpin();
+  }
 }
 
 void UtilityProcessWrapper::PostMessage(gin::Arguments* args) {
@@ -277,6 +352,35 @@ void UtilityProcessWrapper::PostMessage(gin::Arguments* args) {
   connector_->Accept(&mojo_message);
 }
 
+v8::Local<v8::Value> UtilityProcessWrapper::CreateSharedMemoryChannel(
+    gin::Arguments* args) {
+  v8::Isolate* isolate = args->isolate();
+  double capacity = SharedMemoryChannel::kDefaultCapacity;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("capacity", &capacity);
+  if (!(capacity >= 1 && capacity <= SharedMemoryChannel::kMaxCapacity)) {
+    gin_helper::ErrorThrower(isolate).ThrowRangeError(
+        "capacity must be between 1 and " +
+        base::NumberToString(SharedMemoryChannel::kMaxCapacity));
+    return v8::Undefined(isolate);
+  }
+  if (!node_service_remote_.is_connected()) {
+    args->ThrowError("The utility process has exited");
+    return v8::Undefined(isolate);
+  }
+
+  node::mojom::SharedMemoryChannelParamsPtr params;
+  auto channel = SharedMemoryChannel::Create(
+      isolate, static_cast<uint32_t>(capacity), &params);
+  if (channel.IsEmpty()) {
+    args->ThrowError("Failed to allocate the shared memory");
+    return v8::Undefined(isolate);
+  }
+  node_service_remote_->OpenSharedMemoryChannel(std::move(params));
+  return channel.ToV8();
+}
+
 bool UtilityProcessWrapper::Kill() const {
   if (pid_ == base::kNullProcessId)
     return 0;
@@ -322,6 +426,28 @@ raw_ptr<UtilityProcessWrapper> UtilityProcessWrapper::FromProcessId(
   return !!utility_process_wrapper ? utility_process_wrapper : nullptr;
 }
 
+// static
+std::vector<UtilityProcessWrapper*> UtilityProcessWrapper::GetAll() {
+  std::vector<UtilityProcessWrapper*> list;
+  for (base::IDMap<UtilityProcessWrapper*, base::ProcessId>::iterator iter(
+           &GetAllUtilityProcessWrappers());
+       !iter.IsAtEnd(); iter.Advance()) {
+    list.push_back(iter.GetCurrentValue());
+  }
+  return list;
+}
+
+void UtilityProcessWrapper::GetStartupMarks(
+    node::mojom::NodeService::GetStartupMarksCallback callback) {
+  if (!node_service_remote_.is_connected()) {
+    std::move(callback).Run({});
+    return;
+  }
+  node_service_remote_->GetStartupMarks(
+      mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+          std::move(callback), std::vector<electron::mojom::StartupMarkPtr>()));
+}
+
 // static
 gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
     gin::Arguments* args) {
@@ -336,6 +462,7 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
   std::map<IOHandle, IOType> stdio;
   base::FilePath current_working_directory;
   base::EnvironmentMap env_map;
+  absl::optional<UtilityOutputReader::Options> output;
   node::mojom::NodeServiceParamsPtr params =
       node::mojom::NodeServiceParams::New();
   dict.Get("modulePath", &params->script);
@@ -373,6 +500,29 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
       stdio.emplace(static_cast<IOHandle>(i), type);
     }
 
+    gin_helper::Dictionary output_dict;
+    if (opts.Get("output", &output_dict)) {
+      output.emplace();
+      std::string framing;
+      if (output_dict.Get("framing", &framing)) {
+        if (framing == "none") {
+          output->framing = UtilityOutputReader::Framing::kNone;
+        } else if (framing == "length-prefixed") {
+          output->framing = UtilityOutputReader::Framing::kLengthPrefixed;
+        } else if (framing != "line") {
+          args->ThrowTypeError("Invalid value for output.framing");
+          return gin::Handle<UtilityProcessWrapper>();
+        }
+      }
+      double flush_interval;
+      if (output_dict.Get("flushInterval", &flush_interval))
+        output->flush_interval = base::Milliseconds(flush_interval);
+      double max_bytes_per_second;
+      if (output_dict.Get("maxBytesPerSecond", &max_bytes_per_second))
+        output->max_bytes_per_second = max_bytes_per_second;
+      output_dict.Get("logFile", &output->log_file);
+    }
+
 #if BUILDFLAG(IS_MAC)
     opts.Get("allowLoadingUnsignedLibraries", &use_plugin_helper);
 #endif
@@ -381,7 +531,8 @@ gin::Handle<UtilityProcessWrapper> UtilityProcessWrapper::Create(
       args->isolate(),
       new UtilityProcessWrapper(std::move(params), display_name,
                                 std::move(stdio), env_map,
-                                current_working_directory, use_plugin_helper));
+                                current_working_directory, use_plugin_helper,
+                                std::move(output)));
   handle->Pin(args->isolate());
   return handle;
 }
@@ -392,6 +543,8 @@ gin::ObjectTemplateBuilder UtilityProcessWrapper::GetObjectTemplateBuilder(
   return gin_helper::EventEmitterMixin<
              UtilityProcessWrapper>::GetObjectTemplateBuilder(isolate)
       .SetMethod("postMessage", &UtilityProcessWrapper::PostMessage)
+      .SetMethod("createSharedMemoryChannel",
+                 &UtilityProcessWrapper::CreateSharedMemoryChannel)
       .SetMethod("kill", &UtilityProcessWrapper::Kill)
       .SetProperty("pid", &UtilityProcessWrapper::GetOSProcessId);
 }
@@ -18,9 +18,11 @@
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
 #include "mojo/public/cpp/bindings/remote.h"
+#include "shell/browser/api/utility_output_reader.h"
 #include "shell/browser/event_emitter_mixin.h"
 #include "shell/common/gin_helper/pinnable.h"
 #include "shell/services/node/public/mojom/node_service.mojom.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 #include "v8/include/v8.h"
 
 namespace gin {
@@ -49,9 +51,17 @@ class UtilityProcessWrapper
   ~UtilityProcessWrapper() override;
   static gin::Handle<UtilityProcessWrapper> Create(gin::Arguments* args);
   static raw_ptr<UtilityProcessWrapper> FromProcessId(base::ProcessId pid);
+  static std::vector<UtilityProcessWrapper*> GetAll();
 
   void Shutdown(int exit_code);
 
+  base::ProcessId pid() const { return pid_; }
+
+  // Runs |callback| with the startup marks of the process, or with none when
+  // it is not running.
+  void GetStartupMarks(
+      node::mojom::NodeService::GetStartupMarksCallback callback);
+
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
   gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
@@ -64,13 +74,24 @@ class UtilityProcessWrapper
                         std::map<IOHandle, IOType> stdio,
                         base::EnvironmentMap env_map,
                         base::FilePath current_working_directory,
-                        bool use_plugin_helper);
+                        bool use_plugin_helper,
+                        absl::optional<UtilityOutputReader::Options> output);
   void OnServiceProcessDisconnected(uint32_t error_code,
                                     const std::string& description);
   void OnServiceProcessLaunched(const base::Process& process);
   void CloseConnectorPort();
+  void MaybeUnpin();
+
+  std::unique_ptr<UtilityOutputReader> CreateOutputReader(
+      base::File pipe,
+      const char* stream,
+      const UtilityOutputReader::Options& options);
+  void OnOutput(const char* stream,
+                bool binary,
+                UtilityOutputReader::Batch batch);
 
   void PostMessage(gin::Arguments* args);
+  v8::Local<v8::Value> CreateSharedMemoryChannel(gin::Arguments* args);
   bool Kill() const;
   v8::Local<v8::Value> GetOSProcessId(v8::Isolate* isolate) const;
 
@@ -86,6 +107,13 @@ class UtilityProcessWrapper
 #endif
   int stdout_read_fd_ = -1;
   int stderr_read_fd_ = -1;
+  // Set instead of the fds when the output is read natively.
+  std::unique_ptr<UtilityOutputReader> stdout_reader_;
+  std::unique_ptr<UtilityOutputReader> stderr_reader_;
+  // The wrapper stays pinned after the process exits until the readers have
+  // delivered what it wrote.
+  int open_output_streams_ = 0;
+  bool exited_ = false;
   bool connector_closed_ = false;
   std::unique_ptr<mojo::Connector> connector_;
   blink::MessagePortDescriptor host_port_;
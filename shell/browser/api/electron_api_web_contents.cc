@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/callback_helpers.h"
 #include "base/containers/id_map.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
@@ -71,6 +72,7 @@
 #include "mojo/public/cpp/bindings/pending_receiver.h"
 #include "mojo/public/cpp/bindings/remote.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "net/base/net_errors.h"
 #include "ppapi/buildflags/buildflags.h"
 #include "printing/buildflags/buildflags.h"
 #include "printing/print_job_constants.h"
@@ -78,6 +80,8 @@
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/browser/api/electron_api_browser_window.h"
 #include "shell/browser/api/electron_api_debugger.h"
+#include "shell/browser/api/electron_api_ipc_main.h"
+#include "shell/browser/api/electron_api_page_capture.h"
 #include "shell/browser/api/electron_api_session.h"
 #include "shell/browser/api/electron_api_web_frame_main.h"
 #include "shell/browser/api/message_port.h"
@@ -90,8 +94,10 @@
 #include "shell/browser/electron_javascript_dialog_manager.h"
 #include "shell/browser/electron_navigation_throttle.h"
 #include "shell/browser/file_select_helper.h"
+#include "shell/browser/heap_snapshot_stream.h"
 #include "shell/browser/native_window.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/browser/ui/drag_util.h"
 #include "shell/browser/ui/file_dialog.h"
 #include "shell/browser/ui/inspectable_web_contents.h"
@@ -123,6 +129,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
 #include "shell/common/process_util.h"
+#include "shell/common/startup_marks.h"
 #include "shell/common/v8_value_serializer.h"
 #include "storage/browser/file_system/isolated_context.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
@@ -132,6 +139,7 @@
 #include "third_party/blink/public/common/page/page_zoom.h"
 #include "third_party/blink/public/mojom/frame/find_in_page.mojom.h"
 #include "third_party/blink/public/mojom/frame/fullscreen.mojom.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom.h"
 #include "third_party/blink/public/mojom/messaging/transferable_message.mojom.h"
 #include "third_party/blink/public/mojom/renderer_preferences.mojom.h"
 #include "ui/base/cursor/cursor.h"
@@ -201,8 +209,39 @@
 #include "chrome/browser/hang_monitor/hang_crash_dump.h"  // nogncheck
 #endif
 
+namespace {
+
+// A chunk of a heap snapshot, passed to JS as a Buffer.
+struct HeapSnapshotChunk {
+  std::string data;
+};
+
+}  // namespace
+
 namespace gin {
 
+template <>
+struct Converter<HeapSnapshotChunk> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const HeapSnapshotChunk& chunk) {
+    return node::Buffer::Copy(isolate, chunk.data.data(), chunk.data.size())
+        .ToLocalChecked();
+  }
+};
+
+template <>
+struct Converter<electron::HeapSnapshotStream::Progress> {
+  static v8::Local<v8::Value> ToV8(
+      v8::Isolate* isolate,
+      const electron::HeapSnapshotStream::Progress& progress) {
+    gin_helper::Dictionary dict = gin::Dictionary::CreateEmpty(isolate);
+    dict.Set("snapshotPercent", progress.snapshot_percent);
+    dict.Set("bytesSerialized", static_cast<double>(progress.bytes_serialized));
+    dict.Set("bytesWritten", static_cast<double>(progress.bytes_written));
+    return dict.GetHandle();
+  }
+};
+
 #if BUILDFLAG(ENABLE_PRINTING)
 template <>
 struct Converter<printing::mojom::MarginType> {
@@ -803,6 +842,8 @@ WebContents::WebContents(v8::Isolate* isolate,
   } else {
     content::WebContents::CreateParams params(session->browser_context());
     params.initially_hidden = !initially_shown;
+    SpareRendererPool::ScopedClaim spare_renderer_claim(
+        session->browser_context(), options);
     web_contents = content::WebContents::Create(params);
   }
 
@@ -874,6 +915,10 @@ void WebContents::InitWithSessionAndOptions(
   // of the webContents.setWindowOpenHandler path, so don't overwrite it.
   if (!WebContentsPreferences::From(web_contents())) {
     new WebContentsPreferences(web_contents(), options);
+    auto* spare_renderer_pool =
+        SpareRendererPool::FromBrowserContext(session->browser_context());
+    if (spare_renderer_pool && !IsGuest())
+      spare_renderer_pool->OnWindowCreated(options, web_contents());
   }
   // Trigger re-calculation of webkit prefs.
   web_contents()->NotifyPreferencesChanged();
@@ -1619,8 +1664,11 @@ void WebContents::RenderFrameHostChanged(content::RenderFrameHost* old_host,
 
 void WebContents::FrameDeleted(int frame_tree_node_id) {
   auto* web_frame = WebFrameMain::FromFrameTreeNodeId(frame_tree_node_id);
-  if (web_frame)
+  if (web_frame) {
+    // Lets the frame release its ipc handlers.
+    web_frame->Emit("-destroyed");
     web_frame->Destroyed();
+  }
 }
 
 void WebContents::RenderViewDeleted(content::RenderViewHost* render_view_host) {
@@ -1750,6 +1798,17 @@ void WebContents::DidStopLoading() {
   Emit("did-stop-loading");
 }
 
+void WebContents::ResourceLoadComplete(
+    content::RenderFrameHost* render_frame_host,
+    const content::GlobalRequestID& request_id,
+    const blink::mojom::ResourceLoadInfo& resource_load_info) {
+  // Feeds the hit rate reported by ses.getCacheStats().
+  if (resource_load_info.net_error == net::OK &&
+      resource_load_info.final_url.SchemeIsHTTPOrHTTPS()) {
+    GetBrowserContext()->RecordHttpCacheLoad(resource_load_info.was_cached);
+  }
+}
+
 bool WebContents::EmitNavigationEvent(
     const std::string& event,
     content::NavigationHandle* navigation_handle) {
@@ -1795,6 +1854,21 @@ void WebContents::Invoke(
     electron::mojom::ElectronApiIPC::InvokeCallback callback,
     content::RenderFrameHost* render_frame_host) {
   TRACE_EVENT1("electron", "WebContents::Invoke", "channel", channel);
+  // Requests for channels handled only by ipcMain.handle() are dispatched
+  // directly to the handler.
+  auto* invoke_registry = IpcMainInvokeRegistry::GetInstance();
+  if (!internal && render_frame_host && invoke_registry->CanDispatch(channel)) {
+    v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Object> wrapper;
+    if (!GetWrapper(isolate).ToLocal(&wrapper))
+      return;
+    v8::Local<v8::Object> event = gin_helper::internal::CreateNativeEvent(
+        isolate, wrapper, render_frame_host, std::move(callback));
+    invoke_registry->Dispatch(isolate, event, channel,
+                              gin::ConvertToV8(isolate, arguments));
+    return;
+  }
   // webContents.emit('-ipc-invoke', new Event(), internal, channel, arguments);
   EmitWithSender("-ipc-invoke", render_frame_host, std::move(callback),
                  internal, channel, std::move(arguments));
@@ -1803,6 +1877,11 @@ void WebContents::Invoke(
 void WebContents::OnFirstNonEmptyLayout(
     content::RenderFrameHost* render_frame_host) {
   if (render_frame_host == web_contents()->GetPrimaryMainFrame()) {
+    // One mark per WebContents, the number of marks is bounded.
+    if (!first_non_empty_layout_marked_) {
+      first_non_empty_layout_marked_ = true;
+      AddStartupMark("WebContents::FirstNonEmptyLayout");
+    }
     Emit("ready-to-show");
   }
 }
@@ -2841,11 +2920,9 @@ void WebContents::Print(gin::Arguments* args) {
 
 // Partially duplicated and modified from
 // headless/lib/browser/protocol/page_handler.cc;l=41
-v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
-  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
-  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
-  v8::Local<v8::Promise> handle = promise.GetHandle();
-
+absl::optional<std::string> WebContents::PreparePrintToPDF(
+    const base::Value& settings,
+    printing::mojom::PrintPagesParamsPtr* params) {
   // This allows us to track headless printing calls.
   auto unique_id = settings.GetDict().FindInt(printing::kPreviewRequestID);
   auto landscape = settings.GetDict().FindBool("landscape");
@@ -2859,7 +2936,6 @@ v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
   auto margin_bottom = settings.GetDict().FindDouble("marginBottom");
   auto margin_left = settings.GetDict().FindDouble("marginLeft");
   auto margin_right = settings.GetDict().FindDouble("marginRight");
-  auto page_ranges = *settings.GetDict().FindString("pageRanges");
   auto header_template = *settings.GetDict().FindString("headerTemplate");
   auto footer_template = *settings.GetDict().FindString("footerTemplate");
   auto prefer_css_page_size = settings.GetDict().FindBool("preferCSSPageSize");
@@ -2874,23 +2950,56 @@ v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
 
   if (absl::holds_alternative<std::string>(print_pages_params)) {
     auto error = absl::get<std::string>(print_pages_params);
-    promise.RejectWithErrorMessage("Invalid print parameters: " + error);
+    return "Invalid print parameters: " + error;
+  }
+
+  if (!PrintViewManagerElectron::FromWebContents(web_contents()))
+    return std::string("Failed to find print manager");
+
+  *params = std::move(
+      absl::get<printing::mojom::PrintPagesParamsPtr>(print_pages_params));
+  (*params)->params->document_cookie = unique_id.value_or(0);
+  return absl::nullopt;
+}
+
+v8::Local<v8::Promise> WebContents::PrintToPDF(const base::Value& settings) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  gin_helper::Promise<v8::Local<v8::Value>> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  printing::mojom::PrintPagesParamsPtr params;
+  if (auto error = PreparePrintToPDF(settings, &params)) {
+    promise.RejectWithErrorMessage(*error);
     return handle;
   }
 
   auto* manager = PrintViewManagerElectron::FromWebContents(web_contents());
-  if (!manager) {
-    promise.RejectWithErrorMessage("Failed to find print manager");
+  manager->PrintToPdf(web_contents()->GetPrimaryMainFrame(),
+                      *settings.GetDict().FindString("pageRanges"),
+                      std::move(params),
+                      base::BindOnce(&WebContents::OnPDFCreated, GetWeakPtr(),
+                                     std::move(promise)));
+
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::PrintToPDFFile(const base::Value& settings,
+                                                   const base::FilePath& path) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  gin_helper::Promise<void> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  printing::mojom::PrintPagesParamsPtr params;
+  if (auto error = PreparePrintToPDF(settings, &params)) {
+    promise.RejectWithErrorMessage(*error);
     return handle;
   }
 
-  auto params = std::move(
-      absl::get<printing::mojom::PrintPagesParamsPtr>(print_pages_params));
-  params->params->document_cookie = unique_id.value_or(0);
-
-  manager->PrintToPdf(web_contents()->GetPrimaryMainFrame(), page_ranges,
+  auto* manager = PrintViewManagerElectron::FromWebContents(web_contents());
+  manager->PrintToPdf(web_contents()->GetPrimaryMainFrame(),
+                      *settings.GetDict().FindString("pageRanges"),
                       std::move(params),
-                      base::BindOnce(&WebContents::OnPDFCreated, GetWeakPtr(),
+                      base::BindOnce(&WebContents::OnPDFCreatedForFile, path,
                                      std::move(promise)));
 
   return handle;
@@ -2920,6 +3029,44 @@ void WebContents::OnPDFCreated(
 
   promise.Resolve(buffer);
 }
+
+// static
+void WebContents::OnPDFCreatedForFile(
+    const base::FilePath& path,
+    gin_helper::Promise<void> promise,
+    print_to_pdf::PdfPrintResult print_result,
+    scoped_refptr<base::RefCountedMemory> data) {
+  if (print_result != print_to_pdf::PdfPrintResult::kPrintSuccess) {
+    promise.RejectWithErrorMessage(
+        "Failed to generate PDF: " +
+        print_to_pdf::PdfPrintResultToString(print_result));
+    return;
+  }
+
+  // The document is written straight from the memory the print compositor
+  // filled in, so it is never copied into the JS heap.
+  base::ThreadPool::PostTaskAndReplyWithResult(
+      FROM_HERE,
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(
+          [](const base::FilePath& path,
+             scoped_refptr<base::RefCountedMemory> data) {
+            return base::WriteFile(
+                path, base::make_span(data->front(), data->size()));
+          },
+          path, std::move(data)),
+      base::BindOnce(
+          [](gin_helper::Promise<void> promise, const base::FilePath& path,
+             bool success) {
+            if (success)
+              promise.Resolve();
+            else
+              promise.RejectWithErrorMessage("Failed to write PDF to " +
+                                             path.AsUTF8Unsafe());
+          },
+          std::move(promise), path));
+}
 #endif
 
 void WebContents::AddWorkSpace(gin::Arguments* args,
@@ -3217,6 +3364,12 @@ v8::Local<v8::Promise> WebContents::CapturePage(gin::Arguments* args) {
   return handle;
 }
 
+gin::Handle<PageCapture> WebContents::CreatePageCapture(
+    v8::Isolate* isolate,
+    const gfx::Size& page_size) {
+  return PageCapture::Create(isolate, web_contents(), page_size);
+}
+
 void WebContents::IncrementCapturerCount(gin::Arguments* args) {
   gfx::Size size;
   bool stay_hidden = false;
@@ -3567,6 +3720,120 @@ v8::Local<v8::Promise> WebContents::TakeHeapSnapshot(
   return handle;
 }
 
+base::RepeatingClosure WebContents::StreamHeapSnapshot(gin::Arguments* args) {
+  bool compress = true;
+  base::RepeatingCallback<bool(HeapSnapshotChunk)> on_data;
+  HeapSnapshotStream::ProgressCallback on_progress;
+  base::OnceCallback<void(const std::string&)> on_end;
+  if (!args->GetNext(&compress) || !args->GetNext(&on_data) ||
+      !args->GetNext(&on_progress) || !args->GetNext(&on_end)) {
+    args->ThrowTypeError("Invalid arguments");
+    return base::DoNothing();
+  }
+
+  auto* frame_host = web_contents()->GetPrimaryMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    args->ThrowError(
+        "Failed to take heap snapshot with nonexistent render frame");
+    return base::DoNothing();
+  }
+
+  // Returns the function resuming the stream once JS wants more data.
+  return HeapSnapshotStream::Start(
+      frame_host, compress,
+      base::BindRepeating(
+          [](const base::RepeatingCallback<bool(HeapSnapshotChunk)>& on_data,
+             std::string data) { return on_data.Run({std::move(data)}); },
+          std::move(on_data)),
+      std::move(on_progress),
+      base::BindOnce(
+          [](base::OnceCallback<void(const std::string&)> on_end,
+             const absl::optional<std::string>& error) {
+            std::move(on_end).Run(error.value_or(std::string()));
+          },
+          std::move(on_end)));
+}
+
+v8::Local<v8::Promise> WebContents::StartSamplingHeapProfiler(
+    gin::Arguments* args) {
+  gin_helper::Promise<void> promise(args->isolate());
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  // The defaults of the DevTools allocation sampling profiler.
+  double sample_interval = 32768;
+  int stack_depth = 128;
+  gin_helper::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("samplingInterval", &sample_interval);
+    options.Get("stackDepth", &stack_depth);
+  }
+  if (sample_interval < 1 || stack_depth < 1) {
+    promise.RejectWithErrorMessage(
+        "samplingInterval and stackDepth must be positive numbers");
+    return handle;
+  }
+
+  auto* frame_host = web_contents()->GetPrimaryMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage(
+        "Failed to start the heap profiler with nonexistent render frame");
+    return handle;
+  }
+
+  // See WebContents::TakeHeapSnapshot.
+  auto electron_renderer =
+      std::make_unique<mojo::Remote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteInterfaces()->GetInterface(
+      electron_renderer->BindNewPipeAndPassReceiver());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StartSamplingHeapProfiler(
+      static_cast<uint64_t>(sample_interval), stack_depth,
+      base::BindOnce(
+          [](mojo::Remote<mojom::ElectronRenderer>* ep,
+             gin_helper::Promise<void> promise, bool success) {
+            if (success) {
+              promise.Resolve();
+            } else {
+              promise.RejectWithErrorMessage(
+                  "Failed to start the heap profiler");
+            }
+          },
+          base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Promise> WebContents::StopSamplingHeapProfiler(
+    v8::Isolate* isolate) {
+  gin_helper::Promise<std::string> promise(isolate);
+  v8::Local<v8::Promise> handle = promise.GetHandle();
+
+  auto* frame_host = web_contents()->GetPrimaryMainFrame();
+  if (!frame_host || !frame_host->IsRenderFrameLive()) {
+    promise.RejectWithErrorMessage(
+        "Failed to stop the heap profiler with nonexistent render frame");
+    return handle;
+  }
+
+  auto electron_renderer =
+      std::make_unique<mojo::Remote<mojom::ElectronRenderer>>();
+  frame_host->GetRemoteInterfaces()->GetInterface(
+      electron_renderer->BindNewPipeAndPassReceiver());
+  auto* raw_ptr = electron_renderer.get();
+  (*raw_ptr)->StopSamplingHeapProfiler(base::BindOnce(
+      [](mojo::Remote<mojom::ElectronRenderer>* ep,
+         gin_helper::Promise<std::string> promise,
+         const absl::optional<std::string>& profile) {
+        if (profile) {
+          promise.Resolve(*profile);
+        } else {
+          promise.RejectWithErrorMessage(
+              "The heap profiler is not running");
+        }
+      },
+      base::Owned(std::move(electron_renderer)), std::move(promise)));
+  return handle;
+}
+
 void WebContents::UpdatePreferredSize(content::WebContents* web_contents,
                                       const gfx::Size& pref_size) {
   Emit("preferred-size-changed", pref_size);
@@ -4067,6 +4334,7 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
 #if BUILDFLAG(ENABLE_PRINTING)
       .SetMethod("_print", &WebContents::Print)
       .SetMethod("_printToPDF", &WebContents::PrintToPDF)
+      .SetMethod("_printToPDFFile", &WebContents::PrintToPDFFile)
 #endif
       .SetMethod("_setNextChildWebPreferences",
                  &WebContents::SetNextChildWebPreferences)
@@ -4076,6 +4344,7 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
                  &WebContents::ShowDefinitionForSelection)
       .SetMethod("copyImageAt", &WebContents::CopyImageAt)
       .SetMethod("capturePage", &WebContents::CapturePage)
+      .SetMethod("_createPageCapture", &WebContents::CreatePageCapture)
       .SetMethod("setEmbedder", &WebContents::SetEmbedder)
       .SetMethod("setDevToolsWebContents", &WebContents::SetDevToolsWebContents)
       .SetMethod("getNativeView", &WebContents::GetNativeView)
@@ -4088,6 +4357,11 @@ v8::Local<v8::ObjectTemplate> WebContents::FillObjectTemplate(
       .SetMethod("getWebRTCIPHandlingPolicy",
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("_streamHeapSnapshot", &WebContents::StreamHeapSnapshot)
+      .SetMethod("startSamplingHeapProfiler",
+                 &WebContents::StartSamplingHeapProfiler)
+      .SetMethod("stopSamplingHeapProfiler",
+                 &WebContents::StopSamplingHeapProfiler)
       .SetMethod("setImageAnimationPolicy",
                  &WebContents::SetImageAnimationPolicy)
       .SetMethod("_getProcessMemoryInfo", &WebContents::GetProcessMemoryInfo)
@@ -4203,6 +4477,16 @@ WebContents* WebContents::FromID(int32_t id) {
   return GetAllWebContents().Lookup(id);
 }
 
+// static
+std::vector<WebContents*> WebContents::GetAll() {
+  std::vector<WebContents*> list;
+  for (auto iter = base::IDMap<WebContents*>::iterator(&GetAllWebContents());
+       !iter.IsAtEnd(); iter.Advance()) {
+    list.push_back(iter.GetCurrentValue());
+  }
+  return list;
+}
+
 // static
 gin::WrapperInfo WebContents::kWrapperInfo = {gin::kEmbedderNativeGin};
 
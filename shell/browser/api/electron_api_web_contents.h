@@ -95,6 +95,8 @@ class OffScreenWebContentsView;
 
 namespace api {
 
+class PageCapture;
+
 // Wrapper around the content::WebContents.
 class WebContents : public ExclusiveAccessContext,
                     public gin::Wrappable<WebContents>,
@@ -133,6 +135,7 @@ class WebContents : public ExclusiveAccessContext,
   // if there is no associated wrapper.
   static WebContents* From(content::WebContents* web_contents);
   static WebContents* FromID(int32_t id);
+  static std::vector<WebContents*> GetAll();
 
   // Get the V8 wrapper of the |web_contents|, or create one if not existed.
   //
@@ -227,9 +230,19 @@ class WebContents : public ExclusiveAccessContext,
   void Print(gin::Arguments* args);
   // Print current page as PDF.
   v8::Local<v8::Promise> PrintToPDF(const base::Value& settings);
+  // Print current page as PDF into |path| without passing the data to JS.
+  v8::Local<v8::Promise> PrintToPDFFile(const base::Value& settings,
+                                        const base::FilePath& path);
+  absl::optional<std::string> PreparePrintToPDF(
+      const base::Value& settings,
+      printing::mojom::PrintPagesParamsPtr* params);
   void OnPDFCreated(gin_helper::Promise<v8::Local<v8::Value>> promise,
                     print_to_pdf::PdfPrintResult print_result,
                     scoped_refptr<base::RefCountedMemory> data);
+  static void OnPDFCreatedForFile(const base::FilePath& path,
+                                  gin_helper::Promise<void> promise,
+                                  print_to_pdf::PdfPrintResult print_result,
+                                  scoped_refptr<base::RefCountedMemory> data);
 #endif
 
   void SetNextChildWebPreferences(const gin_helper::Dictionary);
@@ -272,6 +285,8 @@ class WebContents : public ExclusiveAccessContext,
   // Captures the page with |rect|, |callback| would be called when capturing is
   // done.
   v8::Local<v8::Promise> CapturePage(gin::Arguments* args);
+  gin::Handle<PageCapture> CreatePageCapture(v8::Isolate* isolate,
+                                             const gfx::Size& page_size);
 
   // Methods for creating <webview>.
   bool IsGuest() const;
@@ -326,6 +341,11 @@ class WebContents : public ExclusiveAccessContext,
 
   v8::Local<v8::Promise> TakeHeapSnapshot(v8::Isolate* isolate,
                                           const base::FilePath& file_path);
+  // Streams a heap snapshot of the renderer to JS callbacks, compressed with
+  // gzip unless told otherwise.
+  base::RepeatingClosure StreamHeapSnapshot(gin::Arguments* args);
+  v8::Local<v8::Promise> StartSamplingHeapProfiler(gin::Arguments* args);
+  v8::Local<v8::Promise> StopSamplingHeapProfiler(v8::Isolate* isolate);
   v8::Local<v8::Promise> GetProcessMemoryInfo(v8::Isolate* isolate);
 
   // Properties.
@@ -591,6 +611,10 @@ class WebContents : public ExclusiveAccessContext,
                    int error_code) override;
   void DidStartLoading() override;
   void DidStopLoading() override;
+  void ResourceLoadComplete(
+      content::RenderFrameHost* render_frame_host,
+      const content::GlobalRequestID& request_id,
+      const blink::mojom::ResourceLoadInfo& resource_load_info) override;
   void DidStartNavigation(
       content::NavigationHandle* navigation_handle) override;
   void DidRedirectNavigation(
@@ -786,6 +810,10 @@ class WebContents : public ExclusiveAccessContext,
   // Whether window is fullscreened by window api.
   bool native_fullscreen_ = false;
 
+  // Whether the first layout of the main frame was added to the startup
+  // marks.
+  bool first_non_empty_layout_marked_ = false;
+
   scoped_refptr<DevToolsFileSystemIndexer> devtools_file_system_indexer_;
 
   std::unique_ptr<ExclusiveAccessManager> exclusive_access_manager_;
@@ -11,6 +11,7 @@
 
 #include "base/logging.h"
 #include "base/no_destructor.h"
+#include "base/time/time.h"
 #include "content/browser/renderer_host/render_frame_host_impl.h"  // nogncheck
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/common/isolated_world_ids.h"
@@ -19,6 +20,7 @@
 #include "services/service_manager/public/cpp/interface_provider.h"
 #include "shell/browser/api/message_port.h"
 #include "shell/browser/browser.h"
+#include "shell/browser/ipc_channel_stats.h"
 #include "shell/browser/javascript_environment.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/frame_converter.h"
@@ -174,6 +176,7 @@ void WebFrameMain::Send(v8::Isolate* isolate,
                         bool internal,
                         const std::string& channel,
                         v8::Local<v8::Value> args) {
+  const base::TimeTicks serialize_start = base::TimeTicks::Now();
   blink::CloneableMessage message;
   if (!gin::ConvertFromV8(isolate, args, &message)) {
     isolate->ThrowException(v8::Exception::Error(
@@ -184,6 +187,9 @@ void WebFrameMain::Send(v8::Isolate* isolate,
   if (!CheckRenderFrame())
     return;
 
+  IpcChannelStats::GetInstance()->RecordOutgoing(
+      channel, message.encoded_message.size(),
+      base::TimeTicks::Now() - serialize_start);
   GetRendererApi()->Message(internal, channel, std::move(message),
                             0 /* sender_id */);
 }
@@ -231,6 +237,7 @@ void WebFrameMain::PostMessage(v8::Isolate* isolate,
                                const std::string& channel,
                                v8::Local<v8::Value> message_value,
                                absl::optional<v8::Local<v8::Value>> transfer) {
+  const base::TimeTicks serialize_start = base::TimeTicks::Now();
   blink::TransferableMessage transferable_message;
   if (!electron::SerializeV8Value(isolate, message_value,
                                   &transferable_message)) {
@@ -256,6 +263,9 @@ void WebFrameMain::PostMessage(v8::Isolate* isolate,
   if (!CheckRenderFrame())
     return;
 
+  IpcChannelStats::GetInstance()->RecordOutgoing(
+      channel, transferable_message.encoded_message.size(),
+      base::TimeTicks::Now() - serialize_start);
   GetRendererApi()->ReceivePostMessage(channel,
                                        std::move(transferable_message));
 }
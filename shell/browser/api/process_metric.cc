@@ -16,6 +16,46 @@
 #include "base/win/win_util.h"
 #endif
 
+#if BUILDFLAG(IS_LINUX)
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+
+namespace {
+
+// Calls |callback| with the name and the value in bytes of every
+// "Name:   1234 kB" line of a file in /proc/<pid>.
+template <typename Callback>
+bool ReadProcFields(base::ProcessId pid,
+                    const char* file_name,
+                    Callback callback) {
+  std::string contents;
+  if (!base::ReadFileToString(base::FilePath("/proc")
+                                  .Append(base::NumberToString(pid))
+                                  .Append(file_name),
+                              &contents))
+    return false;
+  for (base::StringPiece line : base::SplitStringPiece(
+           contents, "\n", base::TRIM_WHITESPACE, base::SPLIT_WANT_NONEMPTY)) {
+    size_t colon = line.find(':');
+    if (colon == base::StringPiece::npos ||
+        !base::EndsWith(line, " kB", base::CompareCase::SENSITIVE))
+      continue;
+    base::StringPiece value = base::TrimWhitespaceASCII(
+        line.substr(colon + 1, line.size() - colon - 4), base::TRIM_ALL);
+    size_t kb = 0;
+    if (base::StringToSizeT(value, &kb))
+      callback(line.substr(0, colon), kb << 10);
+  }
+  return true;
+}
+
+}  // namespace
+#endif  // BUILDFLAG(IS_LINUX)
+
 #if BUILDFLAG(IS_MAC)
 #include <mach/mach.h>
 #include "base/process/port_provider_mac.h"
@@ -167,6 +207,50 @@ bool ProcessMetric::IsSandboxed() const {
 #endif
 }
 
-#endif  // BUILDFLAG(IS_MAC)
+#elif BUILDFLAG(IS_LINUX)
+
+ProcessMemoryInfo ProcessMetric::GetMemoryInfo() const {
+  return ReadMemoryInfo(process.Pid());
+}
+
+// static
+ProcessMemoryInfo ProcessMetric::ReadMemoryInfo(base::ProcessId pid) {
+  ProcessMemoryInfo result;
+
+  // The status file can be read for every child process.
+  ReadProcFields(pid, "status", [&](base::StringPiece name, size_t bytes) {
+    if (name == "VmRSS")
+      result.working_set_size = bytes;
+    else if (name == "VmHWM")
+      result.peak_working_set_size = bytes;
+    else if (name == "VmSwap")
+      result.swap = bytes;
+  });
+
+  // The kernel sums up all the mappings into smaps_rollup, which is much
+  // cheaper to read and parse than smaps.
+  size_t pss = 0, private_clean = 0, private_dirty = 0, shared_dirty = 0;
+  bool has_rollup = ReadProcFields(
+      pid, "smaps_rollup", [&](base::StringPiece name, size_t bytes) {
+        if (name == "Pss")
+          pss = bytes;
+        else if (name == "Private_Clean")
+          private_clean = bytes;
+        else if (name == "Private_Dirty")
+          private_dirty = bytes;
+        else if (name == "Shared_Dirty")
+          shared_dirty = bytes;
+      });
+  if (has_rollup) {
+    result.proportional_set_size = pss;
+    result.unique_set_size = private_clean + private_dirty;
+    result.private_dirty = private_dirty;
+    result.shared_dirty = shared_dirty;
+  }
+
+  return result;
+}
+
+#endif  // BUILDFLAG(IS_LINUX)
 
 }  // namespace electron
@@ -11,18 +11,25 @@
 #include "base/process/process.h"
 #include "base/process/process_handle.h"
 #include "base/process/process_metrics.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
 
 namespace electron {
 
-#if !BUILDFLAG(IS_LINUX)
 struct ProcessMemoryInfo {
   size_t working_set_size = 0;
   size_t peak_working_set_size = 0;
 #if BUILDFLAG(IS_WIN)
   size_t private_bytes = 0;
+#elif BUILDFLAG(IS_LINUX)
+  size_t swap = 0;
+  // Only available when /proc/<pid>/smaps_rollup can be read, which is not
+  // the case for sandboxed processes or kernels older than 4.14.
+  absl::optional<size_t> proportional_set_size;
+  absl::optional<size_t> unique_set_size;
+  absl::optional<size_t> private_dirty;
+  absl::optional<size_t> shared_dirty;
 #endif
 };
-#endif
 
 #if BUILDFLAG(IS_WIN)
 enum class ProcessIntegrityLevel {
@@ -48,8 +55,11 @@ struct ProcessMetric {
                 const std::string& name = std::string());
   ~ProcessMetric();
 
-#if !BUILDFLAG(IS_LINUX)
   ProcessMemoryInfo GetMemoryInfo() const;
+
+#if BUILDFLAG(IS_LINUX)
+  // Reads the memory usage of |pid| from procfs, which may block.
+  static ProcessMemoryInfo ReadMemoryInfo(base::ProcessId pid);
 #endif
 
 #if BUILDFLAG(IS_WIN)
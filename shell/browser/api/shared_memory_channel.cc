@@ -0,0 +1,264 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/shared_memory_channel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <utility>
+
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "gin/arguments.h"
+#include "gin/handle.h"
+#include "gin/object_template_builder.h"
+#include "shell/browser/javascript_environment.h"
+#include "shell/common/gin_helper/error_thrower.h"
+#include "shell/common/gin_helper/event_emitter_caller.h"
+#include "shell/common/node_includes.h"
+
+namespace electron {
+
+// Lives at the start of each ring in the shared memory.
+struct SharedMemoryChannel::RingHeader {
+  // The total number of bytes written to and read from the ring, the ring
+  // holds the bytes in between.
+  std::atomic<uint64_t> write_position;
+  std::atomic<uint64_t> read_position;
+  // Set by the reader when it found the ring empty, and by the writer when it
+  // found the ring full.
+  std::atomic<uint32_t> reader_waiting;
+  std::atomic<uint32_t> writer_waiting;
+};
+
+namespace {
+
+// The ends run in different processes, so the atomics must not use locks.
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+
+// Keeps the data of a ring away from the cache line of its header.
+constexpr size_t kHeaderSize = 64;
+
+size_t GetRingSize(uint32_t capacity) {
+  return kHeaderSize + capacity;
+}
+
+}  // namespace
+
+gin::WrapperInfo SharedMemoryChannel::kWrapperInfo = {gin::kEmbedderNativeGin};
+
+// static
+gin::Handle<SharedMemoryChannel> SharedMemoryChannel::Create(
+    v8::Isolate* isolate,
+    uint32_t capacity,
+    node::mojom::SharedMemoryChannelParamsPtr* params) {
+  auto region =
+      base::UnsafeSharedMemoryRegion::Create(2 * GetRingSize(capacity));
+  if (!region.IsValid())
+    return gin::Handle<SharedMemoryChannel>();
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return gin::Handle<SharedMemoryChannel>();
+
+  mojo::PendingRemote<node::mojom::SharedMemoryChannelPeer> peer;
+  mojo::PendingRemote<node::mojom::SharedMemoryChannelPeer> remote_peer;
+  *params = node::mojom::SharedMemoryChannelParams::New();
+  (*params)->region = std::move(region);
+  (*params)->capacity = capacity;
+  (*params)->receiver = peer.InitWithNewPipeAndPassReceiver();
+  auto receiver = remote_peer.InitWithNewPipeAndPassReceiver();
+  (*params)->peer = std::move(remote_peer);
+
+  auto handle = gin::CreateHandle(
+      isolate, new SharedMemoryChannel(std::move(mapping), capacity, true,
+                                       std::move(peer), std::move(receiver)));
+  handle->Pin(isolate);
+  return handle;
+}
+
+// static
+gin::Handle<SharedMemoryChannel> SharedMemoryChannel::Open(
+    v8::Isolate* isolate,
+    node::mojom::SharedMemoryChannelParamsPtr params) {
+  if (params->capacity == 0 || params->capacity > kMaxCapacity)
+    return gin::Handle<SharedMemoryChannel>();
+  base::WritableSharedMemoryMapping mapping = params->region.Map();
+  if (!mapping.IsValid() || mapping.size() < 2 * GetRingSize(params->capacity))
+    return gin::Handle<SharedMemoryChannel>();
+
+  auto handle = gin::CreateHandle(
+      isolate, new SharedMemoryChannel(std::move(mapping), params->capacity,
+                                       false, std::move(params->peer),
+                                       std::move(params->receiver)));
+  handle->Pin(isolate);
+  return handle;
+}
+
+SharedMemoryChannel::SharedMemoryChannel(
+    base::WritableSharedMemoryMapping mapping,
+    uint32_t capacity,
+    bool is_creator,
+    mojo::PendingRemote<node::mojom::SharedMemoryChannelPeer> peer,
+    mojo::PendingReceiver<node::mojom::SharedMemoryChannelPeer> receiver)
+    : mapping_(std::move(mapping)),
+      capacity_(capacity),
+      peer_(std::move(peer)) {
+  uint8_t* memory = mapping_.GetMemoryAsSpan<uint8_t>().data();
+  uint8_t* first = memory;
+  uint8_t* second = memory + GetRingSize(capacity);
+  uint8_t* out = is_creator ? first : second;
+  uint8_t* in = is_creator ? second : first;
+  // The region is zero-initialized, which is the initial state of a ring.
+  out_header_ = reinterpret_cast<RingHeader*>(out);
+  out_data_ = out + kHeaderSize;
+  in_header_ = reinterpret_cast<RingHeader*>(in);
+  in_data_ = in + kHeaderSize;
+
+  receiver_.Bind(std::move(receiver));
+  receiver_.set_disconnect_handler(base::BindOnce(
+      &SharedMemoryChannel::OnPeerDisconnected, base::Unretained(this)));
+  peer_.set_disconnect_handler(base::BindOnce(
+      &SharedMemoryChannel::OnPeerDisconnected, base::Unretained(this)));
+}
+
+SharedMemoryChannel::~SharedMemoryChannel() = default;
+
+uint32_t SharedMemoryChannel::Write(gin::Arguments* args) {
+  v8::Local<v8::Value> buffer;
+  if (!args->GetNext(&buffer) || !node::Buffer::HasInstance(buffer)) {
+    args->ThrowTypeError("data must be a Buffer");
+    return 0;
+  }
+  if (closed_ || !peer_.is_connected()) {
+    args->ThrowError("The channel is closed");
+    return 0;
+  }
+
+  const auto* data =
+      reinterpret_cast<const uint8_t*>(node::Buffer::Data(buffer));
+  size_t size = node::Buffer::Length(buffer);
+  uint64_t write = out_header_->write_position.load();
+  size_t written = 0;
+  for (;;) {
+    uint64_t read = out_header_->read_position.load();
+    if (write - read > capacity_) {
+      args->ThrowError("The channel is corrupted");
+      Close();
+      return 0;
+    }
+    size_t count =
+        std::min<size_t>(size - written, capacity_ - (write - read));
+    size_t offset = write % capacity_;
+    size_t first = std::min<size_t>(count, capacity_ - offset);
+    memcpy(out_data_ + offset, data + written, first);
+    memcpy(out_data_, data + written + first, count - first);
+    written += count;
+    write += count;
+    out_header_->write_position.store(write);
+    if (written == size)
+      break;
+    // The ring is full, flag it and check again in case the reader freed
+    // space before it could see the flag.
+    out_header_->writer_waiting.store(1);
+    if (out_header_->read_position.load() == read)
+      break;
+    out_header_->writer_waiting.store(0);
+  }
+
+  if (written > 0 && out_header_->reader_waiting.exchange(0))
+    peer_->OnReadable();
+  return written;
+}
+
+v8::Local<v8::Value> SharedMemoryChannel::Read(v8::Isolate* isolate) {
+  if (closed_)
+    return v8::Null(isolate);
+
+  uint64_t read = in_header_->read_position.load();
+  uint64_t write = in_header_->write_position.load();
+  if (write == read) {
+    // The ring is empty, flag it and check again in case the writer wrote
+    // before it could see the flag.
+    in_header_->reader_waiting.store(1);
+    write = in_header_->write_position.load();
+    if (write == read)
+      return v8::Null(isolate);
+    in_header_->reader_waiting.store(0);
+  }
+  if (write - read > capacity_) {
+    gin_helper::ErrorThrower(isolate).ThrowError("The channel is corrupted");
+    Close();
+    return v8::Null(isolate);
+  }
+
+  size_t count = write - read;
+  v8::Local<v8::Object> buffer;
+  if (!node::Buffer::New(isolate, count).ToLocal(&buffer))
+    return v8::Null(isolate);
+  auto* data = reinterpret_cast<uint8_t*>(node::Buffer::Data(buffer));
+  size_t offset = read % capacity_;
+  size_t first = std::min<size_t>(count, capacity_ - offset);
+  memcpy(data, in_data_ + offset, first);
+  memcpy(data + first, in_data_, count - first);
+  in_header_->read_position.store(write);
+
+  if (in_header_->writer_waiting.exchange(0) && peer_.is_connected())
+    peer_->OnWritable();
+  return buffer;
+}
+
+void SharedMemoryChannel::Close() {
+  if (closed_)
+    return;
+  closed_ = true;
+  receiver_.reset();
+  peer_.reset();
+  out_header_ = nullptr;
+  out_data_ = nullptr;
+  in_header_ = nullptr;
+  in_data_ = nullptr;
+  mapping_ = base::WritableSharedMemoryMapping();
+  Emit("close");
+  Unpin();
+}
+
+void SharedMemoryChannel::OnReadable() {
+  Emit("readable");
+}
+
+void SharedMemoryChannel::OnWritable() {
+  Emit("writable");
+}
+
+void SharedMemoryChannel::OnPeerDisconnected() {
+  // The data the peer wrote before closing can still be read, so the memory
+  // is kept until this end is closed too.
+  receiver_.reset();
+  peer_.reset();
+  Emit("end");
+}
+
+void SharedMemoryChannel::Emit(const char* name) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Object> self;
+  if (GetWrapper(isolate).ToLocal(&self))
+    gin_helper::EmitEvent(isolate, self, name);
+}
+
+gin::ObjectTemplateBuilder SharedMemoryChannel::GetObjectTemplateBuilder(
+    v8::Isolate* isolate) {
+  return gin::Wrappable<SharedMemoryChannel>::GetObjectTemplateBuilder(isolate)
+      .SetMethod("write", &SharedMemoryChannel::Write)
+      .SetMethod("read", &SharedMemoryChannel::Read)
+      .SetMethod("close", &SharedMemoryChannel::Close)
+      .SetProperty("capacity", &SharedMemoryChannel::capacity);
+}
+
+const char* SharedMemoryChannel::GetTypeName() {
+  return "SharedMemoryChannel";
+}
+
+}  // namespace electron
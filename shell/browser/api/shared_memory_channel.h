@@ -0,0 +1,108 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_SHARED_MEMORY_CHANNEL_H_
+#define ELECTRON_SHELL_BROWSER_API_SHARED_MEMORY_CHANNEL_H_
+
+#include <cstdint>
+
+#include "base/memory/shared_memory_mapping.h"
+#include "gin/wrappable.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "shell/common/gin_helper/pinnable.h"
+#include "shell/services/node/public/mojom/node_service.mojom.h"
+
+namespace gin {
+class Arguments;
+template <typename T>
+class Handle;
+}  // namespace gin
+
+namespace electron {
+
+// A byte stream between the browser and a utility process that does not copy
+// the data through IPC. The region holds two single-producer single-consumer
+// rings, the end that created the channel writes to the first one and reads
+// from the second one.
+//
+// The ends only signal each other over IPC when the peer has flagged in the
+// ring that it found it empty (reader) or full (writer), so a steady stream
+// of data does not involve IPC at all.
+class SharedMemoryChannel
+    : public gin::Wrappable<SharedMemoryChannel>,
+      public gin_helper::Pinnable<SharedMemoryChannel>,
+      public node::mojom::SharedMemoryChannelPeer {
+ public:
+  static constexpr uint32_t kDefaultCapacity = 1024 * 1024;
+  static constexpr uint32_t kMaxCapacity = 64 * 1024 * 1024;
+
+  // Creates the end of the browser and fills |params| with what the utility
+  // process needs to open the other end.
+  static gin::Handle<SharedMemoryChannel> Create(
+      v8::Isolate* isolate,
+      uint32_t capacity,
+      node::mojom::SharedMemoryChannelParamsPtr* params);
+  // Opens the end of the utility process.
+  static gin::Handle<SharedMemoryChannel> Open(
+      v8::Isolate* isolate,
+      node::mojom::SharedMemoryChannelParamsPtr params);
+
+  uint32_t capacity() const { return capacity_; }
+
+  // Releases the memory and disconnects the peer, which then sees the end of
+  // the stream. Also unpins the channel.
+  void Close();
+
+  // disable copy
+  SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+  SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+
+  // gin::Wrappable
+  static gin::WrapperInfo kWrapperInfo;
+  gin::ObjectTemplateBuilder GetObjectTemplateBuilder(
+      v8::Isolate* isolate) override;
+  const char* GetTypeName() override;
+
+ private:
+  struct RingHeader;
+
+  SharedMemoryChannel(
+      base::WritableSharedMemoryMapping mapping,
+      uint32_t capacity,
+      bool is_creator,
+      mojo::PendingRemote<node::mojom::SharedMemoryChannelPeer> peer,
+      mojo::PendingReceiver<node::mojom::SharedMemoryChannelPeer> receiver);
+  ~SharedMemoryChannel() override;
+
+  // Copies as much of the data as fits and returns the number of bytes
+  // written. Once it returns less than the size of the data, a 'writable'
+  // event is emitted when space is freed.
+  uint32_t Write(gin::Arguments* args);
+  // Returns the available bytes as a Buffer, or null when there are none and
+  // a 'readable' event will be emitted once data is written.
+  v8::Local<v8::Value> Read(v8::Isolate* isolate);
+
+  // node::mojom::SharedMemoryChannelPeer
+  void OnReadable() override;
+  void OnWritable() override;
+
+  void OnPeerDisconnected();
+  void Emit(const char* name);
+
+  base::WritableSharedMemoryMapping mapping_;
+  uint32_t capacity_;
+  RingHeader* out_header_ = nullptr;
+  uint8_t* out_data_ = nullptr;
+  RingHeader* in_header_ = nullptr;
+  const uint8_t* in_data_ = nullptr;
+  bool closed_ = false;
+
+  mojo::Remote<node::mojom::SharedMemoryChannelPeer> peer_;
+  mojo::Receiver<node::mojom::SharedMemoryChannelPeer> receiver_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_SHARED_MEMORY_CHANNEL_H_
@@ -0,0 +1,357 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/api/utility_output_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "base/memory/ref_counted.h"
+#include "base/numerics/byte_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "build/build_config.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <windows.h>
+#elif BUILDFLAG(IS_POSIX)
+#include <errno.h>
+#include <unistd.h>
+
+#include "base/files/file_descriptor_watcher_posix.h"
+#include "base/files/file_util.h"
+#include "base/posix/eintr_wrapper.h"
+#endif
+
+namespace electron {
+
+namespace {
+
+constexpr size_t kReadSize = 64 * 1024;
+// Longer lines are split, larger records are dropped.
+constexpr size_t kMaxLineSize = 64 * 1024;
+constexpr uint32_t kMaxRecordSize = 16 * 1024 * 1024;
+// Output is dropped rather than buffered past this size while the main
+// thread has not collected it.
+constexpr size_t kMaxPendingSize = 8 * 1024 * 1024;
+#if BUILDFLAG(IS_POSIX)
+// Reads done before yielding the sequence to other readers.
+constexpr int kMaxReadsPerWakeUp = 16;
+#elif BUILDFLAG(IS_WIN)
+// An idle pipe is polled less and less often, up to this interval.
+constexpr base::TimeDelta kMaxPollInterval = base::Milliseconds(100);
+#endif
+
+}  // namespace
+
+// Owns the pipe and the framing state on the worker sequence, and the batch
+// shared with the main thread.
+//
+// The pipe is only read when it has data, so no worker is held while the
+// process is quiet. On POSIX the sequence watches the pipe for readability.
+// Anonymous pipes on Windows can not be watched, so the sequence polls them
+// with PeekNamedPipe() instead, backing off while they stay empty.
+class UtilityOutputReader::Core
+    : public base::RefCountedThreadSafe<UtilityOutputReader::Core> {
+ public:
+  Core(base::File pipe,
+       const Options& options,
+       scoped_refptr<base::SequencedTaskRunner> main_task_runner,
+       base::WeakPtr<UtilityOutputReader> reader)
+      : pipe_(std::move(pipe)),
+        options_(options),
+        main_task_runner_(std::move(main_task_runner)),
+        reader_(std::move(reader)) {}
+
+  // disable copy
+  Core(const Core&) = delete;
+  Core& operator=(const Core&) = delete;
+
+  void Start() {
+    task_runner_ = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN});
+    task_runner_->PostTask(FROM_HERE, base::BindOnce(&Core::Open, this));
+  }
+
+  // Called on the main thread.
+  Batch TakeBatch() {
+    base::AutoLock lock(lock_);
+    Batch batch = std::move(pending_);
+    pending_ = Batch();
+    pending_size_ = 0;
+    flush_scheduled_ = false;
+    return batch;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Core>;
+
+  ~Core() = default;
+
+  void Open() {
+    if (!options_.log_file.empty()) {
+      log_file_.Initialize(options_.log_file,
+                           base::File::FLAG_OPEN_ALWAYS |
+                               base::File::FLAG_APPEND |
+                               base::File::FLAG_WRITE);
+    }
+    buffer_.resize(kReadSize);
+#if BUILDFLAG(IS_POSIX)
+    if (!base::SetNonBlocking(pipe_.GetPlatformFile())) {
+      Finish();
+      return;
+    }
+    // The callback keeps the core alive until the pipe is closed.
+    watch_controller_ = base::FileDescriptorWatcher::WatchReadable(
+        pipe_.GetPlatformFile(),
+        base::BindRepeating(&Core::OnReadable, base::WrapRefCounted(this)));
+#elif BUILDFLAG(IS_WIN)
+    Poll();
+#endif
+  }
+
+#if BUILDFLAG(IS_POSIX)
+  void OnReadable() {
+    for (int i = 0; i < kMaxReadsPerWakeUp; i++) {
+      ssize_t count = HANDLE_EINTR(
+          read(pipe_.GetPlatformFile(), buffer_.data(), buffer_.size()));
+      if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        return;
+      if (count <= 0) {
+        Finish();
+        return;
+      }
+      OnData(buffer_.data(), static_cast<int>(count));
+    }
+  }
+#elif BUILDFLAG(IS_WIN)
+  void Poll() {
+    DWORD available = 0;
+    if (!::PeekNamedPipe(pipe_.GetPlatformFile(), nullptr, 0, nullptr,
+                         &available, nullptr)) {
+      // The process closed the pipe.
+      Finish();
+      return;
+    }
+    if (available == 0) {
+      poll_interval_ = std::min(
+          std::max(poll_interval_ * 2, base::Milliseconds(1)),
+          kMaxPollInterval);
+      task_runner_->PostDelayedTask(
+          FROM_HERE, base::BindOnce(&Core::Poll, this), poll_interval_);
+      return;
+    }
+    // Only the available bytes are read, so this does not block.
+    int count = pipe_.ReadAtCurrentPosNoBestEffort(
+        buffer_.data(), std::min<size_t>(available, buffer_.size()));
+    if (count <= 0) {
+      Finish();
+      return;
+    }
+    OnData(buffer_.data(), count);
+    poll_interval_ = base::TimeDelta();
+    task_runner_->PostTask(FROM_HERE, base::BindOnce(&Core::Poll, this));
+  }
+#endif
+
+  void OnData(const char* data, int count) {
+    if (log_file_.IsValid())
+      log_file_.WriteAtCurrentPos(data, count);
+    Frame(data, count);
+  }
+
+  void Finish() {
+#if BUILDFLAG(IS_POSIX)
+    // The watch holds a reference to the core.
+    scoped_refptr<Core> self(this);
+    watch_controller_.reset();
+#endif
+    pipe_.Close();
+
+    // Whatever is left of an unterminated line is a record too.
+    if (options_.framing == Framing::kLine && !partial_.empty())
+      AddRecord(std::move(partial_));
+
+    base::AutoLock lock(lock_);
+    pending_.end = true;
+    // A flush that is already scheduled might be later.
+    flush_scheduled_ = false;
+    ScheduleFlushLocked(base::TimeDelta());
+  }
+
+  void Frame(const char* data, size_t size) {
+    switch (options_.framing) {
+      case Framing::kNone:
+        AddRecord(std::string(data, size));
+        break;
+      case Framing::kLine:
+        FrameLines(data, size);
+        break;
+      case Framing::kLengthPrefixed:
+        FrameRecords(data, size);
+        break;
+    }
+  }
+
+  void FrameLines(const char* data, size_t size) {
+    const char* end = data + size;
+    while (data < end) {
+      const char* newline = std::find(data, end, '\n');
+      partial_.append(data, newline);
+      if (newline == end) {
+        if (partial_.size() >= kMaxLineSize) {
+          AddRecord(std::move(partial_));
+          partial_.clear();
+        }
+        return;
+      }
+      if (!partial_.empty() && partial_.back() == '\r')
+        partial_.pop_back();
+      AddRecord(std::move(partial_));
+      partial_.clear();
+      data = newline + 1;
+    }
+  }
+
+  void FrameRecords(const char* data, size_t size) {
+    while (size > 0) {
+      if (record_size_ < 0) {
+        // Still reading the size of the next record.
+        size_t count = std::min(size, 4 - partial_.size());
+        partial_.append(data, count);
+        data += count;
+        size -= count;
+        if (partial_.size() < 4)
+          return;
+        uint32_t record_size;
+        memcpy(&record_size, partial_.data(), 4);
+        record_size = base::NetToHost32(record_size);
+        partial_.clear();
+        record_size_ = record_size;
+        skip_record_ = record_size > kMaxRecordSize;
+        if (skip_record_)
+          CountDropped(record_size);
+      }
+      size_t remaining = record_size_ - record_bytes_;
+      size_t count = std::min(size, remaining);
+      if (!skip_record_)
+        partial_.append(data, count);
+      record_bytes_ += count;
+      data += count;
+      size -= count;
+      if (record_bytes_ == static_cast<size_t>(record_size_)) {
+        if (!skip_record_)
+          AddRecord(std::move(partial_));
+        partial_.clear();
+        record_size_ = -1;
+        record_bytes_ = 0;
+      }
+    }
+  }
+
+  void AddRecord(std::string record) {
+    // A fixed one-second window is precise enough to keep a runaway process
+    // from flooding the main thread.
+    base::TimeTicks now = base::TimeTicks::Now();
+    if (now - window_start_ >= base::Seconds(1)) {
+      window_start_ = now;
+      window_bytes_ = 0;
+    }
+    if (options_.max_bytes_per_second &&
+        window_bytes_ + record.size() > options_.max_bytes_per_second) {
+      CountDropped(record.size());
+      return;
+    }
+    window_bytes_ += record.size();
+
+    base::AutoLock lock(lock_);
+    if (pending_size_ + record.size() > kMaxPendingSize) {
+      pending_.dropped_bytes += record.size();
+    } else {
+      pending_size_ += record.size();
+      pending_.records.push_back(std::move(record));
+    }
+    ScheduleFlushLocked(options_.flush_interval);
+  }
+
+  void CountDropped(uint64_t size) {
+    base::AutoLock lock(lock_);
+    pending_.dropped_bytes += size;
+    ScheduleFlushLocked(options_.flush_interval);
+  }
+
+  // Only the first record of a batch wakes up the main thread.
+  void ScheduleFlushLocked(base::TimeDelta delay) {
+    lock_.AssertAcquired();
+    if (flush_scheduled_)
+      return;
+    flush_scheduled_ = true;
+    main_task_runner_->PostDelayedTask(
+        FROM_HERE, base::BindOnce(&UtilityOutputReader::Flush, reader_),
+        delay);
+  }
+
+  base::File pipe_;
+  base::File log_file_;
+  const Options options_;
+  scoped_refptr<base::SequencedTaskRunner> main_task_runner_;
+  base::WeakPtr<UtilityOutputReader> reader_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+
+  // Reading and framing state, only accessed on the worker sequence.
+  std::vector<char> buffer_;
+#if BUILDFLAG(IS_POSIX)
+  std::unique_ptr<base::FileDescriptorWatcher::Controller> watch_controller_;
+#elif BUILDFLAG(IS_WIN)
+  base::TimeDelta poll_interval_;
+#endif
+  std::string partial_;
+  int64_t record_size_ = -1;
+  size_t record_bytes_ = 0;
+  bool skip_record_ = false;
+  base::TimeTicks window_start_;
+  uint64_t window_bytes_ = 0;
+
+  base::Lock lock_;
+  Batch pending_ GUARDED_BY(lock_);
+  size_t pending_size_ GUARDED_BY(lock_) = 0;
+  bool flush_scheduled_ GUARDED_BY(lock_) = false;
+};
+
+UtilityOutputReader::Options::Options() = default;
+UtilityOutputReader::Options::Options(const Options&) = default;
+UtilityOutputReader::Options::~Options() = default;
+
+UtilityOutputReader::Batch::Batch() = default;
+UtilityOutputReader::Batch::Batch(Batch&&) = default;
+UtilityOutputReader::Batch& UtilityOutputReader::Batch::operator=(Batch&&) =
+    default;
+UtilityOutputReader::Batch::~Batch() = default;
+
+UtilityOutputReader::UtilityOutputReader(base::File pipe,
+                                         const Options& options,
+                                         BatchCallback callback)
+    : callback_(std::move(callback)) {
+  core_ = base::MakeRefCounted<Core>(std::move(pipe), options,
+                                     base::SequencedTaskRunnerHandle::Get(),
+                                     weak_factory_.GetWeakPtr());
+  core_->Start();
+}
+
+// The worker sequence keeps reading until the process closes the pipe, and
+// drops the output once this is gone.
+UtilityOutputReader::~UtilityOutputReader() = default;
+
+void UtilityOutputReader::Flush() {
+  Batch batch = core_->TakeBatch();
+  if (!batch.records.empty() || batch.dropped_bytes || batch.end)
+    callback_.Run(std::move(batch));
+}
+
+}  // namespace electron
@@ -0,0 +1,84 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_API_UTILITY_OUTPUT_READER_H_
+#define ELECTRON_SHELL_BROWSER_API_UTILITY_OUTPUT_READER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+
+namespace electron {
+
+// Reads the output a utility process writes to a pipe on a worker sequence,
+// splits it into records and hands them to the main thread in batches, so
+// that a chatty process does not wake the main thread for each write.
+class UtilityOutputReader {
+ public:
+  enum class Framing {
+    // Chunks as they were read.
+    kNone,
+    // Lines without their terminator.
+    kLine,
+    // Records preceded by their size as a 32-bit big-endian integer.
+    kLengthPrefixed,
+  };
+
+  struct Options {
+    Options();
+    Options(const Options&);
+    ~Options();
+
+    Framing framing = Framing::kLine;
+    base::TimeDelta flush_interval = base::Milliseconds(100);
+    // Records past this budget are dropped, 0 means unlimited.
+    uint64_t max_bytes_per_second = 0;
+    // When set, all the output is appended to this file.
+    base::FilePath log_file;
+  };
+
+  struct Batch {
+    Batch();
+    Batch(Batch&&);
+    Batch& operator=(Batch&&);
+    ~Batch();
+
+    std::vector<std::string> records;
+    // The bytes dropped by the rate limit since the previous batch.
+    uint64_t dropped_bytes = 0;
+    // Set on the last batch, once the process closed the pipe.
+    bool end = false;
+  };
+  using BatchCallback = base::RepeatingCallback<void(Batch)>;
+
+  UtilityOutputReader(base::File pipe,
+                      const Options& options,
+                      BatchCallback callback);
+  ~UtilityOutputReader();
+
+  // disable copy
+  UtilityOutputReader(const UtilityOutputReader&) = delete;
+  UtilityOutputReader& operator=(const UtilityOutputReader&) = delete;
+
+ private:
+  class Core;
+
+  void Flush();
+
+  BatchCallback callback_;
+  scoped_refptr<Core> core_;
+
+  base::WeakPtrFactory<UtilityOutputReader> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_API_UTILITY_OUTPUT_READER_H_
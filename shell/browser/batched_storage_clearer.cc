@@ -0,0 +1,186 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/batched_storage_clearer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/barrier_callback.h"
+#include "base/task/bind_post_task.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/storage_partition.h"
+#include "shell/browser/electron_browser_context.h"
+#include "storage/browser/quota/quota_manager.h"
+#include "third_party/blink/public/common/storage_key/storage_key.h"
+#include "third_party/blink/public/mojom/quota/quota_types.mojom.h"
+
+namespace electron {
+
+namespace {
+
+using UsageCallback = base::OnceCallback<void(int64_t)>;
+
+// The progress is reported at most this often, and after the last deletion.
+constexpr base::TimeDelta kProgressInterval = base::Milliseconds(100);
+
+void SumUsage(UsageCallback callback, std::vector<int64_t> usages) {
+  int64_t total = 0;
+  for (int64_t usage : usages)
+    total += usage;
+  std::move(callback).Run(total);
+}
+
+// The quota manager lives on the IO thread.
+void GetUsageOnIOThread(scoped_refptr<storage::QuotaManager> quota_manager,
+                        std::vector<url::Origin> origins,
+                        UsageCallback callback) {
+  UsageCallback reply = base::BindPostTask(content::GetUIThreadTaskRunner({}),
+                                           std::move(callback));
+  if (origins.empty()) {
+    quota_manager->GetGlobalUsage(
+        blink::mojom::StorageType::kTemporary,
+        base::BindOnce(
+            [](UsageCallback callback, int64_t usage,
+               int64_t unlimited_usage) { std::move(callback).Run(usage); },
+            std::move(reply)));
+    return;
+  }
+
+  auto barrier = base::BarrierCallback<int64_t>(
+      origins.size(), base::BindOnce(&SumUsage, std::move(reply)));
+  for (const url::Origin& origin : origins) {
+    quota_manager->GetUsageAndQuota(
+        blink::StorageKey(origin), blink::mojom::StorageType::kTemporary,
+        base::BindOnce(
+            [](base::RepeatingCallback<void(int64_t)> barrier,
+               blink::mojom::QuotaStatusCode status, int64_t usage,
+               int64_t quota) {
+              barrier.Run(status == blink::mojom::QuotaStatusCode::kOk ? usage
+                                                                       : 0);
+            },
+            barrier));
+  }
+}
+
+}  // namespace
+
+BatchedStorageClearer::Options::Options() = default;
+BatchedStorageClearer::Options::Options(Options&&) = default;
+BatchedStorageClearer::Options::~Options() = default;
+
+// static
+void BatchedStorageClearer::Start(ElectronBrowserContext* browser_context,
+                                  Options options,
+                                  ProgressCallback progress_callback,
+                                  DoneCallback done_callback) {
+  auto clearer = base::WrapRefCounted(new BatchedStorageClearer(
+      browser_context, std::move(options), std::move(progress_callback),
+      std::move(done_callback)));
+  clearer->MeasureUsage(
+      base::BindOnce(&BatchedStorageClearer::OnUsageBeforeMeasured, clearer));
+}
+
+BatchedStorageClearer::BatchedStorageClearer(
+    ElectronBrowserContext* browser_context,
+    Options options,
+    ProgressCallback progress_callback,
+    DoneCallback done_callback)
+    : base::RefCountedDeleteOnSequence<BatchedStorageClearer>(
+          content::GetUIThreadTaskRunner({})),
+      browser_context_(browser_context->GetWeakPtr()),
+      options_(std::move(options)),
+      progress_callback_(std::move(progress_callback)),
+      done_callback_(std::move(done_callback)) {
+  for (uint32_t bit = 1; bit && bit <= options_.storage_mask; bit <<= 1) {
+    if (options_.storage_mask & bit)
+      queue_masks_.push_back(bit);
+  }
+  next_origins_.resize(queue_masks_.size());
+  // An empty origin list is cleared with a single deletion per backend.
+  total_ = queue_masks_.size() * std::max<size_t>(options_.origins.size(), 1);
+}
+
+BatchedStorageClearer::~BatchedStorageClearer() {
+  // The last reference can be dropped while the session is torn down, so the
+  // caller is told later.
+  if (done_callback_) {
+    content::GetUIThreadTaskRunner({})->PostTask(
+        FROM_HERE, base::BindOnce(std::move(done_callback_), absl::nullopt));
+  }
+}
+
+void BatchedStorageClearer::MeasureUsage(UsageCallback callback) {
+  if (!browser_context_)
+    return;
+  scoped_refptr<storage::QuotaManager> quota_manager =
+      browser_context_->GetDefaultStoragePartition()->GetQuotaManager();
+  content::GetIOThreadTaskRunner({})->PostTask(
+      FROM_HERE, base::BindOnce(&GetUsageOnIOThread, std::move(quota_manager),
+                                options_.origins, std::move(callback)));
+}
+
+void BatchedStorageClearer::OnUsageBeforeMeasured(int64_t usage) {
+  usage_before_ = usage;
+  running_queues_ = queue_masks_.size();
+  if (!running_queues_) {
+    // Nothing to delete, but the progress is still reported once.
+    if (progress_callback_)
+      progress_callback_.Run(0, 0);
+    OnUsageAfterMeasured(usage);
+    return;
+  }
+  for (size_t queue = 0; queue < queue_masks_.size(); ++queue)
+    PostClearNext(queue);
+}
+
+void BatchedStorageClearer::PostClearNext(size_t queue) {
+  // Yielding between deletions keeps the other work of the main thread
+  // responsive, and best effort tasks wait for it.
+  content::GetUIThreadTaskRunner({options_.idle
+                                      ? base::TaskPriority::BEST_EFFORT
+                                      : base::TaskPriority::USER_VISIBLE})
+      ->PostTask(FROM_HERE, base::BindOnce(&BatchedStorageClearer::ClearNext,
+                                           this, queue));
+}
+
+void BatchedStorageClearer::ClearNext(size_t queue) {
+  if (!browser_context_)
+    return;
+  blink::StorageKey storage_key;
+  if (!options_.origins.empty())
+    storage_key = blink::StorageKey(options_.origins[next_origins_[queue]]);
+  ++next_origins_[queue];
+  browser_context_->GetDefaultStoragePartition()->ClearData(
+      queue_masks_[queue], options_.quota_mask, storage_key, base::Time(),
+      base::Time::Max(),
+      base::BindOnce(&BatchedStorageClearer::OnCleared, this, queue));
+}
+
+void BatchedStorageClearer::OnCleared(size_t queue) {
+  ++completed_;
+  base::TimeTicks now = base::TimeTicks::Now();
+  if (progress_callback_ && (completed_ == total_ ||
+                             now - last_progress_time_ >= kProgressInterval)) {
+    last_progress_time_ = now;
+    progress_callback_.Run(completed_, total_);
+  }
+
+  if (next_origins_[queue] < options_.origins.size()) {
+    PostClearNext(queue);
+    return;
+  }
+  if (--running_queues_ == 0) {
+    MeasureUsage(
+        base::BindOnce(&BatchedStorageClearer::OnUsageAfterMeasured, this));
+  }
+}
+
+void BatchedStorageClearer::OnUsageAfterMeasured(int64_t usage) {
+  // Other pages can store data while the deletions run.
+  std::move(done_callback_).Run(std::max<int64_t>(usage_before_ - usage, 0));
+}
+
+}  // namespace electron
@@ -0,0 +1,100 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_BATCHED_STORAGE_CLEARER_H_
+#define ELECTRON_SHELL_BROWSER_BATCHED_STORAGE_CLEARER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/ref_counted_delete_on_sequence.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+#include "url/origin.h"
+
+namespace electron {
+
+class ElectronBrowserContext;
+
+// Clears the storage of a set of origins in the default storage partition of
+// a session. Each storage backend gets its own queue of origins, so that the
+// backends delete concurrently instead of waiting for each other, and the
+// progress is reported while the queues drain.
+//
+// The bytes freed are measured from the quota managed usage of the origins
+// before and after the deletion, so cookies and local storage are not
+// counted.
+class BatchedStorageClearer
+    : public base::RefCountedDeleteOnSequence<BatchedStorageClearer> {
+ public:
+  struct Options {
+    Options();
+    Options(Options&&);
+    ~Options();
+
+    // Empty means every origin.
+    std::vector<url::Origin> origins;
+    uint32_t storage_mask = 0;
+    uint32_t quota_mask = 0;
+    // Runs the deletions as best effort tasks, after the work of the
+    // browser process that is visible to the user.
+    bool idle = false;
+  };
+
+  // Called with the deletions done so far and their total.
+  using ProgressCallback =
+      base::RepeatingCallback<void(size_t completed, size_t total)>;
+  // Called with absl::nullopt when the session was destroyed before the
+  // deletions were done.
+  using DoneCallback =
+      base::OnceCallback<void(absl::optional<int64_t> bytes_freed)>;
+
+  // The clearer is released once done. When the session is destroyed before
+  // that, it stops and |done_callback| runs without the bytes freed.
+  static void Start(ElectronBrowserContext* browser_context,
+                    Options options,
+                    ProgressCallback progress_callback,
+                    DoneCallback done_callback);
+
+  // disable copy
+  BatchedStorageClearer(const BatchedStorageClearer&) = delete;
+  BatchedStorageClearer& operator=(const BatchedStorageClearer&) = delete;
+
+ private:
+  friend class base::RefCountedDeleteOnSequence<BatchedStorageClearer>;
+  friend class base::DeleteHelper<BatchedStorageClearer>;
+
+  BatchedStorageClearer(ElectronBrowserContext* browser_context,
+                        Options options,
+                        ProgressCallback progress_callback,
+                        DoneCallback done_callback);
+  ~BatchedStorageClearer();
+
+  void MeasureUsage(base::OnceCallback<void(int64_t)> callback);
+  void OnUsageBeforeMeasured(int64_t usage);
+  void PostClearNext(size_t queue);
+  void ClearNext(size_t queue);
+  void OnCleared(size_t queue);
+  void OnUsageAfterMeasured(int64_t usage);
+
+  base::WeakPtr<ElectronBrowserContext> browser_context_;
+  const Options options_;
+  ProgressCallback progress_callback_;
+  DoneCallback done_callback_;
+
+  // One storage mask bit per queue, and the next origin of each queue.
+  std::vector<uint32_t> queue_masks_;
+  std::vector<size_t> next_origins_;
+  size_t running_queues_ = 0;
+  size_t completed_ = 0;
+  size_t total_ = 0;
+  int64_t usage_before_ = 0;
+  base::TimeTicks last_progress_time_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_BATCHED_STORAGE_CLEARER_H_
@@ -23,6 +23,7 @@
 #include "shell/common/application_info.h"
 #include "shell/common/electron_paths.h"
 #include "shell/common/gin_helper/arguments.h"
+#include "shell/common/startup_marks.h"
 
 namespace electron {
 
@@ -185,6 +186,7 @@ void Browser::WillFinishLaunching() {
 }
 
 void Browser::DidFinishLaunching(base::Value::Dict launch_info) {
+  AddStartupMarkOnce("Browser::DidFinishLaunching");
   // Make sure the userData directory is created.
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   base::FilePath user_data;
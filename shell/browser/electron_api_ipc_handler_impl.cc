@@ -8,9 +8,62 @@
 
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
+#include "base/trace_event/trace_event.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
+#include "shell/browser/ipc_channel_stats.h"
 
 namespace electron {
+
+namespace {
+
+void RecordIncoming(const std::string& channel,
+                    size_t bytes,
+                    const mojom::IpcMessageTiming& timing) {
+  IpcChannelStats::GetInstance()->RecordIncoming(channel, bytes, timing,
+                                                 base::TimeTicks::Now());
+}
+
+// Records an incoming message and the time spent handling it synchronously.
+class ScopedHandlerTimer {
+ public:
+  ScopedHandlerTimer(const std::string& channel,
+                     size_t bytes,
+                     const mojom::IpcMessageTiming& timing)
+      : channel_(channel), start_time_(base::TimeTicks::Now()) {
+    IpcChannelStats::GetInstance()->RecordIncoming(channel, bytes, timing,
+                                                   start_time_);
+  }
+  ~ScopedHandlerTimer() {
+    IpcChannelStats::GetInstance()->RecordHandlerTime(
+        channel_, base::TimeTicks::Now() - start_time_);
+  }
+
+  // disable copy
+  ScopedHandlerTimer(const ScopedHandlerTimer&) = delete;
+  ScopedHandlerTimer& operator=(const ScopedHandlerTimer&) = delete;
+
+ private:
+  const std::string& channel_;
+  const base::TimeTicks start_time_;
+};
+
+// Wraps the reply |callback| of an invoke or sync message so that the time
+// until the reply is recorded as the handler time of |channel|.
+template <typename Callback>
+Callback RecordHandlerTimeOnReply(const std::string& channel,
+                                  Callback callback) {
+  return base::BindOnce(
+      [](Callback callback, const std::string& channel,
+         base::TimeTicks start_time, blink::CloneableMessage result) {
+        IpcChannelStats::GetInstance()->RecordHandlerTime(
+            channel, base::TimeTicks::Now() - start_time);
+        std::move(callback).Run(std::move(result));
+      },
+      std::move(callback), channel, base::TimeTicks::Now());
+}
+
+}  // namespace
+
 ElectronApiIPCHandlerImpl::ElectronApiIPCHandlerImpl(
     content::RenderFrameHost* frame_host,
     mojo::PendingAssociatedReceiver<mojom::ElectronApiIPC> receiver)
@@ -38,7 +91,12 @@ void ElectronApiIPCHandlerImpl::OnConnectionError() {
 
 void ElectronApiIPCHandlerImpl::Message(bool internal,
                                         const std::string& channel,
-                                        blink::CloneableMessage arguments) {
+                                        blink::CloneableMessage arguments,
+                                        mojom::IpcMessageTimingPtr timing) {
+  TRACE_EVENT_WITH_FLOW1("electron.ipc", "ElectronApiIPC::Message",
+                         TRACE_ID_GLOBAL(timing->trace_id),
+                         TRACE_EVENT_FLAG_FLOW_IN, "channel", channel);
+  ScopedHandlerTimer timer(channel, arguments.encoded_message.size(), *timing);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->Message(internal, channel, std::move(arguments),
@@ -48,17 +106,29 @@ void ElectronApiIPCHandlerImpl::Message(bool internal,
 void ElectronApiIPCHandlerImpl::Invoke(bool internal,
                                        const std::string& channel,
                                        blink::CloneableMessage arguments,
+                                       mojom::IpcMessageTimingPtr timing,
                                        InvokeCallback callback) {
+  TRACE_EVENT_WITH_FLOW1("electron.ipc", "ElectronApiIPC::Invoke",
+                         TRACE_ID_GLOBAL(timing->trace_id),
+                         TRACE_EVENT_FLAG_FLOW_IN, "channel", channel);
+  RecordIncoming(channel, arguments.encoded_message.size(), *timing);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
-    api_web_contents->Invoke(internal, channel, std::move(arguments),
-                             std::move(callback), GetRenderFrameHost());
+    api_web_contents->Invoke(
+        internal, channel, std::move(arguments),
+        RecordHandlerTimeOnReply(channel, std::move(callback)),
+        GetRenderFrameHost());
   }
 }
 
 void ElectronApiIPCHandlerImpl::ReceivePostMessage(
     const std::string& channel,
-    blink::TransferableMessage message) {
+    blink::TransferableMessage message,
+    mojom::IpcMessageTimingPtr timing) {
+  TRACE_EVENT_WITH_FLOW1("electron.ipc", "ElectronApiIPC::ReceivePostMessage",
+                         TRACE_ID_GLOBAL(timing->trace_id),
+                         TRACE_EVENT_FLAG_FLOW_IN, "channel", channel);
+  ScopedHandlerTimer timer(channel, message.encoded_message.size(), *timing);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->ReceivePostMessage(channel, std::move(message),
@@ -69,17 +139,29 @@ void ElectronApiIPCHandlerImpl::ReceivePostMessage(
 void ElectronApiIPCHandlerImpl::MessageSync(bool internal,
                                             const std::string& channel,
                                             blink::CloneableMessage arguments,
+                                            mojom::IpcMessageTimingPtr timing,
                                             MessageSyncCallback callback) {
+  TRACE_EVENT_WITH_FLOW1("electron.ipc", "ElectronApiIPC::MessageSync",
+                         TRACE_ID_GLOBAL(timing->trace_id),
+                         TRACE_EVENT_FLAG_FLOW_IN, "channel", channel);
+  RecordIncoming(channel, arguments.encoded_message.size(), *timing);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
-    api_web_contents->MessageSync(internal, channel, std::move(arguments),
-                                  std::move(callback), GetRenderFrameHost());
+    api_web_contents->MessageSync(
+        internal, channel, std::move(arguments),
+        RecordHandlerTimeOnReply(channel, std::move(callback)),
+        GetRenderFrameHost());
   }
 }
 
 void ElectronApiIPCHandlerImpl::MessageTo(int32_t web_contents_id,
                                           const std::string& channel,
-                                          blink::CloneableMessage arguments) {
+                                          blink::CloneableMessage arguments,
+                                          mojom::IpcMessageTimingPtr timing) {
+  TRACE_EVENT_WITH_FLOW1("electron.ipc", "ElectronApiIPC::MessageTo",
+                         TRACE_ID_GLOBAL(timing->trace_id),
+                         TRACE_EVENT_FLAG_FLOW_IN, "channel", channel);
+  ScopedHandlerTimer timer(channel, arguments.encoded_message.size(), *timing);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->MessageTo(web_contents_id, channel, std::move(arguments));
@@ -87,7 +169,12 @@ void ElectronApiIPCHandlerImpl::MessageTo(int32_t web_contents_id,
 }
 
 void ElectronApiIPCHandlerImpl::MessageHost(const std::string& channel,
-                                            blink::CloneableMessage arguments) {
+                                            blink::CloneableMessage arguments,
+                                            mojom::IpcMessageTimingPtr timing) {
+  TRACE_EVENT_WITH_FLOW1("electron.ipc", "ElectronApiIPC::MessageHost",
+                         TRACE_ID_GLOBAL(timing->trace_id),
+                         TRACE_EVENT_FLAG_FLOW_IN, "channel", channel);
+  ScopedHandlerTimer timer(channel, arguments.encoded_message.size(), *timing);
   api::WebContents* api_web_contents = api::WebContents::From(web_contents());
   if (api_web_contents) {
     api_web_contents->MessageHost(channel, std::move(arguments),
@@ -38,22 +38,28 @@ class ElectronApiIPCHandlerImpl : public mojom::ElectronApiIPC,
   // mojom::ElectronApiIPC:
   void Message(bool internal,
                const std::string& channel,
-               blink::CloneableMessage arguments) override;
+               blink::CloneableMessage arguments,
+               mojom::IpcMessageTimingPtr timing) override;
   void Invoke(bool internal,
               const std::string& channel,
               blink::CloneableMessage arguments,
+              mojom::IpcMessageTimingPtr timing,
               InvokeCallback callback) override;
   void ReceivePostMessage(const std::string& channel,
-                          blink::TransferableMessage message) override;
+                          blink::TransferableMessage message,
+                          mojom::IpcMessageTimingPtr timing) override;
   void MessageSync(bool internal,
                    const std::string& channel,
                    blink::CloneableMessage arguments,
+                   mojom::IpcMessageTimingPtr timing,
                    MessageSyncCallback callback) override;
   void MessageTo(int32_t web_contents_id,
                  const std::string& channel,
-                 blink::CloneableMessage arguments) override;
+                 blink::CloneableMessage arguments,
+                 mojom::IpcMessageTimingPtr timing) override;
   void MessageHost(const std::string& channel,
-                   blink::CloneableMessage arguments) override;
+                   blink::CloneableMessage arguments,
+                   mojom::IpcMessageTimingPtr timing) override;
 
   base::WeakPtr<ElectronApiIPCHandlerImpl> GetWeakPtr() {
     return weak_factory_.GetWeakPtr();
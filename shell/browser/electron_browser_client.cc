@@ -101,6 +101,7 @@
 #include "shell/browser/protocol_registry.h"
 #include "shell/browser/serial/electron_serial_delegate.h"
 #include "shell/browser/session_preferences.h"
+#include "shell/browser/spare_renderer_pool.h"
 #include "shell/browser/ui/devtools_manager_delegate.h"
 #include "shell/browser/web_contents_permission_helper.h"
 #include "shell/browser/web_contents_preferences.h"
@@ -579,6 +580,11 @@ void ElectronBrowserClient::AppendExtraCommandLineSwitches(
       if (web_preferences)
         web_preferences->AppendCommandLineSwitches(
             command_line, IsRendererSubFrame(process_id));
+    } else if (auto* host = content::RenderProcessHost::FromID(process_id)) {
+      // Spare renderers don't have a WebContents yet.
+      if (auto* spare_renderer_pool =
+              SpareRendererPool::FromBrowserContext(host->GetBrowserContext()))
+        spare_renderer_pool->AppendSwitchesForSpare(process_id, command_line);
     }
   }
 }
@@ -604,10 +610,15 @@ ElectronBrowserClient::GetGeneratedCodeCacheSettings(
     content::BrowserContext* context) {
   // TODO(deepak1556): Use platform cache directory.
   base::FilePath cache_path = context->GetPath();
+  auto* browser_context = static_cast<ElectronBrowserContext*>(context);
   // If we pass 0 for size, disk_cache will pick a default size using the
   // heuristics based on available disk size. These are implemented in
   // disk_cache::PreferredCacheSize in net/disk_cache/cache_util.cc.
-  return content::GeneratedCodeCacheSettings(true, 0, cache_path);
+  // V8 keeps the code it compiles in memory, so a session with its code cache
+  // in memory only needs to not write one to disk.
+  return content::GeneratedCodeCacheSettings(
+      !browser_context->IsCodeCacheInMemory(),
+      browser_context->GetMaxCodeCacheSize(), cache_path);
 }
 
 void ElectronBrowserClient::AllowCertificateError(
@@ -789,6 +800,16 @@ bool ElectronBrowserClient::ShouldUseProcessPerSite(
 #endif
 }
 
+bool ElectronBrowserClient::ShouldUseSpareRenderProcessHost(
+    content::BrowserContext* browser_context,
+    const GURL& site_url) {
+  if (auto* spare_renderer_pool =
+          SpareRendererPool::FromBrowserContext(browser_context))
+    return spare_renderer_pool->ShouldUseSpare();
+  return content::ContentBrowserClient::ShouldUseSpareRenderProcessHost(
+      browser_context, site_url);
+}
+
 bool ElectronBrowserClient::ArePersistentMediaDeviceIDsAllowed(
     content::BrowserContext* browser_context,
     const GURL& scope,
@@ -4,6 +4,7 @@
 
 #include "shell/browser/electron_browser_context.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <utility>
@@ -13,6 +14,7 @@
 #include "base/command_line.h"
 #include "base/files/file_path.h"
 #include "base/no_destructor.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/path_service.h"
 #include "base/strings/escape.h"
 #include "base/strings/string_util.h"
@@ -123,6 +125,15 @@ ElectronBrowserContext::ElectronBrowserContext(const std::string& partition,
 
   base::StringToInt(command_line->GetSwitchValueASCII(switches::kDiskCacheSize),
                     &max_cache_size_);
+  // A size of 0 lets disk_cache pick one from the available disk space.
+  if (auto cache_size = options.FindDouble("cacheSize"))
+    max_cache_size_ = base::saturated_cast<int>(std::max(*cache_size, 0.0));
+  cache_in_memory_ = options.FindBool("cacheInMemory").value_or(false);
+  if (auto code_cache_size = options.FindDouble("codeCacheSize")) {
+    max_code_cache_size_ =
+        base::saturated_cast<int>(std::max(*code_cache_size, 0.0));
+  }
+  code_cache_in_memory_ = options.FindBool("codeCacheInMemory").value_or(false);
 
   base::PathService::Get(DIR_SESSION_DATA, &path_);
   if (!in_memory && !partition.empty())
@@ -254,6 +265,19 @@ int ElectronBrowserContext::GetMaxCacheSize() const {
   return max_cache_size_;
 }
 
+base::FilePath ElectronBrowserContext::GetCodeCachePath() const {
+  if (!code_cache_path_.empty())
+    return code_cache_path_;
+  return path_.AppendASCII("Code Cache");
+}
+
+void ElectronBrowserContext::RecordHttpCacheLoad(bool was_cached) {
+  if (was_cached)
+    ++http_cache_hits_;
+  else
+    ++http_cache_misses_;
+}
+
 content::ResourceContext* ElectronBrowserContext::GetResourceContext() {
   if (!resource_context_)
     resource_context_ = std::make_unique<content::ResourceContext>();
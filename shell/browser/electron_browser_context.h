@@ -106,6 +106,18 @@ class ElectronBrowserContext : public content::BrowserContext {
   std::string GetUserAgent() const;
   bool CanUseHttpCache() const;
   int GetMaxCacheSize() const;
+  bool IsHttpCacheInMemory() const { return cache_in_memory_; }
+  int GetMaxCodeCacheSize() const { return max_code_cache_size_; }
+  bool IsCodeCacheInMemory() const { return code_cache_in_memory_; }
+  base::FilePath GetCodeCachePath() const;
+  void set_code_cache_path(const base::FilePath& path) {
+    code_cache_path_ = path;
+  }
+  // Counts the loads of the pages of this session by whether the HTTP cache
+  // served them.
+  void RecordHttpCacheLoad(bool was_cached);
+  uint64_t http_cache_hits() const { return http_cache_hits_; }
+  uint64_t http_cache_misses() const { return http_cache_misses_; }
   ResolveProxyHelper* GetResolveProxyHelper();
   predictors::PreconnectManager* GetPreconnectManager();
   scoped_refptr<network::SharedURLLoaderFactory> GetURLLoaderFactory();
@@ -224,6 +236,12 @@ class ElectronBrowserContext : public content::BrowserContext {
   bool in_memory_ = false;
   bool use_cache_ = true;
   int max_cache_size_ = 0;
+  bool cache_in_memory_ = false;
+  int max_code_cache_size_ = 0;
+  bool code_cache_in_memory_ = false;
+  base::FilePath code_cache_path_;
+  uint64_t http_cache_hits_ = 0;
+  uint64_t http_cache_misses_ = 0;
 
 #if BUILDFLAG(ENABLE_ELECTRON_EXTENSIONS)
   // Owned by the KeyedService system.
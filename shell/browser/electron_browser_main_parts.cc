@@ -61,6 +61,7 @@
 #include "shell/common/logging.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_marks.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
 #include "ui/base/idle/idle.h"
 #include "ui/base/l10n/l10n_util.h"
@@ -241,6 +242,8 @@ int ElectronBrowserMainParts::GetExitCode() const {
 }
 
 int ElectronBrowserMainParts::PreEarlyInitialization() {
+  ScopedStartupPhase startup_phase(
+      "ElectronBrowserMainParts::PreEarlyInitialization");
   field_trial_list_ = std::make_unique<base::FieldTrialList>();
 #if BUILDFLAG(IS_POSIX)
   HandleSIGCHLD();
@@ -260,6 +263,8 @@ int ElectronBrowserMainParts::PreEarlyInitialization() {
 }
 
 void ElectronBrowserMainParts::PostEarlyInitialization() {
+  ScopedStartupPhase startup_phase(
+      "ElectronBrowserMainParts::PostEarlyInitialization");
   // A workaround was previously needed because there was no ThreadTaskRunner
   // set.  If this check is failing we may need to re-add that workaround
   DCHECK(base::ThreadTaskRunnerHandle::IsSet());
@@ -313,6 +318,8 @@ void ElectronBrowserMainParts::PostEarlyInitialization() {
 }
 
 int ElectronBrowserMainParts::PreCreateThreads() {
+  ScopedStartupPhase startup_phase(
+      "ElectronBrowserMainParts::PreCreateThreads");
   if (!views::LayoutProvider::Get()) {
     layout_provider_ = std::make_unique<views::LayoutProvider>();
   }
@@ -394,6 +401,8 @@ int ElectronBrowserMainParts::PreCreateThreads() {
 }
 
 void ElectronBrowserMainParts::PostCreateThreads() {
+  ScopedStartupPhase startup_phase(
+      "ElectronBrowserMainParts::PostCreateThreads");
   content::GetIOThreadTaskRunner({})->PostTask(
       FROM_HERE,
       base::BindOnce(&tracing::TracingSamplerProfiler::CreateOnChildThread));
@@ -424,6 +433,8 @@ void ElectronBrowserMainParts::PostDestroyThreads() {
 }
 
 void ElectronBrowserMainParts::ToolkitInitialized() {
+  ScopedStartupPhase startup_phase(
+      "ElectronBrowserMainParts::ToolkitInitialized");
 #if BUILDFLAG(IS_LINUX)
   auto* linux_ui = ui::GetDefaultLinuxUi();
   CHECK(linux_ui);
@@ -474,6 +485,8 @@ void ElectronBrowserMainParts::ToolkitInitialized() {
 }
 
 int ElectronBrowserMainParts::PreMainMessageLoopRun() {
+  ScopedStartupPhase startup_phase(
+      "ElectronBrowserMainParts::PreMainMessageLoopRun");
   // Run user's main script before most things get initialized, so we can have
   // a chance to setup everything.
   node_bindings_->PrepareEmbedThread();
@@ -536,6 +549,8 @@ void ElectronBrowserMainParts::WillRunMainMessageLoop(
 }
 
 void ElectronBrowserMainParts::PostCreateMainMessageLoop() {
+  ScopedStartupPhase startup_phase(
+      "ElectronBrowserMainParts::PostCreateMainMessageLoop");
 #if BUILDFLAG(IS_LINUX) || BUILDFLAG(IS_MAC)
   std::string app_name = electron::Browser::Get()->GetName();
 #endif
@@ -643,6 +658,8 @@ void ElectronBrowserMainParts::PostMainMessageLoopRun() {
 
 #if !BUILDFLAG(IS_MAC)
 void ElectronBrowserMainParts::PreCreateMainMessageLoop() {
+  ScopedStartupPhase startup_phase(
+      "ElectronBrowserMainParts::PreCreateMainMessageLoop");
   PreCreateMainMessageLoopCommon();
 }
 #endif
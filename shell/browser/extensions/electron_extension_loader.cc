@@ -4,9 +4,11 @@
 
 #include "shell/browser/extensions/electron_extension_loader.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/auto_reset.h"
+#include "base/barrier_callback.h"
 #include "base/bind.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
@@ -15,15 +17,17 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/sequenced_task_runner.h"
 #include "base/task/task_runner_util.h"
+#include "base/task/thread_pool.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/time/time.h"
-#include "extensions/browser/extension_file_task_runner.h"
+#include "content/public/browser/browser_context.h"
 #include "extensions/browser/extension_prefs.h"
 #include "extensions/browser/extension_registry.h"
 #include "extensions/browser/pref_names.h"
 #include "extensions/common/error_utils.h"
 #include "extensions/common/file_util.h"
 #include "extensions/common/manifest_constants.h"
+#include "shell/browser/extensions/electron_extension_metadata_cache.h"
 
 namespace extensions {
 
@@ -31,13 +35,17 @@ using LoadErrorBehavior = ExtensionRegistrar::LoadErrorBehavior;
 
 namespace {
 
-std::pair<scoped_refptr<const Extension>, std::string> LoadUnpacked(
-    const base::FilePath& extension_dir,
-    int load_flags) {
+using LoadResult = std::pair<scoped_refptr<const Extension>, std::string>;
+
+LoadResult LoadUnpacked(const base::FilePath& extension_dir,
+                        int load_flags,
+                        const base::FilePath& cache_dir) {
   // app_shell only supports unpacked extensions.
   // NOTE: If you add packed extension support consider removing the flag
   // FOLLOW_SYMLINKS_ANYWHERE below. Packed extensions should not have symlinks.
+  ElectronExtensionMetadataCache cache(cache_dir);
   if (!base::DirectoryExists(extension_dir)) {
+    cache.Remove(extension_dir);
     std::string err = "Extension directory not found: " +
                       base::UTF16ToUTF8(extension_dir.LossyDisplayName());
     return std::make_pair(nullptr, err);
@@ -52,11 +60,22 @@ std::pair<scoped_refptr<const Extension>, std::string> LoadUnpacked(
     base::DeletePathRecursively(metadata_dir);
   }
 
+  // The fingerprint is taken before loading, so that changes made while
+  // loading invalidate the entry.
+  std::string fingerprint =
+      ElectronExtensionMetadataCache::GetFingerprint(extension_dir);
+  std::string cached_warnings;
+  scoped_refptr<const Extension> cached_extension =
+      cache.Load(extension_dir, load_flags, fingerprint, &cached_warnings);
+  if (cached_extension)
+    return std::make_pair(cached_extension, cached_warnings);
+
   std::string load_error;
   scoped_refptr<Extension> extension = file_util::LoadExtension(
       extension_dir, extensions::mojom::ManifestLocation::kCommandLine,
       load_flags, &load_error);
   if (!extension.get()) {
+    cache.Remove(extension_dir);
     std::string err = "Loading extension at " +
                       base::UTF16ToUTF8(extension_dir.LossyDisplayName()) +
                       " failed with: " + load_error;
@@ -88,9 +107,24 @@ std::pair<scoped_refptr<const Extension>, std::string> LoadUnpacked(
     }
   }
 
+  cache.Store(*extension, load_flags, fingerprint, warnings);
   return std::make_pair(extension, warnings);
 }
 
+void RemoveCachedMetadata(const base::FilePath& extension_dir,
+                          const base::FilePath& cache_dir) {
+  ElectronExtensionMetadataCache(cache_dir).Remove(extension_dir);
+}
+
+std::pair<size_t, LoadResult> LoadUnpackedAt(
+    size_t index,
+    const base::FilePath& extension_dir,
+    int load_flags,
+    const base::FilePath& cache_dir) {
+  return std::make_pair(index,
+                        LoadUnpacked(extension_dir, load_flags, cache_dir));
+}
+
 }  // namespace
 
 ElectronExtensionLoader::ElectronExtensionLoader(
@@ -105,12 +139,38 @@ void ElectronExtensionLoader::LoadExtension(
     int load_flags,
     base::OnceCallback<void(const Extension*, const std::string&)> cb) {
   base::PostTaskAndReplyWithResult(
-      GetExtensionFileTaskRunner().get(), FROM_HERE,
-      base::BindOnce(&LoadUnpacked, extension_dir, load_flags),
+      GetTaskRunnerFor(extension_dir).get(), FROM_HERE,
+      base::BindOnce(&LoadUnpacked, extension_dir, load_flags,
+                     GetMetadataCacheDir()),
       base::BindOnce(&ElectronExtensionLoader::FinishExtensionLoad,
                      weak_factory_.GetWeakPtr(), std::move(cb)));
 }
 
+void ElectronExtensionLoader::LoadExtensions(
+    const std::vector<base::FilePath>& extension_dirs,
+    int load_flags,
+    LoadExtensionsCallback cb) {
+  if (extension_dirs.empty()) {
+    std::move(cb).Run({}, std::string(), std::string());
+    return;
+  }
+
+  // The extensions are read in parallel, each on the sequence of its
+  // directory, so that they are ordered with the other loads, reloads and
+  // cache updates of the same directory.
+  auto barrier = base::BarrierCallback<std::pair<size_t, LoadResult>>(
+      extension_dirs.size(),
+      base::BindOnce(&ElectronExtensionLoader::FinishExtensionsLoad,
+                     weak_factory_.GetWeakPtr(), std::move(cb)));
+  for (size_t i = 0; i < extension_dirs.size(); i++) {
+    base::PostTaskAndReplyWithResult(
+        GetTaskRunnerFor(extension_dirs[i]).get(), FROM_HERE,
+        base::BindOnce(&LoadUnpackedAt, i, extension_dirs[i], load_flags,
+                       GetMetadataCacheDir()),
+        barrier);
+  }
+}
+
 void ElectronExtensionLoader::ReloadExtension(const ExtensionId& extension_id) {
   const Extension* extension = ExtensionRegistry::Get(browser_context_)
                                    ->GetInstalledExtension(extension_id);
@@ -130,6 +190,16 @@ void ElectronExtensionLoader::ReloadExtension(const ExtensionId& extension_id) {
 void ElectronExtensionLoader::UnloadExtension(
     const ExtensionId& extension_id,
     extensions::UnloadedExtensionReason reason) {
+  // The metadata of a removed extension is not kept around, its directory may
+  // be deleted next.
+  const Extension* extension = ExtensionRegistry::Get(browser_context_)
+                                   ->GetInstalledExtension(extension_id);
+  if (extension && reason == extensions::UnloadedExtensionReason::UNINSTALL) {
+    GetTaskRunnerFor(extension->path())
+        ->PostTask(FROM_HERE,
+                   base::BindOnce(&RemoveCachedMetadata, extension->path(),
+                                  GetMetadataCacheDir()));
+  }
   extension_registrar_.RemoveExtension(extension_id, reason);
 }
 
@@ -137,27 +207,75 @@ void ElectronExtensionLoader::FinishExtensionLoad(
     base::OnceCallback<void(const Extension*, const std::string&)> cb,
     std::pair<scoped_refptr<const Extension>, std::string> result) {
   scoped_refptr<const Extension> extension = result.first;
-  if (extension) {
-    extension_registrar_.AddExtension(extension);
+  if (extension)
+    AddLoadedExtension(extension);
 
-    // Write extension install time to ExtensionPrefs. This is required by
-    // WebRequestAPI which calls extensions::ExtensionPrefs::GetInstallTime.
-    //
-    // Implementation for writing the pref was based on
-    // PreferenceAPIBase::SetExtensionControlledPref.
-    {
-      ExtensionPrefs* extension_prefs = ExtensionPrefs::Get(browser_context_);
-      ExtensionPrefs::ScopedDictionaryUpdate update(
-          extension_prefs, extension.get()->id(),
-          extensions::pref_names::kPrefPreferences);
-      auto preference = update.Create();
-      const base::Time install_time = base::Time::Now();
-      preference->SetString(
-          "install_time", base::NumberToString(install_time.ToInternalValue()));
-    }
+  std::move(cb).Run(extension.get(), result.second);
+}
+
+void ElectronExtensionLoader::FinishExtensionsLoad(
+    LoadExtensionsCallback cb,
+    std::vector<std::pair<size_t, LoadResult>> results) {
+  // The results arrive in the order the loads finished.
+  std::sort(results.begin(), results.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::string errors;
+  std::string warnings;
+  for (const auto& [index, result] : results) {
+    if (!result.first)
+      errors += result.second + "\n";
+    else if (!result.second.empty())
+      warnings += result.second;
+  }
+  if (!errors.empty()) {
+    errors.pop_back();
+    std::move(cb).Run({}, std::string(), errors);
+    return;
   }
 
-  std::move(cb).Run(extension.get(), result.second);
+  std::vector<const Extension*> extensions;
+  for (const auto& [index, result] : results) {
+    AddLoadedExtension(result.first);
+    extensions.push_back(result.first.get());
+  }
+  std::move(cb).Run(extensions, warnings, std::string());
+}
+
+void ElectronExtensionLoader::AddLoadedExtension(
+    scoped_refptr<const Extension> extension) {
+  extension_registrar_.AddExtension(extension);
+
+  // Write extension install time to ExtensionPrefs. This is required by
+  // WebRequestAPI which calls extensions::ExtensionPrefs::GetInstallTime.
+  //
+  // Implementation for writing the pref was based on
+  // PreferenceAPIBase::SetExtensionControlledPref.
+  ExtensionPrefs* extension_prefs = ExtensionPrefs::Get(browser_context_);
+  ExtensionPrefs::ScopedDictionaryUpdate update(
+      extension_prefs, extension.get()->id(),
+      extensions::pref_names::kPrefPreferences);
+  auto preference = update.Create();
+  const base::Time install_time = base::Time::Now();
+  preference->SetString("install_time",
+                        base::NumberToString(install_time.ToInternalValue()));
+}
+
+scoped_refptr<base::SequencedTaskRunner>
+ElectronExtensionLoader::GetTaskRunnerFor(const base::FilePath& extension_dir) {
+  scoped_refptr<base::SequencedTaskRunner>& task_runner =
+      task_runners_[extension_dir];
+  if (!task_runner) {
+    task_runner = base::ThreadPool::CreateSequencedTaskRunner(
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  }
+  return task_runner;
+}
+
+base::FilePath ElectronExtensionLoader::GetMetadataCacheDir() const {
+  return browser_context_->GetPath().Append(
+      FILE_PATH_LITERAL("Extension Metadata Cache"));
 }
 
 void ElectronExtensionLoader::FinishExtensionReload(
@@ -207,8 +325,8 @@ void ElectronExtensionLoader::LoadExtensionForReload(
   // extension will cause the file access permission to be dropped.
   int load_flags = Extension::FOLLOW_SYMLINKS_ANYWHERE;
   base::PostTaskAndReplyWithResult(
-      GetExtensionFileTaskRunner().get(), FROM_HERE,
-      base::BindOnce(&LoadUnpacked, path, load_flags),
+      GetTaskRunnerFor(path).get(), FROM_HERE,
+      base::BindOnce(&LoadUnpacked, path, load_flags, GetMetadataCacheDir()),
       base::BindOnce(&ElectronExtensionLoader::FinishExtensionReload,
                      weak_factory_.GetWeakPtr(), extension_id));
   did_schedule_reload_ = true;
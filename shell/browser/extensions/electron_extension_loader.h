@@ -5,17 +5,20 @@
 #ifndef ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_EXTENSION_LOADER_H_
 #define ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_EXTENSION_LOADER_H_
 
+#include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/callback.h"
+#include "base/files/file_path.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "extensions/browser/extension_registrar.h"
 #include "extensions/common/extension_id.h"
 
 namespace base {
-class FilePath;
+class SequencedTaskRunner;
 }
 
 namespace content {
@@ -26,6 +29,11 @@ namespace extensions {
 
 class Extension;
 
+using LoadExtensionsCallback =
+    base::OnceCallback<void(const std::vector<const Extension*>& extensions,
+                            const std::string& warnings,
+                            const std::string& error)>;
+
 // Handles extension loading and reloading using ExtensionRegistrar.
 class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
  public:
@@ -43,6 +51,13 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
                      base::OnceCallback<void(const Extension* extension,
                                              const std::string&)> cb);
 
+  // Loads unpacked extensions from directories, and adds all of them at once
+  // after they loaded. When any of them fails to load, none is added and |cb|
+  // gets the errors.
+  void LoadExtensions(const std::vector<base::FilePath>& extension_dirs,
+                      int load_flags,
+                      LoadExtensionsCallback cb);
+
   // Starts reloading the extension. A keep-alive is maintained until the
   // reload succeeds/fails. If the extension is an app, it will be launched upon
   // reloading.
@@ -66,6 +81,22 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
       base::OnceCallback<void(const Extension*, const std::string&)> cb,
       std::pair<scoped_refptr<const Extension>, std::string> result);
 
+  void FinishExtensionsLoad(
+      LoadExtensionsCallback cb,
+      std::vector<std::pair<size_t,
+                            std::pair<scoped_refptr<const Extension>,
+                                      std::string>>> results);
+
+  void AddLoadedExtension(scoped_refptr<const Extension> extension);
+
+  // Returns the sequence on which the files and the cached metadata of
+  // |extension_dir| are accessed. Different directories use different
+  // sequences, so they are loaded in parallel.
+  scoped_refptr<base::SequencedTaskRunner> GetTaskRunnerFor(
+      const base::FilePath& extension_dir);
+
+  base::FilePath GetMetadataCacheDir() const;
+
   // ExtensionRegistrar::Delegate:
   void PreAddExtension(const Extension* extension,
                        const Extension* old_extension) override;
@@ -93,6 +124,9 @@ class ElectronExtensionLoader : public ExtensionRegistrar::Delegate {
   // LoadExtensionForReload().
   bool did_schedule_reload_ = false;
 
+  std::map<base::FilePath, scoped_refptr<base::SequencedTaskRunner>>
+      task_runners_;
+
   base::WeakPtrFactory<ElectronExtensionLoader> weak_factory_{this};
 };
 
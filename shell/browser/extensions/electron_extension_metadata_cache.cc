@@ -0,0 +1,149 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/extensions/electron_extension_metadata_cache.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/files/important_file_writer.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "components/version_info/version_info.h"
+#include "crypto/sha2.h"
+#include "extensions/common/extension.h"
+#include "extensions/common/extension_l10n_util.h"
+#include "extensions/common/manifest.h"
+
+namespace extensions {
+
+namespace {
+
+// Bump when the format of the entries changes.
+constexpr int kCacheVersion = 1;
+
+// Entries larger than this are not read.
+constexpr int64_t kMaxEntrySize = 4 * 1024 * 1024;
+
+}  // namespace
+
+ElectronExtensionMetadataCache::ElectronExtensionMetadataCache(
+    const base::FilePath& cache_dir)
+    : cache_dir_(cache_dir) {}
+
+ElectronExtensionMetadataCache::~ElectronExtensionMetadataCache() = default;
+
+// static
+std::string ElectronExtensionMetadataCache::GetFingerprint(
+    const base::FilePath& extension_dir) {
+  // Only the metadata of the files is read, which is much cheaper than
+  // parsing and validating the extension.
+  std::vector<std::string> entries;
+  base::FileEnumerator enumerator(
+      extension_dir, true,
+      base::FileEnumerator::FILES | base::FileEnumerator::DIRECTORIES);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    base::FileEnumerator::FileInfo info = enumerator.GetInfo();
+    std::string entry = path.AsUTF8Unsafe();
+    entry += '\0';
+    entry += base::NumberToString(info.GetSize());
+    entry += '\0';
+    entry += base::NumberToString(
+        info.GetLastModifiedTime().ToDeltaSinceWindowsEpoch().InMicroseconds());
+    entries.push_back(std::move(entry));
+  }
+  // The order of the enumeration is not specified.
+  std::sort(entries.begin(), entries.end());
+
+  // The manifest is localized for the current locale.
+  std::string data = version_info::GetVersionNumber() + '\n' +
+                     extension_l10n_util::CurrentLocaleOrDefault();
+  for (const std::string& entry : entries) {
+    data += '\n';
+    data += entry;
+  }
+  return base::HexEncode(crypto::SHA256HashString(data).data(),
+                         crypto::kSHA256Length);
+}
+
+scoped_refptr<Extension> ElectronExtensionMetadataCache::Load(
+    const base::FilePath& extension_dir,
+    int load_flags,
+    const std::string& fingerprint,
+    std::string* warnings) {
+  std::string contents;
+  if (!base::ReadFileToStringWithMaxSize(GetEntryPath(extension_dir),
+                                         &contents, kMaxEntrySize))
+    return nullptr;
+
+  absl::optional<base::Value> value = base::JSONReader::Read(contents);
+  if (!value || !value->is_dict())
+    return nullptr;
+  const base::Value::Dict& entry = value->GetDict();
+  const std::string* path = entry.FindString("path");
+  const std::string* entry_fingerprint = entry.FindString("fingerprint");
+  const std::string* entry_warnings = entry.FindString("warnings");
+  const base::Value::Dict* manifest = entry.FindDict("manifest");
+  if (entry.FindInt("version") != kCacheVersion ||
+      entry.FindInt("loadFlags") != load_flags || !path ||
+      *path != extension_dir.AsUTF8Unsafe() || !entry_fingerprint ||
+      *entry_fingerprint != fingerprint || !entry_warnings || !manifest)
+    return nullptr;
+
+  // The manifest is already localized, and the files it references were
+  // validated when the entry was stored.
+  std::string error;
+  scoped_refptr<Extension> extension =
+      Extension::Create(extension_dir, mojom::ManifestLocation::kCommandLine,
+                        *manifest, load_flags, &error);
+  if (!extension) {
+    LOG(WARNING) << "Ignoring the cached manifest of "
+                 << extension_dir.value() << ": " << error;
+    return nullptr;
+  }
+  *warnings = *entry_warnings;
+  return extension;
+}
+
+void ElectronExtensionMetadataCache::Store(const Extension& extension,
+                                           int load_flags,
+                                           const std::string& fingerprint,
+                                           const std::string& warnings) {
+  base::Value::Dict entry;
+  entry.Set("version", kCacheVersion);
+  entry.Set("loadFlags", load_flags);
+  entry.Set("path", extension.path().AsUTF8Unsafe());
+  entry.Set("fingerprint", fingerprint);
+  entry.Set("warnings", warnings);
+  entry.Set("manifest", extension.manifest()->value()->Clone());
+
+  std::string contents;
+  if (!base::JSONWriter::Write(base::Value(std::move(entry)), &contents))
+    return;
+  if (!base::CreateDirectory(cache_dir_))
+    return;
+  base::ImportantFileWriter::WriteFileAtomically(
+      GetEntryPath(extension.path()), contents);
+}
+
+void ElectronExtensionMetadataCache::Remove(
+    const base::FilePath& extension_dir) {
+  base::DeleteFile(GetEntryPath(extension_dir));
+}
+
+base::FilePath ElectronExtensionMetadataCache::GetEntryPath(
+    const base::FilePath& extension_dir) const {
+  std::string hash = crypto::SHA256HashString(extension_dir.AsUTF8Unsafe());
+  return cache_dir_.AppendASCII(
+      base::HexEncode(hash.data(), hash.size()) + ".json");
+}
+
+}  // namespace extensions
@@ -0,0 +1,65 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_EXTENSION_METADATA_CACHE_H_
+#define ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_EXTENSION_METADATA_CACHE_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+
+namespace extensions {
+
+class Extension;
+
+// Persists the localized and validated manifest of unpacked extensions, so
+// that loading an extension that did not change since the previous launch
+// does not read its manifest and message catalogs or check its files again.
+//
+// An entry is keyed by the extension directory and only used when the
+// fingerprint of the directory, made from the path, size and modification time
+// of each file, still matches. All methods block and must be called on a
+// sequence that may block.
+class ElectronExtensionMetadataCache {
+ public:
+  explicit ElectronExtensionMetadataCache(const base::FilePath& cache_dir);
+  ~ElectronExtensionMetadataCache();
+
+  // disable copy
+  ElectronExtensionMetadataCache(const ElectronExtensionMetadataCache&) =
+      delete;
+  ElectronExtensionMetadataCache& operator=(
+      const ElectronExtensionMetadataCache&) = delete;
+
+  // Returns the fingerprint of the files in |extension_dir|.
+  static std::string GetFingerprint(const base::FilePath& extension_dir);
+
+  // Returns the extension created from the cached manifest and sets
+  // |warnings| to the warnings of the original load, or returns nullptr when
+  // there is no entry for |extension_dir| matching |fingerprint|.
+  scoped_refptr<Extension> Load(const base::FilePath& extension_dir,
+                                int load_flags,
+                                const std::string& fingerprint,
+                                std::string* warnings);
+
+  // Saves the manifest of an extension that was loaded from its files, with
+  // the fingerprint taken before loading it.
+  void Store(const Extension& extension,
+             int load_flags,
+             const std::string& fingerprint,
+             const std::string& warnings);
+
+  // Deletes the entry of |extension_dir|, if any.
+  void Remove(const base::FilePath& extension_dir);
+
+ private:
+  base::FilePath GetEntryPath(const base::FilePath& extension_dir) const;
+
+  base::FilePath cache_dir_;
+};
+
+}  // namespace extensions
+
+#endif  // ELECTRON_SHELL_BROWSER_EXTENSIONS_ELECTRON_EXTENSION_METADATA_CACHE_H_
@@ -73,6 +73,15 @@ void ElectronExtensionSystem::LoadExtension(
   extension_loader_->LoadExtension(extension_dir, load_flags, std::move(cb));
 }
 
+void ElectronExtensionSystem::LoadExtensions(
+    const std::vector<base::FilePath>& extension_dirs,
+    int load_flags,
+    base::OnceCallback<void(const std::vector<const Extension*>&,
+                            const std::string&,
+                            const std::string&)> cb) {
+  extension_loader_->LoadExtensions(extension_dirs, load_flags, std::move(cb));
+}
+
 void ElectronExtensionSystem::FinishInitialization() {
   // Inform the rest of the extensions system to start.
   ready_.Signal();
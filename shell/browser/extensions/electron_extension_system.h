@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/memory/ref_counted.h"
@@ -48,6 +49,16 @@ class ElectronExtensionSystem : public ExtensionSystem {
       int load_flags,
       base::OnceCallback<void(const Extension*, const std::string&)> cb);
 
+  // Loads unpacked extensions from directories in parallel and adds them
+  // together. Runs |cb| with the extensions and their warnings, or with the
+  // errors when any of them failed to load.
+  void LoadExtensions(
+      const std::vector<base::FilePath>& extension_dirs,
+      int load_flags,
+      base::OnceCallback<void(const std::vector<const Extension*>&,
+                              const std::string&,
+                              const std::string&)> cb);
+
   // Finish initialization for the shell extension system.
   void FinishInitialization();
 
@@ -10,12 +10,16 @@
 #include "base/command_line.h"
 #include "base/feature_list.h"
 #include "base/metrics/field_trial.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
+#include "components/download/public/common/download_features.h"
 #include "components/spellcheck/common/spellcheck_features.h"
 #include "content/public/common/content_features.h"
 #include "electron/buildflags/buildflags.h"
 #include "media/base/media_switches.h"
 #include "net/base/features.h"
 #include "services/network/public/cpp/features.h"
+#include "shell/common/options_switches.h"
 
 namespace electron {
 
@@ -32,6 +36,18 @@ void InitializeFeatureList() {
   disable_features +=
       std::string(",") + features::kSpareRendererForSitePerProcess.name;
 
+  // Download files that are large enough with several range requests, which
+  // Chromium only does when the feature is enabled.
+  int download_connections = 0;
+  if (base::StringToInt(
+          cmd_line->GetSwitchValueASCII(switches::kDownloadConnections),
+          &download_connections) &&
+      download_connections > 1) {
+    enable_features += base::StringPrintf(
+        ",%s:request_count/%d",
+        download::features::kParallelDownloading.name, download_connections);
+  }
+
 #if !BUILDFLAG(ENABLE_PICTURE_IN_PICTURE)
   disable_features += std::string(",") + media::kPictureInPicture.name;
 #endif
@@ -0,0 +1,131 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/flight_recorder.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/callback_helpers.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+
+using content::TracingController;
+
+namespace electron {
+
+namespace {
+
+// Passes the trace data through to another endpoint and notifies the flight
+// recorder once the trace has been fully flushed, so it can start recording
+// again.
+class SnapshotEndpoint : public TracingController::TraceDataEndpoint {
+ public:
+  SnapshotEndpoint(scoped_refptr<TraceDataEndpoint> target,
+                   base::OnceClosure on_finished)
+      : target_(std::move(target)), on_finished_(std::move(on_finished)) {}
+
+  // disable copy
+  SnapshotEndpoint(const SnapshotEndpoint&) = delete;
+  SnapshotEndpoint& operator=(const SnapshotEndpoint&) = delete;
+
+  // TracingController::TraceDataEndpoint:
+  void ReceiveTraceChunk(std::unique_ptr<std::string> chunk) override {
+    target_->ReceiveTraceChunk(std::move(chunk));
+  }
+
+  void ReceivedTraceFinalContents() override {
+    target_->ReceivedTraceFinalContents();
+    content::GetUIThreadTaskRunner({})->PostTask(FROM_HERE,
+                                                 std::move(on_finished_));
+  }
+
+ private:
+  ~SnapshotEndpoint() override = default;
+
+  scoped_refptr<TraceDataEndpoint> target_;
+  base::OnceClosure on_finished_;
+};
+
+}  // namespace
+
+// static
+FlightRecorder* FlightRecorder::GetInstance() {
+  static base::NoDestructor<FlightRecorder> instance;
+  return instance.get();
+}
+
+FlightRecorder::FlightRecorder() = default;
+
+FlightRecorder::~FlightRecorder() = default;
+
+bool FlightRecorder::Start(const base::trace_event::TraceConfig& config,
+                           base::OnceClosure callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  base::trace_event::TraceConfig ring_buffer_config = config;
+  ring_buffer_config.SetTraceRecordMode(
+      base::trace_event::RECORD_CONTINUOUSLY);
+  if (!TracingController::GetInstance()->StartTracing(ring_buffer_config,
+                                                      std::move(callback)))
+    return false;
+  config_ = std::move(ring_buffer_config);
+  recording_ = true;
+  return true;
+}
+
+bool FlightRecorder::Stop(base::OnceClosure callback) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!recording_ || taking_snapshot_)
+    return false;
+  auto endpoint = TracingController::CreateStringEndpoint(base::BindOnce(
+      [](base::OnceClosure callback, std::unique_ptr<std::string>) {
+        std::move(callback).Run();
+      },
+      std::move(callback)));
+  recording_ = false;
+  return TracingController::GetInstance()->StopTracing(endpoint);
+}
+
+bool FlightRecorder::Snapshot(scoped_refptr<TraceDataEndpoint> endpoint) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  if (!recording_ || taking_snapshot_)
+    return false;
+  auto snapshot_endpoint = base::MakeRefCounted<SnapshotEndpoint>(
+      std::move(endpoint), base::BindOnce(&FlightRecorder::OnSnapshotFinished,
+                                          weak_factory_.GetWeakPtr()));
+  if (!TracingController::GetInstance()->StopTracing(snapshot_endpoint)) {
+    recording_ = false;
+    return false;
+  }
+  taking_snapshot_ = true;
+  return true;
+}
+
+void FlightRecorder::SnapshotToFile(const base::FilePath& path,
+                                    SnapshotCallback callback) {
+  auto split_callback = base::SplitOnceCallback(std::move(callback));
+  auto endpoint = TracingController::CreateFileEndpoint(
+      path, base::BindOnce(std::move(split_callback.first), absl::nullopt));
+  if (!Snapshot(std::move(endpoint))) {
+    std::move(split_callback.second)
+        .Run(absl::make_optional(std::string(
+            "Failed to take a snapshot (is the flight recorder running?)")));
+  }
+}
+
+void FlightRecorder::OnTracingStopped() {
+  recording_ = false;
+}
+
+void FlightRecorder::OnSnapshotFinished() {
+  taking_snapshot_ = false;
+  if (!recording_)
+    return;
+  // Events emitted between the end of the flush and the restart are lost.
+  if (!TracingController::GetInstance()->StartTracing(config_,
+                                                      base::DoNothing()))
+    recording_ = false;
+}
+
+}  // namespace electron
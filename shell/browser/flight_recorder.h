@@ -0,0 +1,77 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_FLIGHT_RECORDER_H_
+#define ELECTRON_SHELL_BROWSER_FLIGHT_RECORDER_H_
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/no_destructor.h"
+#include "base/trace_event/trace_config.h"
+#include "content/public/browser/tracing_controller.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace electron {
+
+// Keeps a trace running into a bounded ring buffer, so that the most recent
+// trace events can be dumped at any time (e.g. when a hang is detected)
+// without ending the recording. Only accessed on the UI thread.
+class FlightRecorder {
+ public:
+  using TraceDataEndpoint = content::TracingController::TraceDataEndpoint;
+  using SnapshotCallback =
+      base::OnceCallback<void(absl::optional<std::string> error)>;
+
+  static FlightRecorder* GetInstance();
+
+  // disable copy
+  FlightRecorder(const FlightRecorder&) = delete;
+  FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+  // Starts recording with |config| in "record-continuously" mode. Returns
+  // false if a trace is already in progress, in which case |callback| is
+  // not called.
+  bool Start(const base::trace_event::TraceConfig& config,
+             base::OnceClosure callback);
+
+  // Stops recording and discards the buffered events.
+  bool Stop(base::OnceClosure callback);
+
+  // Writes the buffered events into |endpoint| and resumes recording with
+  // the same config. Returns false if the recorder is not running or a
+  // snapshot is already being taken.
+  bool Snapshot(scoped_refptr<TraceDataEndpoint> endpoint);
+
+  // Convenience for native triggers such as hang detectors: writes a
+  // snapshot to |path|.
+  void SnapshotToFile(const base::FilePath& path, SnapshotCallback callback);
+
+  // Called when the trace was ended through contentTracing.stopRecording().
+  void OnTracingStopped();
+
+  bool is_recording() const { return recording_; }
+  bool is_taking_snapshot() const { return taking_snapshot_; }
+
+ private:
+  friend class base::NoDestructor<FlightRecorder>;
+
+  FlightRecorder();
+  ~FlightRecorder();
+
+  void OnSnapshotFinished();
+
+  base::trace_event::TraceConfig config_;
+  bool recording_ = false;
+  bool taking_snapshot_ = false;
+
+  base::WeakPtrFactory<FlightRecorder> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_FLIGHT_RECORDER_H_
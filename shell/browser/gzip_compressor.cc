@@ -0,0 +1,39 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/gzip_compressor.h"
+
+#include <array>
+
+namespace electron {
+
+GzipCompressor::GzipCompressor() {
+  initialized_ = deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                              MAX_WBITS + 16 /* gzip header */, 8,
+                              Z_DEFAULT_STRATEGY) == Z_OK;
+}
+
+GzipCompressor::~GzipCompressor() {
+  if (initialized_)
+    deflateEnd(&stream_);
+}
+
+bool GzipCompressor::Compress(base::StringPiece input,
+                              bool finish,
+                              std::string* output) {
+  if (!initialized_)
+    return false;
+  std::array<char, 16 * 1024> buffer;
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+  stream_.avail_in = input.size();
+  do {
+    stream_.next_out = reinterpret_cast<Bytef*>(buffer.data());
+    stream_.avail_out = buffer.size();
+    deflate(&stream_, finish ? Z_FINISH : Z_NO_FLUSH);
+    output->append(buffer.data(), buffer.size() - stream_.avail_out);
+  } while (stream_.avail_out == 0);
+  return true;
+}
+
+}  // namespace electron
@@ -0,0 +1,38 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_GZIP_COMPRESSOR_H_
+#define ELECTRON_SHELL_BROWSER_GZIP_COMPRESSOR_H_
+
+#include <string>
+
+#include "base/strings/string_piece.h"
+#include "third_party/zlib/zlib.h"
+
+namespace electron {
+
+// Compresses data into the gzip format as it is produced, so it never has to
+// be held in memory as a whole.
+class GzipCompressor {
+ public:
+  GzipCompressor();
+  ~GzipCompressor();
+
+  // disable copy
+  GzipCompressor(const GzipCompressor&) = delete;
+  GzipCompressor& operator=(const GzipCompressor&) = delete;
+
+  // Appends the compressed output available after consuming |input| to
+  // |output|. The last call must pass |finish| to flush the remaining output
+  // and the gzip trailer. Returns false if the stream could not be set up.
+  bool Compress(base::StringPiece input, bool finish, std::string* output);
+
+ private:
+  z_stream stream_ = {};
+  bool initialized_ = false;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_GZIP_COMPRESSOR_H_
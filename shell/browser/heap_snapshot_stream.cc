@@ -0,0 +1,224 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/heap_snapshot_stream.h"
+
+#include <utility>
+
+#include "base/callback_helpers.h"
+#include "base/strings/string_piece.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "content/public/browser/render_frame_host.h"
+#include "mojo/public/cpp/system/data_pipe.h"
+#include "mojo/public/cpp/system/simple_watcher.h"
+#include "services/service_manager/public/cpp/interface_provider.h"
+#include "shell/browser/gzip_compressor.h"
+
+namespace electron {
+
+namespace {
+
+// Large enough for the renderer to rarely wait on the worker sequence.
+constexpr uint32_t kPipeCapacity = 4 * 1024 * 1024;
+
+}  // namespace
+
+// Reads the pipe and compresses the data on the worker sequence. While it is
+// paused the pipe fills up, which makes the renderer wait.
+class HeapSnapshotStream::Reader {
+ public:
+  Reader(bool compress,
+         base::WeakPtr<HeapSnapshotStream> stream,
+         scoped_refptr<base::SequencedTaskRunner> ui_task_runner)
+      : compress_(compress),
+        stream_(std::move(stream)),
+        ui_task_runner_(std::move(ui_task_runner)) {}
+
+  // disable copy
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  void Start(mojo::ScopedDataPipeConsumerHandle pipe) {
+    pipe_ = std::move(pipe);
+    watcher_ = std::make_unique<mojo::SimpleWatcher>(
+        FROM_HERE, mojo::SimpleWatcher::ArmingPolicy::MANUAL,
+        base::SequencedTaskRunnerHandle::Get());
+    watcher_->Watch(
+        pipe_.get(),
+        MOJO_HANDLE_SIGNAL_READABLE | MOJO_HANDLE_SIGNAL_PEER_CLOSED,
+        base::BindRepeating(&Reader::OnReadable, base::Unretained(this)));
+    if (!paused_)
+      watcher_->ArmOrNotify();
+  }
+
+  void Pause() { paused_ = true; }
+
+  void Resume() {
+    if (!paused_)
+      return;
+    paused_ = false;
+    if (watcher_)
+      watcher_->ArmOrNotify();
+  }
+
+ private:
+  void OnReadable(MojoResult result) {
+    if (paused_)
+      return;
+    const void* buffer = nullptr;
+    uint32_t num_bytes = 0;
+    MojoResult rv =
+        pipe_->BeginReadData(&buffer, &num_bytes, MOJO_READ_DATA_FLAG_NONE);
+    if (rv == MOJO_RESULT_SHOULD_WAIT) {
+      watcher_->ArmOrNotify();
+      return;
+    }
+    if (rv != MOJO_RESULT_OK) {
+      // The renderer closed the pipe.
+      OnDataComplete();
+      return;
+    }
+
+    base::StringPiece input(static_cast<const char*>(buffer), num_bytes);
+    std::string output;
+    if (compress_)
+      compressor_.Compress(input, false, &output);
+    else
+      output.assign(input.data(), input.size());
+    pipe_->EndReadData(num_bytes);
+    ui_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&HeapSnapshotStream::OnData, stream_,
+                                  num_bytes, std::move(output)));
+    watcher_->ArmOrNotify();
+  }
+
+  void OnDataComplete() {
+    watcher_.reset();
+    pipe_.reset();
+    if (compress_) {
+      std::string output;
+      compressor_.Compress(base::StringPiece(), true, &output);
+      ui_task_runner_->PostTask(
+          FROM_HERE, base::BindOnce(&HeapSnapshotStream::OnData, stream_, 0,
+                                    std::move(output)));
+    }
+    ui_task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(&HeapSnapshotStream::OnDataComplete, stream_));
+  }
+
+  bool compress_;
+  base::WeakPtr<HeapSnapshotStream> stream_;
+  scoped_refptr<base::SequencedTaskRunner> ui_task_runner_;
+  GzipCompressor compressor_;
+  mojo::ScopedDataPipeConsumerHandle pipe_;
+  std::unique_ptr<mojo::SimpleWatcher> watcher_;
+  bool paused_ = false;
+};
+
+// static
+base::RepeatingClosure HeapSnapshotStream::Start(
+    content::RenderFrameHost* frame_host,
+    bool compress,
+    DataCallback on_data,
+    ProgressCallback on_progress,
+    EndCallback on_end) {
+  mojo::ScopedDataPipeProducerHandle producer;
+  mojo::ScopedDataPipeConsumerHandle consumer;
+  if (mojo::CreateDataPipe(kPipeCapacity, producer, consumer) !=
+      MOJO_RESULT_OK) {
+    std::move(on_end).Run("Failed to create a data pipe for the snapshot");
+    return base::DoNothing();
+  }
+
+  auto* stream = new HeapSnapshotStream(
+      std::move(on_data), std::move(on_progress), std::move(on_end));
+  stream->reader_ = std::make_unique<Reader>(
+      compress, stream->weak_factory_.GetWeakPtr(),
+      base::SequencedTaskRunnerHandle::Get());
+  stream->task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Reader::Start,
+                                base::Unretained(stream->reader_.get()),
+                                std::move(consumer)));
+
+  frame_host->GetRemoteInterfaces()->GetInterface(
+      stream->renderer_.BindNewPipeAndPassReceiver());
+  // The renderer went away before replying.
+  stream->renderer_.set_disconnect_handler(
+      base::BindOnce(&HeapSnapshotStream::OnSnapshotTaken,
+                     stream->weak_factory_.GetWeakPtr(), false));
+  stream->renderer_->StreamHeapSnapshot(
+      std::move(producer), stream->receiver_.BindNewPipeAndPassRemote(),
+      base::BindOnce(&HeapSnapshotStream::OnSnapshotTaken,
+                     stream->weak_factory_.GetWeakPtr()));
+  return base::BindRepeating(&HeapSnapshotStream::Resume,
+                             stream->weak_factory_.GetWeakPtr());
+}
+
+HeapSnapshotStream::HeapSnapshotStream(DataCallback on_data,
+                                       ProgressCallback on_progress,
+                                       EndCallback on_end)
+    : on_data_(std::move(on_data)),
+      on_progress_(std::move(on_progress)),
+      on_end_(std::move(on_end)),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::TaskPriority::USER_VISIBLE,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})) {}
+
+HeapSnapshotStream::~HeapSnapshotStream() {
+  task_runner_->DeleteSoon(FROM_HERE, std::move(reader_));
+}
+
+void HeapSnapshotStream::OnSnapshotProgress(uint32_t percent) {
+  progress_.snapshot_percent = percent;
+  on_progress_.Run(progress_);
+}
+
+void HeapSnapshotStream::OnData(uint64_t bytes_serialized, std::string data) {
+  progress_.bytes_serialized += bytes_serialized;
+  progress_.bytes_written += data.size();
+  // The reader stops until the data is consumed.
+  if (!data.empty() && !on_data_.Run(std::move(data)) && !paused_) {
+    paused_ = true;
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&Reader::Pause,
+                                          base::Unretained(reader_.get())));
+  }
+  on_progress_.Run(progress_);
+}
+
+void HeapSnapshotStream::Resume() {
+  if (!paused_)
+    return;
+  paused_ = false;
+  task_runner_->PostTask(FROM_HERE,
+                         base::BindOnce(&Reader::Resume,
+                                        base::Unretained(reader_.get())));
+}
+
+void HeapSnapshotStream::OnDataComplete() {
+  data_complete_ = true;
+  MaybeFinish();
+}
+
+void HeapSnapshotStream::OnSnapshotTaken(bool success) {
+  if (success_)
+    return;
+  success_ = success;
+  // The pipe is closed along with the renderer, so the data completes too.
+  MaybeFinish();
+}
+
+void HeapSnapshotStream::MaybeFinish() {
+  if (!success_ || !data_complete_)
+    return;
+  absl::optional<std::string> error;
+  if (!*success_)
+    error = "Failed to take heap snapshot";
+  std::move(on_end_).Run(error);
+  delete this;
+}
+
+}  // namespace electron
@@ -0,0 +1,94 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_HEAP_SNAPSHOT_STREAM_H_
+#define ELECTRON_SHELL_BROWSER_HEAP_SNAPSHOT_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "electron/shell/common/api/api.mojom.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace content {
+class RenderFrameHost;
+}
+
+namespace electron {
+
+// Streams a heap snapshot of a renderer through a data pipe, optionally
+// compressing it with gzip on a worker sequence, and hands it to the caller
+// chunk by chunk. The renderer waits while the caller is not ready for more
+// data.
+class HeapSnapshotStream : public mojom::HeapSnapshotClient {
+ public:
+  struct Progress {
+    uint32_t snapshot_percent = 0;
+    uint64_t bytes_serialized = 0;
+    uint64_t bytes_written = 0;
+  };
+  // Returns false when the caller is not ready for more data.
+  using DataCallback = base::RepeatingCallback<bool(std::string)>;
+  using ProgressCallback = base::RepeatingCallback<void(const Progress&)>;
+  using EndCallback =
+      base::OnceCallback<void(const absl::optional<std::string>& error)>;
+
+  // Deletes itself after calling |on_end|. Once |on_data| returned false, no
+  // more data is read until the returned callback is called.
+  static base::RepeatingClosure Start(content::RenderFrameHost* frame_host,
+                                      bool compress,
+                                      DataCallback on_data,
+                                      ProgressCallback on_progress,
+                                      EndCallback on_end);
+
+  // disable copy
+  HeapSnapshotStream(const HeapSnapshotStream&) = delete;
+  HeapSnapshotStream& operator=(const HeapSnapshotStream&) = delete;
+
+ private:
+  class Reader;
+
+  HeapSnapshotStream(DataCallback on_data,
+                     ProgressCallback on_progress,
+                     EndCallback on_end);
+  ~HeapSnapshotStream() override;
+
+  // mojom::HeapSnapshotClient
+  void OnSnapshotProgress(uint32_t percent) override;
+
+  void OnData(uint64_t bytes_serialized, std::string data);
+  void Resume();
+  void OnDataComplete();
+  void OnSnapshotTaken(bool success);
+  void MaybeFinish();
+
+  DataCallback on_data_;
+  ProgressCallback on_progress_;
+  EndCallback on_end_;
+  Progress progress_;
+
+  mojo::Remote<mojom::ElectronRenderer> renderer_;
+  mojo::Receiver<mojom::HeapSnapshotClient> receiver_{this};
+  // The snapshot is done once the renderer has replied and all the data has
+  // been read from the pipe, which can happen in either order.
+  absl::optional<bool> success_;
+  bool data_complete_ = false;
+  bool paused_ = false;
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  // Only accessed on |task_runner_|.
+  std::unique_ptr<Reader> reader_;
+
+  base::WeakPtrFactory<HeapSnapshotStream> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_HEAP_SNAPSHOT_STREAM_H_
@@ -0,0 +1,79 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/ipc_channel_stats.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "content/public/browser/browser_thread.h"
+#include "electron/shell/common/api/api.mojom.h"
+
+namespace electron {
+
+IpcChannelStats::Entry::Entry() = default;
+IpcChannelStats::Entry::Entry(const Entry&) = default;
+IpcChannelStats::Entry::~Entry() = default;
+
+// static
+IpcChannelStats* IpcChannelStats::GetInstance() {
+  static base::NoDestructor<IpcChannelStats> instance;
+  return instance.get();
+}
+
+IpcChannelStats::IpcChannelStats() = default;
+
+IpcChannelStats::~IpcChannelStats() = default;
+
+IpcChannelStats::Entry& IpcChannelStats::GetEntry(const std::string& channel,
+                                                  Direction direction) {
+  Key key(channel, direction);
+  auto it = entries_.find(key);
+  if (it != entries_.end())
+    return it->second;
+  // The overflow entries of both directions are allowed above the limit.
+  if (entries_.size() >= kMaxEntries)
+    key.first = kOverflowChannel;
+  return entries_[key];
+}
+
+void IpcChannelStats::RecordIncoming(const std::string& channel,
+                                     size_t bytes,
+                                     const mojom::IpcMessageTiming& timing,
+                                     base::TimeTicks received_time) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  Entry& entry = GetEntry(channel, Direction::kIncoming);
+  entry.count++;
+  entry.bytes += bytes;
+  entry.serialize_time += timing.serialize_duration;
+  // A null send time means the sender did not record one.
+  if (!timing.send_time.is_null() && received_time > timing.send_time)
+    entry.queueing_time += received_time - timing.send_time;
+}
+
+void IpcChannelStats::RecordHandlerTime(const std::string& channel,
+                                        base::TimeDelta handler_time) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  Entry& entry = GetEntry(channel, Direction::kIncoming);
+  entry.handler_time += handler_time;
+  auto bucket = std::upper_bound(kHistogramBounds.begin(),
+                                 kHistogramBounds.end(), handler_time);
+  entry.handler_histogram[std::distance(kHistogramBounds.begin(), bucket)]++;
+}
+
+void IpcChannelStats::RecordOutgoing(const std::string& channel,
+                                     size_t bytes,
+                                     base::TimeDelta serialize_time) {
+  DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+  Entry& entry = GetEntry(channel, Direction::kOutgoing);
+  entry.count++;
+  entry.bytes += bytes;
+  entry.serialize_time += serialize_time;
+}
+
+void IpcChannelStats::Reset() {
+  entries_.clear();
+}
+
+}  // namespace electron
@@ -0,0 +1,94 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_IPC_CHANNEL_STATS_H_
+#define ELECTRON_SHELL_BROWSER_IPC_CHANNEL_STATS_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "base/containers/flat_map.h"
+#include "base/no_destructor.h"
+#include "base/time/time.h"
+#include "electron/shell/common/api/api.mojom-forward.h"
+
+namespace electron {
+
+// Always-on, per-channel counters of the IPC messages handled by the main
+// process. Only accessed on the UI thread.
+class IpcChannelStats {
+ public:
+  enum class Direction {
+    kIncoming,  // renderer -> main
+    kOutgoing,  // main -> renderer
+  };
+
+  // Upper bounds of the handler time histogram buckets, the last bucket
+  // counts everything above the last bound.
+  static constexpr std::array<base::TimeDelta, 5> kHistogramBounds = {
+      base::Microseconds(100), base::Milliseconds(1), base::Milliseconds(10),
+      base::Milliseconds(100), base::Seconds(1)};
+
+  struct Entry {
+    Entry();
+    Entry(const Entry&);
+    ~Entry();
+
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+    base::TimeDelta serialize_time;
+    base::TimeDelta queueing_time;
+    base::TimeDelta handler_time;
+    std::array<uint64_t, kHistogramBounds.size() + 1> handler_histogram = {};
+  };
+
+  using Key = std::pair<std::string, Direction>;
+
+  // Channel names can be generated at runtime, so the number of entries is
+  // bounded. Once it is reached, the messages of new channels are counted in
+  // the entry of |kOverflowChannel|.
+  static constexpr size_t kMaxEntries = 1000;
+  static constexpr char kOverflowChannel[] = "<other>";
+
+  static IpcChannelStats* GetInstance();
+
+  // disable copy
+  IpcChannelStats(const IpcChannelStats&) = delete;
+  IpcChannelStats& operator=(const IpcChannelStats&) = delete;
+
+  // Records a message received from a renderer.
+  void RecordIncoming(const std::string& channel,
+                      size_t bytes,
+                      const mojom::IpcMessageTiming& timing,
+                      base::TimeTicks received_time);
+
+  // Records the time the main process took to handle a message received on
+  // |channel|, up to the reply for invoke and sync messages.
+  void RecordHandlerTime(const std::string& channel,
+                         base::TimeDelta handler_time);
+
+  // Records a message sent to a renderer.
+  void RecordOutgoing(const std::string& channel,
+                      size_t bytes,
+                      base::TimeDelta serialize_time);
+
+  const base::flat_map<Key, Entry>& entries() const { return entries_; }
+  void Reset();
+
+ private:
+  friend class base::NoDestructor<IpcChannelStats>;
+
+  IpcChannelStats();
+  ~IpcChannelStats();
+
+  Entry& GetEntry(const std::string& channel, Direction direction);
+
+  base::flat_map<Key, Entry> entries_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_IPC_CHANNEL_STATS_H_
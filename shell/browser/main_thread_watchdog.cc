@@ -0,0 +1,216 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/main_thread_watchdog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "base/debug/stack_trace.h"
+#include "base/memory/ref_counted.h"
+#include "base/pending_task.h"
+#include "base/strings/stringprintf.h"
+#include "base/task/current_thread.h"
+#include "base/task/thread_pool.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
+#include "gin/converter.h"
+#include "v8/include/v8.h"
+
+namespace electron {
+
+namespace {
+
+constexpr int kMaxStackFrames = 32;
+
+std::string GetJavaScriptStack(v8::Isolate* isolate) {
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::StackTrace> stack =
+      v8::StackTrace::CurrentStackTrace(isolate, kMaxStackFrames);
+  std::string result;
+  for (int i = 0; i < stack->GetFrameCount(); ++i) {
+    v8::Local<v8::StackFrame> frame = stack->GetFrame(isolate, i);
+    std::string function_name =
+        gin::V8ToString(isolate, frame->GetFunctionName());
+    std::string script_name =
+        gin::V8ToString(isolate, frame->GetScriptNameOrSourceURL());
+    base::StringAppendF(
+        &result, "    at %s (%s:%d:%d)\n",
+        function_name.empty() ? "<anonymous>" : function_name.c_str(),
+        script_name.c_str(), frame->GetLineNumber(), frame->GetColumn());
+  }
+  return result;
+}
+
+}  // namespace
+
+// The state shared with the worker thread that polls the running task.
+class MainThreadWatchdog::Monitor
+    : public base::RefCountedThreadSafe<MainThreadWatchdog::Monitor> {
+ public:
+  Monitor(v8::Isolate* isolate,
+          base::TimeDelta threshold,
+          bool sample_stacks,
+          base::WeakPtr<MainThreadWatchdog> watchdog)
+      : isolate_(isolate),
+        threshold_(threshold),
+        sample_stacks_(sample_stacks),
+        watchdog_(std::move(watchdog)) {}
+
+  // disable copy
+  Monitor(const Monitor&) = delete;
+  Monitor& operator=(const Monitor&) = delete;
+
+  void SetRunningTask(uint64_t id, base::TimeTicks start) {
+    task_start_.store(start.since_origin().InMicroseconds(),
+                      std::memory_order_relaxed);
+    task_id_.store(id, std::memory_order_release);
+  }
+
+  void ClearRunningTask() { task_id_.store(0, std::memory_order_release); }
+
+  void Stop() { stopped_.store(true, std::memory_order_relaxed); }
+
+  void SchedulePoll() {
+    // Polling at half the threshold notices a blocked task at the latest
+    // when it has run for one and a half times the threshold.
+    base::ThreadPool::PostDelayedTask(
+        FROM_HERE,
+        {base::TaskPriority::USER_BLOCKING,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        base::BindOnce(&Monitor::Poll, base::WrapRefCounted(this)),
+        std::max(threshold_ / 2, base::Milliseconds(1)));
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Monitor>;
+
+  struct InterruptData {
+    base::WeakPtr<MainThreadWatchdog> watchdog;
+    uint64_t task_id;
+  };
+
+  ~Monitor() = default;
+
+  void Poll() {
+    if (stopped_.load(std::memory_order_relaxed))
+      return;
+    uint64_t id = task_id_.load(std::memory_order_acquire);
+    base::TimeTicks start =
+        base::TimeTicks() +
+        base::Microseconds(task_start_.load(std::memory_order_relaxed));
+    if (id != 0 && id != interrupted_task_id_ &&
+        base::TimeTicks::Now() - start >= threshold_) {
+      interrupted_task_id_ = id;
+      if (sample_stacks_) {
+        isolate_->RequestInterrupt(&Monitor::OnInterrupt,
+                                   new InterruptData{watchdog_, id});
+      }
+    }
+    SchedulePoll();
+  }
+
+  // Runs on the main thread.
+  static void OnInterrupt(v8::Isolate* isolate, void* data) {
+    std::unique_ptr<InterruptData> interrupt(
+        static_cast<InterruptData*>(data));
+    if (interrupt->watchdog)
+      interrupt->watchdog->SampleStacks(interrupt->task_id);
+  }
+
+  v8::Isolate* isolate_;
+  const base::TimeDelta threshold_;
+  const bool sample_stacks_;
+  // Only dereferenced on the main thread.
+  base::WeakPtr<MainThreadWatchdog> watchdog_;
+
+  std::atomic<uint64_t> task_id_{0};
+  std::atomic<int64_t> task_start_{0};
+  std::atomic<bool> stopped_{false};
+  // Only accessed by Poll().
+  uint64_t interrupted_task_id_ = 0;
+};
+
+MainThreadWatchdog::BlockedTask::BlockedTask() = default;
+MainThreadWatchdog::BlockedTask::BlockedTask(const BlockedTask&) = default;
+MainThreadWatchdog::BlockedTask::~BlockedTask() = default;
+
+MainThreadWatchdog::MainThreadWatchdog(v8::Isolate* isolate,
+                                       base::TimeDelta threshold,
+                                       bool sample_stacks,
+                                       BlockedCallback callback)
+    : threshold_(threshold), callback_(std::move(callback)) {
+  monitor_ = base::MakeRefCounted<Monitor>(
+      isolate, threshold, sample_stacks, weak_factory_.GetWeakPtr());
+  monitor_->SchedulePoll();
+  base::CurrentThread::Get()->AddTaskObserver(this);
+}
+
+MainThreadWatchdog::~MainThreadWatchdog() {
+  base::CurrentThread::Get()->RemoveTaskObserver(this);
+  monitor_->Stop();
+}
+
+void MainThreadWatchdog::WillProcessTask(const base::PendingTask& pending_task,
+                                         bool was_blocked_or_low_priority) {
+  // The task running a nested loop is not blocking the thread.
+  if (!running_tasks_.empty())
+    running_tasks_.back().ran_nested_tasks = true;
+  RunningTask task;
+  task.id = next_task_id_++;
+  task.start = base::TimeTicks::Now();
+  monitor_->SetRunningTask(task.id, task.start);
+  running_tasks_.push_back(std::move(task));
+}
+
+void MainThreadWatchdog::DidProcessTask(const base::PendingTask& pending_task) {
+  // The watchdog was created while a task was running.
+  if (running_tasks_.empty())
+    return;
+  RunningTask task = std::move(running_tasks_.back());
+  running_tasks_.pop_back();
+  // A task that ran a nested loop is never reported, so the monitor does not
+  // need to go back to it.
+  monitor_->ClearRunningTask();
+
+  base::TimeTicks end = base::TimeTicks::Now();
+  base::TimeDelta duration = end - task.start;
+  if (task.ran_nested_tasks || duration < threshold_)
+    return;
+
+  BlockedTask blocked;
+  blocked.start_time = base::Time::Now() - duration;
+  blocked.duration = duration;
+  blocked.location = pending_task.posted_from.ToString();
+  blocked.js_stack = std::move(task.js_stack);
+  blocked.native_stack = std::move(task.native_stack);
+
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP1(
+      "electron", "MainThreadBlocked", TRACE_ID_LOCAL(this), task.start,
+      "location", blocked.location);
+  TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0(
+      "electron", "MainThreadBlocked", TRACE_ID_LOCAL(this), end);
+
+  // Let the task observers finish before running JavaScript.
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, base::BindOnce(
+                     [](base::WeakPtr<MainThreadWatchdog> watchdog,
+                        const BlockedTask& blocked) {
+                       if (watchdog)
+                         watchdog->callback_.Run(blocked);
+                     },
+                     weak_factory_.GetWeakPtr(), std::move(blocked)));
+}
+
+void MainThreadWatchdog::SampleStacks(uint64_t id) {
+  if (running_tasks_.empty() || running_tasks_.back().id != id)
+    return;
+  RunningTask& task = running_tasks_.back();
+  task.js_stack = GetJavaScriptStack(v8::Isolate::GetCurrent());
+  task.native_stack = base::debug::StackTrace().ToString();
+}
+
+}  // namespace electron
@@ -0,0 +1,90 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_MAIN_THREAD_WATCHDOG_H_
+#define ELECTRON_SHELL_BROWSER_MAIN_THREAD_WATCHDOG_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/task_observer.h"
+#include "base/time/time.h"
+
+namespace v8 {
+class Isolate;
+}
+
+namespace electron {
+
+// Reports the tasks of the browser main thread that run for longer than a
+// threshold, which includes the slices of the Node.js event loop and the
+// microtask checkpoints that follow them.
+//
+// A monitor on a worker thread notices a task that is still running past the
+// threshold and interrupts V8 to sample the JavaScript and native stacks of
+// the main thread. The interrupt only runs once JavaScript is executing, so a
+// task blocked in native code is reported without stacks.
+class MainThreadWatchdog : public base::TaskObserver {
+ public:
+  struct BlockedTask {
+    BlockedTask();
+    BlockedTask(const BlockedTask&);
+    ~BlockedTask();
+
+    base::Time start_time;
+    base::TimeDelta duration;
+    std::string location;
+    std::string js_stack;
+    std::string native_stack;
+  };
+  using BlockedCallback = base::RepeatingCallback<void(const BlockedTask&)>;
+
+  // Must be created on the main thread, after the microtasks runner.
+  MainThreadWatchdog(v8::Isolate* isolate,
+                     base::TimeDelta threshold,
+                     bool sample_stacks,
+                     BlockedCallback callback);
+  ~MainThreadWatchdog() override;
+
+  // disable copy
+  MainThreadWatchdog(const MainThreadWatchdog&) = delete;
+  MainThreadWatchdog& operator=(const MainThreadWatchdog&) = delete;
+
+  // base::TaskObserver
+  void WillProcessTask(const base::PendingTask& pending_task,
+                       bool was_blocked_or_low_priority) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  class Monitor;
+
+  // A task being run, tasks of nested run loops are pushed on top of the
+  // task that runs the loop.
+  struct RunningTask {
+    uint64_t id;
+    base::TimeTicks start;
+    bool ran_nested_tasks = false;
+    std::string js_stack;
+    std::string native_stack;
+  };
+
+  // Called from a V8 interrupt while task |id| is past the threshold.
+  void SampleStacks(uint64_t id);
+
+  base::TimeDelta threshold_;
+  BlockedCallback callback_;
+  scoped_refptr<Monitor> monitor_;
+  std::vector<RunningTask> running_tasks_;
+  uint64_t next_task_id_ = 1;
+
+  base::WeakPtrFactory<MainThreadWatchdog> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_MAIN_THREAD_WATCHDOG_H_
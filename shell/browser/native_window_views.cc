@@ -15,6 +15,7 @@
 #include "base/cxx17_backports.h"
 #include "base/stl_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/browser/desktop_media_id.h"
 #include "shell/browser/api/electron_api_web_contents.h"
@@ -1497,7 +1498,11 @@ gfx::Rect NativeWindowViews::WindowBoundsToContentBounds(
 
 void NativeWindowViews::UpdateDraggableRegions(
     const std::vector<mojom::DraggableRegionPtr>& regions) {
+  TRACE_EVENT1("electron", "NativeWindowViews::UpdateDraggableRegions",
+               "regions", regions.size());
   draggable_region_ = DraggableRegionsToSkRegion(regions);
+  TRACE_COUNTER_ID1("electron", "DraggableRegionRebuilds", this,
+                    ++draggable_region_rebuilds_);
 }
 
 #if BUILDFLAG(IS_WIN)
@@ -332,6 +332,9 @@ class NativeWindowViews : public NativeWindow,
   // For custom drag, the whole window is non-draggable and the draggable region
   // has to been explicitly provided.
   std::unique_ptr<SkRegion> draggable_region_;  // used in custom drag.
+  // How many times |draggable_region_| was rebuilt, reported as a trace
+  // counter.
+  uint64_t draggable_region_rebuilds_ = 0;
 
   // Whether the window should be enabled based on user calls to SetEnabled()
   bool is_enabled_ = true;
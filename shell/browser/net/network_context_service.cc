@@ -74,17 +74,19 @@ void NetworkContextService::ConfigureNetworkContextParams(
   network_context_params->http_cache_enabled =
       browser_context_->CanUseHttpCache();
 
+  // The HTTP cache is kept in memory when it has no directory.
+  network_context_params->http_cache_max_size =
+      browser_context_->GetMaxCacheSize();
+  if (!in_memory && !browser_context_->IsHttpCacheInMemory()) {
+    network_context_params->http_cache_directory =
+        path.Append(chrome::kCacheDirname);
+  }
+
   network_context_params->cookie_manager_params =
       network::mojom::CookieManagerParams::New();
 
   // Configure on-disk storage for persistent sessions.
   if (!in_memory) {
-    // Configure the HTTP cache path and size.
-    network_context_params->http_cache_directory =
-        path.Append(chrome::kCacheDirname);
-    network_context_params->http_cache_max_size =
-        browser_context_->GetMaxCacheSize();
-
     network_context_params->file_paths =
         network::mojom::NetworkContextFilePaths::New();
     network_context_params->file_paths->data_directory =
@@ -0,0 +1,233 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/resource_sampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "base/process/process_metrics.h"
+#include "base/system/sys_info.h"
+#include "base/task/thread_pool.h"
+#include "build/build_config.h"
+#include "shell/browser/api/process_metric.h"
+
+#if BUILDFLAG(IS_WIN)
+#include <windows.h>
+#endif
+
+namespace electron {
+
+namespace {
+
+constexpr double kUnavailable = std::numeric_limits<double>::quiet_NaN();
+
+double GetHandleCount(const ProcessMetric& metric) {
+#if BUILDFLAG(IS_WIN)
+  DWORD count = 0;
+  if (::GetProcessHandleCount(metric.process.Handle(), &count))
+    return count;
+#elif BUILDFLAG(IS_LINUX)
+  int count = metric.metrics->GetOpenFdCount();
+  if (count >= 0)
+    return count;
+#endif
+  return kUnavailable;
+}
+
+}  // namespace
+
+// Owns the metrics of the processes, which keep the state the CPU usage is
+// computed from, so they are separate from the ones app.getAppMetrics() uses.
+class ResourceSampler::Collector {
+ public:
+  Collector() = default;
+
+  // disable copy
+  Collector(const Collector&) = delete;
+  Collector& operator=(const Collector&) = delete;
+
+  void AddProcess(int id, std::unique_ptr<ProcessMetric> metric) {
+    processes_[id] = std::move(metric);
+  }
+
+  void RemoveProcess(int id) { processes_.erase(id); }
+
+  std::vector<std::pair<int, Sample>> Collect() {
+    double timestamp = base::Time::Now().ToJsTime();
+    int processor_count = base::SysInfo::NumberOfProcessors();
+    std::vector<std::pair<int, Sample>> result;
+    result.reserve(processes_.size());
+    for (const auto& it : processes_) {
+      const ProcessMetric& metric = *it.second;
+      Sample sample;
+      sample.fill(kUnavailable);
+      sample[kTimestamp] = timestamp;
+      sample[kPercentCPUUsage] =
+          metric.metrics->GetPlatformIndependentCPUUsage() / processor_count;
+      sample[kWorkingSetSize] =
+          static_cast<double>(metric.GetMemoryInfo().working_set_size >> 10);
+      base::IoCounters io_counters;
+      if (metric.metrics->GetIOCounters(&io_counters)) {
+        sample[kReadOperationCount] = io_counters.ReadOperationCount;
+        sample[kWriteOperationCount] = io_counters.WriteOperationCount;
+        sample[kOtherOperationCount] = io_counters.OtherOperationCount;
+        sample[kReadTransferCount] = io_counters.ReadTransferCount;
+        sample[kWriteTransferCount] = io_counters.WriteTransferCount;
+        sample[kOtherTransferCount] = io_counters.OtherTransferCount;
+      }
+      sample[kHandleCount] = GetHandleCount(metric);
+      result.emplace_back(it.first, sample);
+    }
+    return result;
+  }
+
+ private:
+  std::map<int, std::unique_ptr<ProcessMetric>> processes_;
+};
+
+ResourceSampler::History::History(base::ProcessId pid,
+                                  int type,
+                                  size_t capacity)
+    : pid(pid), type(type), samples(capacity) {}
+
+ResourceSampler::History::~History() = default;
+
+void ResourceSampler::History::Append(const Sample& sample) {
+  samples[next] = sample;
+  next = (next + 1) % samples.size();
+  size = std::min(size + 1, samples.size());
+}
+
+// static
+const char* ResourceSampler::GetFieldName(Field field) {
+  switch (field) {
+    case kTimestamp:
+      return "timestamp";
+    case kPercentCPUUsage:
+      return "percentCPUUsage";
+    case kWorkingSetSize:
+      return "workingSetSize";
+    case kReadOperationCount:
+      return "readOperationCount";
+    case kWriteOperationCount:
+      return "writeOperationCount";
+    case kOtherOperationCount:
+      return "otherOperationCount";
+    case kReadTransferCount:
+      return "readTransferCount";
+    case kWriteTransferCount:
+      return "writeTransferCount";
+    case kOtherTransferCount:
+      return "otherTransferCount";
+    case kHandleCount:
+      return "handleCount";
+    case kFieldCount:
+      break;
+  }
+  return "";
+}
+
+ResourceSampler::ResourceSampler(base::TimeDelta interval,
+                                 size_t capacity,
+                                 SummaryCallback callback)
+    : capacity_(capacity),
+      callback_(std::move(callback)),
+      task_runner_(base::ThreadPool::CreateSequencedTaskRunner(
+          {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+           base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN})),
+      collector_(std::make_unique<Collector>()) {
+  DCHECK_GT(capacity, 0u);
+  timer_.Start(FROM_HERE, interval,
+               base::BindRepeating(&ResourceSampler::Collect,
+                                   base::Unretained(this)));
+}
+
+ResourceSampler::~ResourceSampler() {
+  task_runner_->DeleteSoon(FROM_HERE, std::move(collector_));
+}
+
+void ResourceSampler::AddProcess(int id,
+                                 std::unique_ptr<ProcessMetric> metric) {
+  histories_.erase(id);
+  histories_.emplace(std::piecewise_construct, std::forward_as_tuple(id),
+                     std::forward_as_tuple(metric->process.Pid(),
+                                           metric->type, capacity_));
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Collector::AddProcess, base::Unretained(collector_.get()),
+                     id, std::move(metric)));
+}
+
+void ResourceSampler::RemoveProcess(int id) {
+  histories_.erase(id);
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Collector::RemoveProcess,
+                                base::Unretained(collector_.get()), id));
+}
+
+bool ResourceSampler::GetSamples(base::ProcessId pid,
+                                 int* type,
+                                 std::vector<double>* samples) const {
+  for (const auto& it : histories_) {
+    const History& history = it.second;
+    if (history.pid != pid)
+      continue;
+    *type = history.type;
+    samples->clear();
+    samples->reserve(history.size * kFieldCount);
+    size_t first = (history.next + history.samples.size() - history.size) %
+                   history.samples.size();
+    for (size_t i = 0; i < history.size; ++i) {
+      const Sample& sample =
+          history.samples[(first + i) % history.samples.size()];
+      samples->insert(samples->end(), sample.begin(), sample.end());
+    }
+    return true;
+  }
+  return false;
+}
+
+void ResourceSampler::Collect() {
+  // A slow sample skips the next ticks instead of piling up.
+  if (collecting_)
+    return;
+  collecting_ = true;
+  // The collector is deleted on the same sequence, after this task.
+  task_runner_->PostTaskAndReplyWithResult(
+      FROM_HERE,
+      base::BindOnce(&Collector::Collect, base::Unretained(collector_.get())),
+      base::BindOnce(&ResourceSampler::OnCollected,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void ResourceSampler::OnCollected(
+    std::vector<std::pair<int, Sample>> samples) {
+  collecting_ = false;
+  Summary summary;
+  for (const auto& it : samples) {
+    auto history = histories_.find(it.first);
+    // The process exited while being sampled.
+    if (history == histories_.end())
+      continue;
+    const Sample& sample = it.second;
+    history->second.Append(sample);
+    summary.timestamp = sample[kTimestamp];
+    summary.process_count++;
+    summary.percent_cpu_usage += sample[kPercentCPUUsage];
+    summary.working_set_size += sample[kWorkingSetSize];
+    // Counters that cannot be read for a process are left out of the sum.
+    if (!std::isnan(sample[kReadTransferCount]))
+      summary.read_transfer_count += sample[kReadTransferCount];
+    if (!std::isnan(sample[kWriteTransferCount]))
+      summary.write_transfer_count += sample[kWriteTransferCount];
+  }
+  if (summary.process_count > 0)
+    callback_.Run(summary);
+}
+
+}  // namespace electron
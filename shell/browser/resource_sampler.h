@@ -0,0 +1,113 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_RESOURCE_SAMPLER_H_
+#define ELECTRON_SHELL_BROWSER_RESOURCE_SAMPLER_H_
+
+#include <array>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/process/process_handle.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace electron {
+
+struct ProcessMetric;
+
+// Samples the resource usage of a set of processes on a worker sequence and
+// keeps the last samples of each process in a fixed-size ring buffer.
+class ResourceSampler {
+ public:
+  // The fields of a sample, in the order they are stored.
+  enum Field {
+    kTimestamp,
+    kPercentCPUUsage,
+    kWorkingSetSize,
+    kReadOperationCount,
+    kWriteOperationCount,
+    kOtherOperationCount,
+    kReadTransferCount,
+    kWriteTransferCount,
+    kOtherTransferCount,
+    kHandleCount,
+    kFieldCount,
+  };
+  using Sample = std::array<double, kFieldCount>;
+
+  // The sum of the latest samples of all the processes.
+  struct Summary {
+    double timestamp = 0;
+    size_t process_count = 0;
+    double percent_cpu_usage = 0;
+    double working_set_size = 0;
+    double read_transfer_count = 0;
+    double write_transfer_count = 0;
+  };
+  using SummaryCallback = base::RepeatingCallback<void(const Summary&)>;
+
+  // Returns the names of the fields, indexed by Field.
+  static const char* GetFieldName(Field field);
+
+  ResourceSampler(base::TimeDelta interval,
+                  size_t capacity,
+                  SummaryCallback callback);
+  ~ResourceSampler();
+
+  // disable copy
+  ResourceSampler(const ResourceSampler&) = delete;
+  ResourceSampler& operator=(const ResourceSampler&) = delete;
+
+  // |id| is the child process id the process is tracked with.
+  void AddProcess(int id, std::unique_ptr<ProcessMetric> metric);
+  void RemoveProcess(int id);
+
+  // Copies the samples of |pid| oldest first, |kFieldCount| values per
+  // sample. Returns false if the process is not sampled.
+  bool GetSamples(base::ProcessId pid,
+                  int* type,
+                  std::vector<double>* samples) const;
+
+ private:
+  class Collector;
+
+  struct History {
+    History(base::ProcessId pid, int type, size_t capacity);
+    ~History();
+
+    void Append(const Sample& sample);
+
+    base::ProcessId pid;
+    int type;
+    // A ring buffer of samples, |next| is where the next one is written.
+    std::vector<Sample> samples;
+    size_t next = 0;
+    size_t size = 0;
+  };
+
+  void Collect();
+  void OnCollected(std::vector<std::pair<int, Sample>> samples);
+
+  base::RepeatingTimer timer_;
+  size_t capacity_;
+  SummaryCallback callback_;
+  std::map<int, History> histories_;
+  bool collecting_ = false;
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  // Only accessed on |task_runner_|.
+  std::unique_ptr<Collector> collector_;
+
+  base::WeakPtrFactory<ResourceSampler> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_RESOURCE_SAMPLER_H_
@@ -9,6 +9,7 @@
 
 #include "base/files/file_path.h"
 #include "base/supports_user_data.h"
+#include "base/time/time.h"
 
 namespace content {
 class BrowserContext;
@@ -31,11 +32,26 @@ class SessionPreferences : public base::SupportsUserData::Data {
   }
   const std::vector<base::FilePath>& preloads() const { return preloads_; }
 
+  // The "updated" events of a download are coalesced until both this much
+  // time has passed and this many bytes were received since the last one.
+  void set_download_progress_interval(base::TimeDelta interval) {
+    download_progress_interval_ = interval;
+  }
+  base::TimeDelta download_progress_interval() const {
+    return download_progress_interval_;
+  }
+  void set_download_progress_bytes(int64_t bytes) {
+    download_progress_bytes_ = bytes;
+  }
+  int64_t download_progress_bytes() const { return download_progress_bytes_; }
+
  private:
   // The user data key.
   static int kLocatorKey;
 
   std::vector<base::FilePath> preloads_;
+  base::TimeDelta download_progress_interval_;
+  int64_t download_progress_bytes_ = 0;
 };
 
 }  // namespace electron
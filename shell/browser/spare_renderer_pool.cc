@@ -0,0 +1,141 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/spare_renderer_pool.h"
+
+#include <utility>
+
+#include "base/memory/ptr_util.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "content/public/browser/browser_context.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "shell/browser/web_contents_preferences.h"
+#include "shell/common/gin_helper/dictionary.h"
+#include "shell/common/options_switches.h"
+
+namespace electron {
+
+// static
+int SpareRendererPool::kLocatorKey = 0;
+
+SpareRendererPool::ScopedClaim::ScopedClaim(
+    content::BrowserContext* context,
+    const gin_helper::Dictionary& web_preferences) {
+  auto* pool = FromBrowserContext(context);
+  if (!pool || !pool->enabled())
+    return;
+  pool->claim_ =
+      WebContentsPreferences::GetProcessLaunchPreferences(web_preferences);
+  pool->claim_hit_ = false;
+  pool_ = pool->weak_factory_.GetWeakPtr();
+}
+
+SpareRendererPool::ScopedClaim::~ScopedClaim() {
+  if (pool_)
+    pool_->EndClaim();
+}
+
+// static
+SpareRendererPool* SpareRendererPool::FromBrowserContext(
+    content::BrowserContext* context) {
+  return static_cast<SpareRendererPool*>(context->GetUserData(&kLocatorKey));
+}
+
+SpareRendererPool::SpareRendererPool(content::BrowserContext* context)
+    : context_(context) {
+  context->SetUserData(&kLocatorKey, base::WrapUnique(this));
+}
+
+SpareRendererPool::~SpareRendererPool() {
+  ReleaseSpare();
+}
+
+void SpareRendererPool::SetEnabled(bool enabled) {
+  enabled_ = enabled;
+  if (enabled)
+    Refill();
+  else
+    profile_.reset();
+}
+
+void SpareRendererPool::OnWindowCreated(
+    const gin_helper::Dictionary& web_preferences,
+    content::WebContents* web_contents) {
+  auto* preferences = WebContentsPreferences::From(web_contents);
+  if (!enabled_ || !preferences)
+    return;
+  Profile profile;
+  profile.preferences =
+      WebContentsPreferences::GetProcessLaunchPreferences(web_preferences);
+  // The switch is copied from the browser process before the webPreferences
+  // switches are appended, and changes which of them are added.
+  if (base::CommandLine::ForCurrentProcess()->HasSwitch(
+          switches::kEnableSandbox))
+    profile.switches.AppendSwitch(switches::kEnableSandbox);
+  preferences->AppendCommandLineSwitches(&profile.switches,
+                                         false /* is_subframe */);
+  profile_ = std::move(profile);
+  // Launch the next spare once the window is done with its own startup.
+  base::SequencedTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE,
+      base::BindOnce(&SpareRendererPool::Refill, weak_factory_.GetWeakPtr()));
+}
+
+void SpareRendererPool::AppendSwitchesForSpare(
+    int process_id,
+    base::CommandLine* command_line) {
+  if (!warming_up_ || !profile_)
+    return;
+  command_line->AppendArguments(profile_->switches,
+                                false /* include_program */);
+  ReleaseSpare();
+  spare_ = content::RenderProcessHost::FromID(process_id);
+  if (!spare_)
+    return;
+  spare_->AddObserver(this);
+  spare_preferences_ = profile_->preferences.Clone();
+  stats_.launched++;
+}
+
+bool SpareRendererPool::ShouldUseSpare() {
+  // A spare that was not launched by the pool has none of the webPreferences
+  // switches, so it is never handed out.
+  if (!claim_ || !spare_ || *spare_preferences_ != *claim_)
+    return false;
+  claim_hit_ = true;
+  stats_.hits++;
+  // The spare now belongs to the window being created.
+  ReleaseSpare();
+  return true;
+}
+
+void SpareRendererPool::EndClaim() {
+  if (!claim_hit_)
+    stats_.misses++;
+  claim_.reset();
+}
+
+void SpareRendererPool::Refill() {
+  if (!enabled_ || !profile_ || spare_)
+    return;
+  warming_up_ = true;
+  content::RenderProcessHost::WarmupSpareRenderProcessHost(context_);
+  warming_up_ = false;
+}
+
+void SpareRendererPool::ReleaseSpare() {
+  if (spare_)
+    spare_->RemoveObserver(this);
+  spare_ = nullptr;
+  spare_preferences_.reset();
+}
+
+void SpareRendererPool::RenderProcessHostDestroyed(
+    content::RenderProcessHost* host) {
+  if (host == spare_)
+    ReleaseSpare();
+}
+
+}  // namespace electron
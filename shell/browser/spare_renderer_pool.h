@@ -0,0 +1,123 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_SPARE_RENDERER_POOL_H_
+#define ELECTRON_SHELL_BROWSER_SPARE_RENDERER_POOL_H_
+
+#include <cstdint>
+
+#include "base/command_line.h"
+#include "base/memory/raw_ptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/supports_user_data.h"
+#include "base/values.h"
+#include "content/public/browser/render_process_host_observer.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace content {
+class BrowserContext;
+class RenderProcessHost;
+class WebContents;
+}  // namespace content
+
+namespace gin_helper {
+class Dictionary;
+}
+
+namespace electron {
+
+// Keeps a spare renderer process running for a session, launched with the
+// command line switches derived from the webPreferences of the last window
+// created in the session. A new window whose webPreferences produce the same
+// switches takes the spare process instead of waiting for a renderer (and
+// its Node.js bindings) to start.
+//
+// Chromium keeps at most one spare renderer process at a time, shared by all
+// sessions.
+class SpareRendererPool : public base::SupportsUserData::Data,
+                          public content::RenderProcessHostObserver {
+ public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t launched = 0;
+  };
+
+  // Marks the window being created while it is in scope. A WebContents picks
+  // the process of its initial frame when it is created.
+  class ScopedClaim {
+   public:
+    ScopedClaim(content::BrowserContext* context,
+                const gin_helper::Dictionary& web_preferences);
+    ~ScopedClaim();
+
+    // disable copy
+    ScopedClaim(const ScopedClaim&) = delete;
+    ScopedClaim& operator=(const ScopedClaim&) = delete;
+
+   private:
+    base::WeakPtr<SpareRendererPool> pool_;
+  };
+
+  static SpareRendererPool* FromBrowserContext(
+      content::BrowserContext* context);
+
+  explicit SpareRendererPool(content::BrowserContext* context);
+  ~SpareRendererPool() override;
+
+  void SetEnabled(bool enabled);
+  bool enabled() const { return enabled_; }
+  const Stats& stats() const { return stats_; }
+
+  // Remembers the webPreferences of a new window to launch the next spare
+  // process with.
+  void OnWindowCreated(const gin_helper::Dictionary& web_preferences,
+                       content::WebContents* web_contents);
+
+  // Called when |process_id| is about to be launched without a WebContents,
+  // appends the switches of the spare being warmed up, if any.
+  void AppendSwitchesForSpare(int process_id, base::CommandLine* command_line);
+
+  // Whether the spare process may be used for the process being picked,
+  // which is only the case when it matches the window being created.
+  bool ShouldUseSpare();
+
+ private:
+  struct Profile {
+    base::Value::Dict preferences;
+    base::CommandLine switches{base::CommandLine::NO_PROGRAM};
+  };
+
+  void EndClaim();
+  void Refill();
+  void ReleaseSpare();
+
+  // content::RenderProcessHostObserver:
+  void RenderProcessHostDestroyed(content::RenderProcessHost* host) override;
+
+  // The user data key.
+  static int kLocatorKey;
+
+  raw_ptr<content::BrowserContext> context_;
+  bool enabled_ = false;
+  Stats stats_;
+
+  // The profile of the last window created in the session.
+  absl::optional<Profile> profile_;
+
+  // The spare process and the preferences it was launched for.
+  raw_ptr<content::RenderProcessHost> spare_ = nullptr;
+  absl::optional<base::Value::Dict> spare_preferences_;
+  bool warming_up_ = false;
+
+  // The preferences of the window being created.
+  absl::optional<base::Value::Dict> claim_;
+  bool claim_hit_ = false;
+
+  base::WeakPtrFactory<SpareRendererPool> weak_factory_{this};
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_SPARE_RENDERER_POOL_H_
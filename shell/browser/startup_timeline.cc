@@ -0,0 +1,116 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/browser/startup_timeline.h"
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <utility>
+
+#include "base/barrier_callback.h"
+#include "base/process/process.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "services/service_manager/public/cpp/interface_provider.h"
+#include "shell/browser/api/electron_api_utility_process.h"
+#include "shell/browser/api/electron_api_web_contents.h"
+#include "shell/common/api/api.mojom.h"
+
+namespace electron {
+
+namespace {
+
+using MarksBarrier = base::RepeatingCallback<void(ProcessStartupMarks)>;
+
+void OnStartupMarks(const std::string& type,
+                    base::ProcessId pid,
+                    MarksBarrier barrier,
+                    std::vector<mojom::StartupMarkPtr> marks) {
+  ProcessStartupMarks process;
+  process.type = type;
+  process.pid = pid;
+  for (const auto& mark : marks)
+    process.marks.push_back({mark->name, mark->start, mark->duration});
+  barrier.Run(std::move(process));
+}
+
+void OnCollected(
+    base::OnceCallback<void(std::vector<ProcessStartupMarks>)> callback,
+    std::vector<ProcessStartupMarks> processes) {
+  // The processes replied in any order.
+  std::stable_partition(processes.begin(), processes.end(),
+                        [](const ProcessStartupMarks& process) {
+                          return process.type == "browser";
+                        });
+  std::move(callback).Run(std::move(processes));
+}
+
+}  // namespace
+
+ProcessStartupMarks::ProcessStartupMarks() = default;
+ProcessStartupMarks::ProcessStartupMarks(ProcessStartupMarks&&) = default;
+ProcessStartupMarks& ProcessStartupMarks::operator=(ProcessStartupMarks&&) =
+    default;
+ProcessStartupMarks::~ProcessStartupMarks() = default;
+
+void CollectStartupTimeline(
+    base::OnceCallback<void(std::vector<ProcessStartupMarks>)> callback) {
+  // Asking a single frame is enough, the marks are per process.
+  std::set<int> render_process_ids;
+  std::vector<content::RenderFrameHost*> frames;
+  for (api::WebContents* contents : api::WebContents::GetAll()) {
+    if (!contents->web_contents())
+      continue;
+    content::RenderFrameHost* frame =
+        contents->web_contents()->GetPrimaryMainFrame();
+    if (!frame || !frame->IsRenderFrameLive())
+      continue;
+    if (render_process_ids.insert(frame->GetProcess()->GetID()).second)
+      frames.push_back(frame);
+  }
+  std::vector<api::UtilityProcessWrapper*> utility_processes =
+      api::UtilityProcessWrapper::GetAll();
+
+  MarksBarrier barrier = base::BarrierCallback<ProcessStartupMarks>(
+      1 + frames.size() + utility_processes.size(),
+      base::BindOnce(&OnCollected, std::move(callback)));
+
+  ProcessStartupMarks browser;
+  browser.type = "browser";
+  browser.pid = base::Process::Current().Pid();
+  browser.marks = GetStartupMarks();
+  barrier.Run(std::move(browser));
+
+  for (content::RenderFrameHost* frame : frames) {
+    // The remote is kept alive until the renderer replied, or went away.
+    auto electron_renderer =
+        std::make_unique<mojo::Remote<mojom::ElectronRenderer>>();
+    frame->GetRemoteInterfaces()->GetInterface(
+        electron_renderer->BindNewPipeAndPassReceiver());
+    auto* raw_ptr = electron_renderer.get();
+    (*raw_ptr)->GetStartupMarks(mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+        base::BindOnce(
+            [](mojo::Remote<mojom::ElectronRenderer>* ep,
+               base::ProcessId pid, MarksBarrier barrier,
+               std::vector<mojom::StartupMarkPtr> marks) {
+              OnStartupMarks("renderer", pid, std::move(barrier),
+                             std::move(marks));
+            },
+            base::Owned(std::move(electron_renderer)),
+            frame->GetProcess()->GetProcess().Pid(), barrier),
+        std::vector<mojom::StartupMarkPtr>()));
+  }
+
+  for (api::UtilityProcessWrapper* utility_process : utility_processes) {
+    utility_process->GetStartupMarks(
+        base::BindOnce(&OnStartupMarks, "utility", utility_process->pid(),
+                       barrier));
+  }
+}
+
+}  // namespace electron
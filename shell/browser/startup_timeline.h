@@ -0,0 +1,38 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_BROWSER_STARTUP_TIMELINE_H_
+#define ELECTRON_SHELL_BROWSER_STARTUP_TIMELINE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/process/process_handle.h"
+#include "shell/common/startup_marks.h"
+
+namespace electron {
+
+struct ProcessStartupMarks {
+  ProcessStartupMarks();
+  ProcessStartupMarks(ProcessStartupMarks&&);
+  ProcessStartupMarks& operator=(ProcessStartupMarks&&);
+  ~ProcessStartupMarks();
+
+  // "browser", "renderer" or "utility".
+  std::string type;
+  base::ProcessId pid = base::kNullProcessId;
+  std::vector<StartupMark> marks;
+};
+
+// Collects the startup marks of the browser process, of the renderer
+// processes hosting a WebContents and of the utility processes, and runs
+// |callback| with them once every process replied. The browser process comes
+// first.
+void CollectStartupTimeline(
+    base::OnceCallback<void(std::vector<ProcessStartupMarks>)> callback);
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_BROWSER_STARTUP_TIMELINE_H_
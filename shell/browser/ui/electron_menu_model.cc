@@ -16,6 +16,10 @@ ElectronMenuModel::SharingItem::SharingItem(SharingItem&&) = default;
 ElectronMenuModel::SharingItem::~SharingItem() = default;
 #endif
 
+ElectronMenuModel::CommandState::CommandState() = default;
+ElectronMenuModel::CommandState::CommandState(const CommandState&) = default;
+ElectronMenuModel::CommandState::~CommandState() = default;
+
 bool ElectronMenuModel::Delegate::GetAcceleratorForCommandId(
     int command_id,
     ui::Accelerator* accelerator) const {
@@ -50,6 +54,20 @@ std::u16string ElectronMenuModel::GetRoleAt(size_t index) {
   return iter == std::end(roles_) ? std::u16string() : iter->second;
 }
 
+void ElectronMenuModel::SetCommandState(int command_id, CommandState state) {
+  command_states_[command_id] = std::move(state);
+}
+
+const ElectronMenuModel::CommandState* ElectronMenuModel::GetCommandState(
+    int command_id) const {
+  const auto iter = command_states_.find(command_id);
+  return iter == std::end(command_states_) ? nullptr : &iter->second;
+}
+
+void ElectronMenuModel::ClearCommandStates() {
+  command_states_.clear();
+}
+
 void ElectronMenuModel::SetSecondaryLabel(size_t index,
                                           const std::u16string& sublabel) {
   int command_id = GetCommandIdAt(index);
@@ -14,6 +14,7 @@
 #include "base/observer_list.h"
 #include "base/observer_list_types.h"
 #include "third_party/abseil-cpp/absl/types/optional.h"
+#include "ui/base/accelerators/accelerator.h"
 #include "ui/base/models/simple_menu_model.h"
 #include "url/gurl.h"
 
@@ -34,6 +35,24 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
   };
 #endif
 
+  // The state of a menu item as last pushed by JavaScript, which lets the
+  // delegate answer the queries of the menu without calling into JavaScript.
+  struct CommandState {
+    CommandState();
+    CommandState(const CommandState&);
+    ~CommandState();
+
+    bool checked = false;
+    // The checked state is computed by a role and has to be queried.
+    bool dynamic_checked = false;
+    bool enabled = true;
+    bool visible = true;
+    bool works_when_hidden = true;
+    bool register_accelerator = true;
+    absl::optional<ui::Accelerator> accelerator;
+    absl::optional<ui::Accelerator> default_accelerator;
+  };
+
   class Delegate : public ui::SimpleMenuModel::Delegate {
    public:
     ~Delegate() override {}
@@ -85,6 +104,10 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
   std::u16string GetToolTipAt(size_t index);
   void SetRole(size_t index, const std::u16string& role);
   std::u16string GetRoleAt(size_t index);
+  void SetCommandState(int command_id, CommandState state);
+  // Returns nullptr if no state was pushed for |command_id|.
+  const CommandState* GetCommandState(int command_id) const;
+  void ClearCommandStates();
   void SetSecondaryLabel(size_t index, const std::u16string& sublabel);
   std::u16string GetSecondaryLabelAt(size_t index) const override;
   bool GetAcceleratorAtWithParams(size_t index,
@@ -121,6 +144,8 @@ class ElectronMenuModel : public ui::SimpleMenuModel {
   std::map<int, std::u16string> toolTips_;   // command id -> tooltip
   std::map<int, std::u16string> roles_;      // command id -> role
   std::map<int, std::u16string> sublabels_;  // command id -> sublabel
+  // command id -> state
+  std::map<int, CommandState> command_states_;
   base::ObserverList<Observer> observers_;
 
   base::WeakPtrFactory<ElectronMenuModel> weak_factory_{this};
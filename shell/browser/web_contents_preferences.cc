@@ -336,6 +336,33 @@ WebContentsPreferences* WebContentsPreferences::From(
   return FromWebContents(web_contents);
 }
 
+// static
+base::Value::Dict WebContentsPreferences::GetProcessLaunchPreferences(
+    const gin_helper::Dictionary& web_preferences) {
+  // Keep in sync with AppendCommandLineSwitches() and IsSandboxed().
+  static const char* const kProcessLaunchPreferences[] = {
+      options::kExperimentalFeatures,
+      options::kNodeIntegration,
+      options::kNodeIntegrationInSubFrames,
+      options::kNodeIntegrationInWorker,
+      options::kSandbox,
+      options::kCustomArgs,
+      "commandLineSwitches",
+      options::kEnableBlinkFeatures,
+      options::kDisableBlinkFeatures,
+#if BUILDFLAG(IS_MAC)
+      options::kScrollBounce,
+#endif
+  };
+  base::Value::Dict result;
+  for (const char* name : kProcessLaunchPreferences) {
+    base::Value value;
+    if (web_preferences.Get(name, &value))
+      result.Set(name, std::move(value));
+  }
+  return result;
+}
+
 void WebContentsPreferences::AppendCommandLineSwitches(
     base::CommandLine* command_line,
     bool is_subframe) {
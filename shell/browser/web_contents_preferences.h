@@ -46,6 +46,12 @@ class WebContentsPreferences
   void AppendCommandLineSwitches(base::CommandLine* command_line,
                                  bool is_subframe);
 
+  // Returns the entries of |web_preferences| that AppendCommandLineSwitches()
+  // depends on. WebContents with equal entries launch their renderer process
+  // with the same switches.
+  static base::Value::Dict GetProcessLaunchPreferences(
+      const gin_helper::Dictionary& web_preferences);
+
   // Modify the WebPreferences according to preferences.
   void OverrideWebkitPrefs(blink::web_pref::WebPreferences* prefs);
 
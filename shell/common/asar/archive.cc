@@ -20,6 +20,7 @@
 #include "electron/fuses.h"
 #include "shell/common/asar/asar_util.h"
 #include "shell/common/asar/scoped_temporary_file.h"
+#include "shell/common/startup_marks.h"
 
 #if BUILDFLAG(IS_WIN)
 #include <io.h>
@@ -192,6 +193,7 @@ bool Archive::Init() {
   // Should only be initialized once
   CHECK(!initialized_);
   initialized_ = true;
+  electron::ScopedStartupPhase startup_phase("asar::Archive::Init");
 
   if (!file_.IsValid()) {
     if (file_.error_details() != base::File::FILE_ERROR_NOT_FOUND) {
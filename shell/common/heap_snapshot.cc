@@ -4,7 +4,14 @@
 
 #include "shell/common/heap_snapshot.h"
 
+#include <memory>
+#include <utility>
+
 #include "base/files/file.h"
+#include "base/json/json_writer.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "gin/converter.h"
 #include "v8/include/v8-profiler.h"
 #include "v8/include/v8.h"
 
@@ -32,6 +39,33 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   bool is_complete_ = false;
 };
 
+base::Value::Dict ConvertAllocationNode(
+    v8::Isolate* isolate,
+    const v8::AllocationProfile::Node* node) {
+  base::Value::Dict call_frame;
+  call_frame.Set("functionName", gin::V8ToString(isolate, node->name));
+  call_frame.Set("scriptId", base::NumberToString(node->script_id));
+  call_frame.Set("url", gin::V8ToString(isolate, node->script_name));
+  // DevTools expects zero-based positions.
+  call_frame.Set("lineNumber", node->line_number - 1);
+  call_frame.Set("columnNumber", node->column_number - 1);
+
+  double self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+
+  base::Value::List children;
+  for (const auto* child : node->children)
+    children.Append(ConvertAllocationNode(isolate, child));
+
+  base::Value::Dict result;
+  result.Set("callFrame", std::move(call_frame));
+  result.Set("selfSize", self_size);
+  result.Set("id", static_cast<int>(node->node_id));
+  result.Set("children", std::move(children));
+  return result;
+}
+
 }  // namespace
 
 namespace electron {
@@ -43,16 +77,62 @@ bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
   if (!file->IsValid())
     return false;
 
-  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  HeapSnapshotOutputStream stream(file);
+  if (!TakeHeapSnapshot(isolate, &stream, nullptr))
+    return false;
+
+  return stream.IsComplete();
+}
+
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      v8::OutputStream* stream,
+                      v8::ActivityControl* control) {
+  DCHECK(isolate);
+  DCHECK(stream);
+
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot(control);
   if (!snapshot)
     return false;
 
-  HeapSnapshotOutputStream stream(file);
-  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+  snapshot->Serialize(stream, v8::HeapSnapshot::kJSON);
 
   const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
 
-  return stream.IsComplete();
+  return true;
+}
+
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth) {
+  return isolate->GetHeapProfiler()->StartSamplingHeapProfiler(sample_interval,
+                                                               stack_depth);
+}
+
+absl::optional<std::string> StopSamplingHeapProfiler(v8::Isolate* isolate) {
+  v8::HandleScope handle_scope(isolate);
+  auto* heap_profiler = isolate->GetHeapProfiler();
+  std::unique_ptr<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  if (!profile)
+    return absl::nullopt;
+  heap_profiler->StopSamplingHeapProfiler();
+
+  base::Value::List samples;
+  for (const auto& sample : profile->GetSamples()) {
+    base::Value::Dict dict;
+    dict.Set("size", static_cast<double>(sample.size) * sample.count);
+    dict.Set("nodeId", static_cast<int>(sample.node_id));
+    dict.Set("ordinal", static_cast<double>(sample.sample_id));
+    samples.Append(std::move(dict));
+  }
+
+  base::Value::Dict result;
+  result.Set("head", ConvertAllocationNode(isolate, profile->GetRootNode()));
+  result.Set("samples", std::move(samples));
+  std::string json;
+  if (!base::JSONWriter::Write(result, &json))
+    return absl::nullopt;
+  return json;
 }
 
 }  // namespace electron
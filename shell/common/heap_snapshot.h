@@ -5,18 +5,40 @@
 #ifndef ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 #define ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
 
+#include <cstdint>
+#include <string>
+
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
 namespace base {
 class File;
 }
 
 namespace v8 {
+class ActivityControl;
 class Isolate;
-}
+class OutputStream;
+}  // namespace v8
 
 namespace electron {
 
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
 
+// Serializes a heap snapshot as JSON into |stream|, |control| is told about
+// the progress of taking the snapshot when not null. Returns false if the
+// snapshot could not be taken.
+bool TakeHeapSnapshot(v8::Isolate* isolate,
+                      v8::OutputStream* stream,
+                      v8::ActivityControl* control);
+
+bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                               uint64_t sample_interval,
+                               int stack_depth);
+
+// Stops the sampling heap profiler and returns the profile in the JSON format
+// of DevTools' .heapprofile files.
+absl::optional<std::string> StopSamplingHeapProfiler(v8::Isolate* isolate);
+
 }  // namespace electron
 
 #endif  // ELECTRON_SHELL_COMMON_HEAP_SNAPSHOT_H_
@@ -37,6 +37,7 @@
 #include "shell/common/gin_helper/microtasks_scope.h"
 #include "shell/common/mac/main_application_bundle.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_marks.h"
 #include "third_party/blink/renderer/bindings/core/v8/v8_initializer.h"  // nogncheck
 #include "third_party/electron_node/src/debug_utils.h"
 
@@ -55,6 +56,7 @@
   V(electron_browser_event_emitter)      \
   V(electron_browser_global_shortcut)    \
   V(electron_browser_in_app_purchase)    \
+  V(electron_browser_ipc_main)           \
   V(electron_browser_menu)               \
   V(electron_browser_message_port)       \
   V(electron_browser_native_theme)       \
@@ -497,6 +499,9 @@ node::Environment* NodeBindings::CreateEnvironment(
       break;
   }
 
+  TRACE_EVENT1("electron", "NodeBindings::CreateEnvironment", "process_type",
+               process_type);
+
   v8::Isolate* isolate = context->GetIsolate();
   gin_helper::Dictionary global(isolate, context->Global());
   // Avoids overriding globals like setImmediate, clearImmediate
@@ -587,6 +592,39 @@ node::Environment* NodeBindings::CreateEnvironment(
     global.Delete("_noBrowserGlobals");
   }
 
+  // The isolate callbacks only need to be installed once, even though the
+  // renderer creates an environment for every frame with node integration.
+  if (!isolate_set_up_) {
+    SetUpIsolate(isolate);
+    isolate_set_up_ = true;
+  }
+
+  gin_helper::Dictionary process(context->GetIsolate(), env->process_object());
+  process.SetReadOnly("type", process_type);
+  process.Set("resourcesPath", resources_path);
+  // The path to helper app.
+  base::FilePath helper_exec_path;
+  base::PathService::Get(content::CHILD_PROCESS_EXE, &helper_exec_path);
+  process.Set("helperExecPath", helper_exec_path);
+
+  return env;
+}
+
+node::Environment* NodeBindings::CreateEnvironment(
+    v8::Handle<v8::Context> context,
+    node::MultiIsolatePlatform* platform) {
+#if BUILDFLAG(IS_WIN)
+  auto& electron_args = ElectronCommandLine::argv();
+  std::vector<std::string> args(electron_args.size());
+  std::transform(electron_args.cbegin(), electron_args.cend(), args.begin(),
+                 [](auto& a) { return base::WideToUTF8(a); });
+#else
+  auto args = ElectronCommandLine::argv();
+#endif
+  return CreateEnvironment(context, platform, args, {});
+}
+
+void NodeBindings::SetUpIsolate(v8::Isolate* isolate) {
   node::IsolateSettings is;
 
   // Use a custom fatal error callback to allow us to add
@@ -621,7 +659,7 @@ node::Environment* NodeBindings::CreateEnvironment(
     // could be either kExplicit or kScoped depending on whether we're executing
     // from within a Node.js or a Blink entrypoint. Instead, the policy is
     // toggled to kExplicit when entering Node.js through UvRunOnce.
-    is.policy = context->GetIsolate()->GetMicrotasksPolicy();
+    is.policy = isolate->GetMicrotasksPolicy();
 
     // We do not want to use Node.js' message listener as it interferes with
     // Blink's.
@@ -630,8 +668,8 @@ node::Environment* NodeBindings::CreateEnvironment(
     // Isolate message listeners are additive (you can add multiple), so instead
     // we add an extra one here to ensure that the async hook stack is properly
     // cleared when errors are thrown.
-    context->GetIsolate()->AddMessageListenerWithErrorLevel(
-        ErrorMessageListener, v8::Isolate::kMessageError);
+    isolate->AddMessageListenerWithErrorLevel(ErrorMessageListener,
+                                              v8::Isolate::kMessageError);
 
     // We do not want to use the promise rejection callback that Node.js uses,
     // because it does not send PromiseRejectionEvents to the global script
@@ -647,34 +685,11 @@ node::Environment* NodeBindings::CreateEnvironment(
         node::IsolateSettingsFlags::SHOULD_NOT_SET_PREPARE_STACK_TRACE_CALLBACK;
   }
 
-  node::SetIsolateUpForNode(context->GetIsolate(), is);
-
-  gin_helper::Dictionary process(context->GetIsolate(), env->process_object());
-  process.SetReadOnly("type", process_type);
-  process.Set("resourcesPath", resources_path);
-  // The path to helper app.
-  base::FilePath helper_exec_path;
-  base::PathService::Get(content::CHILD_PROCESS_EXE, &helper_exec_path);
-  process.Set("helperExecPath", helper_exec_path);
-
-  return env;
-}
-
-node::Environment* NodeBindings::CreateEnvironment(
-    v8::Handle<v8::Context> context,
-    node::MultiIsolatePlatform* platform) {
-#if BUILDFLAG(IS_WIN)
-  auto& electron_args = ElectronCommandLine::argv();
-  std::vector<std::string> args(electron_args.size());
-  std::transform(electron_args.cbegin(), electron_args.cend(), args.begin(),
-                 [](auto& a) { return base::WideToUTF8(a); });
-#else
-  auto args = ElectronCommandLine::argv();
-#endif
-  return CreateEnvironment(context, platform, args, {});
+  node::SetIsolateUpForNode(isolate, is);
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  ScopedStartupPhase startup_phase("NodeBindings::LoadEnvironment");
   node::LoadEnvironment(env, node::StartExecutionCallback{});
   gin_helper::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
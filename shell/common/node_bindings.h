@@ -150,6 +150,9 @@ class NodeBindings {
   // Thread to poll uv events.
   static void EmbedThreadRunner(void* arg);
 
+  // Installs the isolate-wide callbacks Node.js relies on.
+  void SetUpIsolate(v8::Isolate* isolate);
+
   // Indicates whether polling thread has been created.
   bool initialized_ = false;
 
@@ -174,6 +177,9 @@ class NodeBindings {
   // Isolate data used in creating the environment
   node::IsolateData* isolate_data_ = nullptr;
 
+  // Whether SetUpIsolate() has been called for the isolate.
+  bool isolate_set_up_ = false;
+
   base::WeakPtrFactory<NodeBindings> weak_factory_{this};
 };
 
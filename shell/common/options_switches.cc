@@ -253,6 +253,9 @@ const char kWidevineCdmVersion[] = "widevine-cdm-version";
 // Forces the maximum disk space to be used by the disk cache, in bytes.
 const char kDiskCacheSize[] = "disk-cache-size";
 
+// Number of connections used to download large files in parallel.
+const char kDownloadConnections[] = "download-connections";
+
 // Ignore the limit of 6 connections per host.
 const char kIgnoreConnectionsLimit[] = "ignore-connections-limit";
 
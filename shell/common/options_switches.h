@@ -125,6 +125,7 @@ extern const char kWidevineCdmPath[];
 extern const char kWidevineCdmVersion[];
 
 extern const char kDiskCacheSize[];
+extern const char kDownloadConnections[];
 extern const char kIgnoreConnectionsLimit[];
 extern const char kAuthServerWhitelist[];
 extern const char kAuthNegotiateDelegateWhitelist[];
@@ -0,0 +1,90 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "shell/common/startup_marks.h"
+
+#include <algorithm>
+
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/trace_event.h"
+
+namespace electron {
+
+namespace {
+
+// Some marks are recorded for each frame or archive, only the first ones
+// matter for the startup.
+constexpr size_t kMaxStartupMarks = 256;
+
+class StartupMarkList {
+ public:
+  static StartupMarkList* Get() {
+    static base::NoDestructor<StartupMarkList> list;
+    return list.get();
+  }
+
+  void Add(const char* name,
+           base::TimeTicks start,
+           base::TimeDelta duration,
+           bool once) {
+    base::AutoLock lock(lock_);
+    if (marks_.size() >= kMaxStartupMarks)
+      return;
+    if (once && std::any_of(marks_.begin(), marks_.end(),
+                            [name](const StartupMark& mark) {
+                              return mark.name == name;
+                            }))
+      return;
+    marks_.push_back({name, start, duration});
+  }
+
+  std::vector<StartupMark> Get() const {
+    base::AutoLock lock(lock_);
+    return marks_;
+  }
+
+ private:
+  mutable base::Lock lock_;
+  std::vector<StartupMark> marks_;
+};
+
+void AddMark(const char* name, bool once) {
+  TRACE_EVENT_INSTANT0("electron", name, TRACE_EVENT_SCOPE_PROCESS);
+  StartupMarkList::Get()->Add(name, base::TimeTicks::Now(), base::TimeDelta(),
+                              once);
+}
+
+}  // namespace
+
+void AddStartupMark(const char* name) {
+  AddMark(name, false);
+}
+
+void AddStartupMarkOnce(const char* name) {
+  AddMark(name, true);
+}
+
+std::vector<StartupMark> GetStartupMarks() {
+  std::vector<StartupMark> marks = StartupMarkList::Get()->Get();
+  // Phases are added when they end, after the phases nested in them.
+  std::stable_sort(marks.begin(), marks.end(),
+                   [](const StartupMark& a, const StartupMark& b) {
+                     return a.start < b.start;
+                   });
+  return marks;
+}
+
+ScopedStartupPhase::ScopedStartupPhase(const char* name)
+    : name_(name), start_(base::TimeTicks::Now()) {
+  TRACE_EVENT_BEGIN0("electron", name_);
+}
+
+ScopedStartupPhase::~ScopedStartupPhase() {
+  TRACE_EVENT_END0("electron", name_);
+  StartupMarkList::Get()->Add(name_, start_, base::TimeTicks::Now() - start_,
+                              false);
+}
+
+}  // namespace electron
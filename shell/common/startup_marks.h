@@ -0,0 +1,53 @@
+// Copyright (c) 2022 Microsoft, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ELECTRON_SHELL_COMMON_STARTUP_MARKS_H_
+#define ELECTRON_SHELL_COMMON_STARTUP_MARKS_H_
+
+#include <string>
+#include <vector>
+
+#include "base/time/time.h"
+
+namespace electron {
+
+// A point or a phase of the startup of the current process.
+struct StartupMark {
+  std::string name;
+  base::TimeTicks start;
+  // Zero for a point.
+  base::TimeDelta duration;
+};
+
+// Records a point of the startup of the current process, and emits it as a
+// trace event in the "electron" category. |name| must be a string literal.
+// Can be called from any thread.
+void AddStartupMark(const char* name);
+
+// Same as AddStartupMark(), but only the first call with |name| is recorded.
+void AddStartupMarkOnce(const char* name);
+
+// Returns the marks recorded in the current process, ordered by start.
+std::vector<StartupMark> GetStartupMarks();
+
+// Records the lifetime of the scope as a phase of the startup of the current
+// process, and emits it as a trace event in the "electron" category. |name|
+// must be a string literal.
+class ScopedStartupPhase {
+ public:
+  explicit ScopedStartupPhase(const char* name);
+  ~ScopedStartupPhase();
+
+  // disable copy
+  ScopedStartupPhase(const ScopedStartupPhase&) = delete;
+  ScopedStartupPhase& operator=(const ScopedStartupPhase&) = delete;
+
+ private:
+  const char* name_;
+  base::TimeTicks start_;
+};
+
+}  // namespace electron
+
+#endif  // ELECTRON_SHELL_COMMON_STARTUP_MARKS_H_
@@ -4,6 +4,9 @@
 
 #include <string>
 
+#include "base/process/process_handle.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_frame_observer.h"
@@ -33,6 +36,23 @@ namespace {
 const char kIPCMethodCalledAfterContextReleasedError[] =
     "IPC method called after context was released";
 
+// Returns an id for the "electron.ipc" flow events of a message, unique
+// across renderer processes.
+uint64_t NextTraceId() {
+  static uint32_t next_id = 0;
+  return (static_cast<uint64_t>(base::GetCurrentProcId()) << 32) | ++next_id;
+}
+
+// Creates the timing information sent along with a message whose arguments
+// started being serialized at |serialize_start|.
+electron::mojom::IpcMessageTimingPtr CreateMessageTiming(
+    base::TimeTicks serialize_start,
+    uint64_t trace_id) {
+  base::TimeTicks now = base::TimeTicks::Now();
+  return electron::mojom::IpcMessageTiming::New(now, now - serialize_start,
+                                                trace_id);
+}
+
 RenderFrame* GetCurrentRenderFrame() {
   WebLocalFrame* frame = WebLocalFrame::FrameForCurrentContext();
   if (!frame)
@@ -95,11 +115,18 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return;
     }
+    const uint64_t trace_id = NextTraceId();
+    TRACE_EVENT_WITH_FLOW1("electron.ipc", "IPCRenderer::SendMessage",
+                           TRACE_ID_GLOBAL(trace_id),
+                           TRACE_EVENT_FLAG_FLOW_OUT, "channel", channel);
+    const base::TimeTicks serialize_start = base::TimeTicks::Now();
     blink::CloneableMessage message;
     if (!electron::SerializeV8Value(isolate, arguments, &message)) {
       return;
     }
-    electron_ipc_remote_->Message(internal, channel, std::move(message));
+    electron_ipc_remote_->Message(
+        internal, channel, std::move(message),
+        CreateMessageTiming(serialize_start, trace_id));
   }
 
   v8::Local<v8::Promise> Invoke(v8::Isolate* isolate,
@@ -111,6 +138,11 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return v8::Local<v8::Promise>();
     }
+    const uint64_t trace_id = NextTraceId();
+    TRACE_EVENT_WITH_FLOW1("electron.ipc", "IPCRenderer::Invoke",
+                           TRACE_ID_GLOBAL(trace_id),
+                           TRACE_EVENT_FLAG_FLOW_OUT, "channel", channel);
+    const base::TimeTicks serialize_start = base::TimeTicks::Now();
     blink::CloneableMessage message;
     if (!electron::SerializeV8Value(isolate, arguments, &message)) {
       return v8::Local<v8::Promise>();
@@ -120,6 +152,7 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
 
     electron_ipc_remote_->Invoke(
         internal, channel, std::move(message),
+        CreateMessageTiming(serialize_start, trace_id),
         base::BindOnce(
             [](gin_helper::Promise<blink::CloneableMessage> p,
                blink::CloneableMessage result) { p.Resolve(result); },
@@ -137,6 +170,11 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return;
     }
+    const uint64_t trace_id = NextTraceId();
+    TRACE_EVENT_WITH_FLOW1("electron.ipc", "IPCRenderer::PostMessage",
+                           TRACE_ID_GLOBAL(trace_id),
+                           TRACE_EVENT_FLAG_FLOW_OUT, "channel", channel);
+    const base::TimeTicks serialize_start = base::TimeTicks::Now();
     blink::TransferableMessage transferable_message;
     if (!electron::SerializeV8Value(isolate, message_value,
                                     &transferable_message)) {
@@ -165,8 +203,9 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
     }
 
     transferable_message.ports = std::move(ports);
-    electron_ipc_remote_->ReceivePostMessage(channel,
-                                             std::move(transferable_message));
+    electron_ipc_remote_->ReceivePostMessage(
+        channel, std::move(transferable_message),
+        CreateMessageTiming(serialize_start, trace_id));
   }
 
   void SendTo(v8::Isolate* isolate,
@@ -178,12 +217,18 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return;
     }
+    const uint64_t trace_id = NextTraceId();
+    TRACE_EVENT_WITH_FLOW1("electron.ipc", "IPCRenderer::SendTo",
+                           TRACE_ID_GLOBAL(trace_id),
+                           TRACE_EVENT_FLAG_FLOW_OUT, "channel", channel);
+    const base::TimeTicks serialize_start = base::TimeTicks::Now();
     blink::CloneableMessage message;
     if (!electron::SerializeV8Value(isolate, arguments, &message)) {
       return;
     }
-    electron_ipc_remote_->MessageTo(web_contents_id, channel,
-                                    std::move(message));
+    electron_ipc_remote_->MessageTo(
+        web_contents_id, channel, std::move(message),
+        CreateMessageTiming(serialize_start, trace_id));
   }
 
   void SendToHost(v8::Isolate* isolate,
@@ -194,11 +239,18 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return;
     }
+    const uint64_t trace_id = NextTraceId();
+    TRACE_EVENT_WITH_FLOW1("electron.ipc", "IPCRenderer::SendToHost",
+                           TRACE_ID_GLOBAL(trace_id),
+                           TRACE_EVENT_FLAG_FLOW_OUT, "channel", channel);
+    const base::TimeTicks serialize_start = base::TimeTicks::Now();
     blink::CloneableMessage message;
     if (!electron::SerializeV8Value(isolate, arguments, &message)) {
       return;
     }
-    electron_ipc_remote_->MessageHost(channel, std::move(message));
+    electron_ipc_remote_->MessageHost(
+        channel, std::move(message),
+        CreateMessageTiming(serialize_start, trace_id));
   }
 
   v8::Local<v8::Value> SendSync(v8::Isolate* isolate,
@@ -210,14 +262,20 @@ class IPCRenderer : public gin::Wrappable<IPCRenderer>,
       thrower.ThrowError(kIPCMethodCalledAfterContextReleasedError);
       return v8::Local<v8::Value>();
     }
+    const uint64_t trace_id = NextTraceId();
+    TRACE_EVENT_WITH_FLOW1("electron.ipc", "IPCRenderer::SendSync",
+                           TRACE_ID_GLOBAL(trace_id),
+                           TRACE_EVENT_FLAG_FLOW_OUT, "channel", channel);
+    const base::TimeTicks serialize_start = base::TimeTicks::Now();
     blink::CloneableMessage message;
     if (!electron::SerializeV8Value(isolate, arguments, &message)) {
       return v8::Local<v8::Value>();
     }
 
     blink::CloneableMessage result;
-    electron_ipc_remote_->MessageSync(internal, channel, std::move(message),
-                                      &result);
+    electron_ipc_remote_->MessageSync(
+        internal, channel, std::move(message),
+        CreateMessageTiming(serialize_start, trace_id), &result);
     return electron::DeserializeV8Value(isolate, result);
   }
 
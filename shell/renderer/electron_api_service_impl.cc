@@ -12,13 +12,17 @@
 #include "base/threading/thread_restrictions.h"
 #include "base/trace_event/trace_event.h"
 #include "gin/data_object_builder.h"
+#include "mojo/public/cpp/bindings/remote.h"
+#include "mojo/public/cpp/system/data_pipe.h"
 #include "mojo/public/cpp/system/platform_handle.h"
+#include "mojo/public/cpp/system/wait.h"
 #include "shell/common/electron_constants.h"
 #include "shell/common/gin_converters/blink_converter.h"
 #include "shell/common/gin_converters/value_converter.h"
 #include "shell/common/heap_snapshot.h"
 #include "shell/common/node_includes.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_marks.h"
 #include "shell/common/v8_value_serializer.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "shell/renderer/renderer_client_base.h"
@@ -26,6 +30,7 @@
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_local_frame.h"
 #include "third_party/blink/public/web/web_message_port_converter.h"
+#include "v8/include/v8-profiler.h"
 
 namespace electron {
 
@@ -33,6 +38,66 @@ namespace {
 
 const char kIpcKey[] = "ipcNative";
 
+// Writes a heap snapshot into a data pipe that the browser drains on a worker
+// thread, waiting for room in the pipe when it is full.
+class DataPipeOutputStream : public v8::OutputStream {
+ public:
+  explicit DataPipeOutputStream(mojo::ScopedDataPipeProducerHandle pipe)
+      : pipe_(std::move(pipe)) {}
+
+  bool IsComplete() const { return is_complete_; }
+
+  // v8::OutputStream
+  int GetChunkSize() override { return 65536; }
+  void EndOfStream() override { is_complete_ = true; }
+
+  v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
+    while (size > 0) {
+      uint32_t num_bytes = size;
+      MojoResult result =
+          pipe_->WriteData(data, &num_bytes, MOJO_WRITE_DATA_FLAG_NONE);
+      if (result == MOJO_RESULT_SHOULD_WAIT) {
+        if (mojo::Wait(pipe_.get(), MOJO_HANDLE_SIGNAL_WRITABLE) !=
+            MOJO_RESULT_OK)
+          return kAbort;
+        continue;
+      }
+      if (result != MOJO_RESULT_OK)
+        return kAbort;
+      data += num_bytes;
+      size -= num_bytes;
+    }
+    return kContinue;
+  }
+
+ private:
+  mojo::ScopedDataPipeProducerHandle pipe_;
+  bool is_complete_ = false;
+};
+
+// Forwards the progress of taking a heap snapshot to the browser.
+class HeapSnapshotProgress : public v8::ActivityControl {
+ public:
+  explicit HeapSnapshotProgress(
+      mojo::PendingRemote<mojom::HeapSnapshotClient> client)
+      : client_(std::move(client)) {}
+
+  // v8::ActivityControl
+  ControlOption ReportProgressValue(uint32_t done, uint32_t total) override {
+    uint32_t percent =
+        total ? static_cast<uint32_t>(uint64_t{done} * 100 / total) : 0;
+    if (percent != last_percent_) {
+      last_percent_ = percent;
+      client_->OnSnapshotProgress(percent);
+    }
+    return kContinue;
+  }
+
+ private:
+  mojo::Remote<mojom::HeapSnapshotClient> client_;
+  uint32_t last_percent_ = 0;
+};
+
 // Gets the private object under kIpcKey
 v8::Local<v8::Object> GetIpcObject(v8::Local<v8::Context> context) {
   auto* isolate = context->GetIsolate();
@@ -220,4 +285,40 @@ void ElectronApiServiceImpl::TakeHeapSnapshot(
   std::move(callback).Run(success);
 }
 
+void ElectronApiServiceImpl::StreamHeapSnapshot(
+    mojo::ScopedDataPipeProducerHandle pipe,
+    mojo::PendingRemote<mojom::HeapSnapshotClient> client,
+    StreamHeapSnapshotCallback callback) {
+  DataPipeOutputStream stream(std::move(pipe));
+  HeapSnapshotProgress progress(std::move(client));
+  bool success = electron::TakeHeapSnapshot(blink::MainThreadIsolate(),
+                                            &stream, &progress);
+  std::move(callback).Run(success && stream.IsComplete());
+  // The pipe is closed when |stream| goes out of scope, which tells the
+  // browser that all the data has been written.
+}
+
+void ElectronApiServiceImpl::StartSamplingHeapProfiler(
+    uint64_t sample_interval,
+    int32_t stack_depth,
+    StartSamplingHeapProfilerCallback callback) {
+  std::move(callback).Run(electron::StartSamplingHeapProfiler(
+      blink::MainThreadIsolate(), sample_interval, stack_depth));
+}
+
+void ElectronApiServiceImpl::StopSamplingHeapProfiler(
+    StopSamplingHeapProfilerCallback callback) {
+  std::move(callback).Run(
+      electron::StopSamplingHeapProfiler(blink::MainThreadIsolate()));
+}
+
+void ElectronApiServiceImpl::GetStartupMarks(
+    GetStartupMarksCallback callback) {
+  std::vector<mojom::StartupMarkPtr> marks;
+  for (const auto& mark : electron::GetStartupMarks())
+    marks.push_back(
+        mojom::StartupMark::New(mark.name, mark.start, mark.duration));
+  std::move(callback).Run(std::move(marks));
+}
+
 }  // namespace electron
@@ -40,6 +40,17 @@ class ElectronApiServiceImpl : public mojom::ElectronRenderer,
                           blink::TransferableMessage message) override;
   void TakeHeapSnapshot(mojo::ScopedHandle file,
                         TakeHeapSnapshotCallback callback) override;
+  void StreamHeapSnapshot(
+      mojo::ScopedDataPipeProducerHandle pipe,
+      mojo::PendingRemote<mojom::HeapSnapshotClient> client,
+      StreamHeapSnapshotCallback callback) override;
+  void StartSamplingHeapProfiler(
+      uint64_t sample_interval,
+      int32_t stack_depth,
+      StartSamplingHeapProfilerCallback callback) override;
+  void StopSamplingHeapProfiler(
+      StopSamplingHeapProfilerCallback callback) override;
+  void GetStartupMarks(GetStartupMarksCallback callback) override;
   void ProcessPendingMessages();
 
   base::WeakPtr<ElectronApiServiceImpl> GetWeakPtr() {
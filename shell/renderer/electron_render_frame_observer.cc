@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/memory/ref_counted_memory.h"
 #include "base/strings/string_number_conversions.h"
@@ -15,6 +16,7 @@
 #include "electron/buildflags/buildflags.h"
 #include "electron/shell/common/api/api.mojom.h"
 #include "ipc/ipc_message_macros.h"
+#include "mojo/public/cpp/bindings/equals_traits.h"
 #include "net/base/net_module.h"
 #include "net/grit/net_resources.h"
 #include "services/service_manager/public/cpp/interface_provider.h"
@@ -24,6 +26,7 @@
 #include "shell/renderer/renderer_client_base.h"
 #include "third_party/blink/public/common/associated_interfaces/associated_interface_provider.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
+#include "third_party/blink/public/platform/task_type.h"
 #include "third_party/blink/public/platform/web_isolated_world_info.h"
 #include "third_party/blink/public/web/blink.h"
 #include "third_party/blink/public/web/web_document.h"
@@ -138,6 +141,21 @@ void ElectronRenderFrameObserver::DidInstallConditionalFeatures(
 }
 
 void ElectronRenderFrameObserver::DraggableRegionsChanged() {
+  // Blink reports a change on every lifecycle update that touches an
+  // app-region element, e.g. on each frame of a CSS animation. Collect the
+  // regions once after the current frame instead of once per change.
+  if (draggable_regions_update_pending_)
+    return;
+  draggable_regions_update_pending_ = true;
+  render_frame_->GetTaskRunner(blink::TaskType::kInternalDefault)
+      ->PostTask(FROM_HERE,
+                 base::BindOnce(
+                     &ElectronRenderFrameObserver::SendDraggableRegions,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void ElectronRenderFrameObserver::SendDraggableRegions() {
+  draggable_regions_update_pending_ = false;
   blink::WebVector<blink::WebDraggableRegion> webregions =
       render_frame_->GetWebFrame()->GetDocument().DraggableRegions();
   std::vector<mojom::DraggableRegionPtr> regions;
@@ -149,11 +167,15 @@ void ElectronRenderFrameObserver::DraggableRegionsChanged() {
     regions.push_back(std::move(region));
   }
 
-  mojo::AssociatedRemote<mojom::ElectronWebContentsUtility>
-      web_contents_utility_remote;
-  render_frame_->GetRemoteAssociatedInterfaces()->GetInterface(
-      &web_contents_utility_remote);
-  web_contents_utility_remote->UpdateDraggableRegions(std::move(regions));
+  // Layout changes elsewhere in the document report the same regions again,
+  // which need no update of the window shape.
+  if (mojo::Equals(regions, draggable_regions_))
+    return;
+  draggable_regions_ = mojo::Clone(regions);
+
+  TRACE_EVENT1("electron", "ElectronRenderFrameObserver::SendDraggableRegions",
+               "regions", regions.size());
+  GetWebContentsUtility()->UpdateDraggableRegions(std::move(regions));
 }
 
 void ElectronRenderFrameObserver::WillReleaseScriptContext(
@@ -169,13 +191,17 @@ void ElectronRenderFrameObserver::OnDestruct() {
 
 void ElectronRenderFrameObserver::DidMeaningfulLayout(
     blink::WebMeaningfulLayout layout_type) {
-  if (layout_type == blink::WebMeaningfulLayout::kVisuallyNonEmpty) {
-    mojo::AssociatedRemote<mojom::ElectronWebContentsUtility>
-        web_contents_utility_remote;
+  if (layout_type == blink::WebMeaningfulLayout::kVisuallyNonEmpty)
+    GetWebContentsUtility()->OnFirstNonEmptyLayout();
+}
+
+mojom::ElectronWebContentsUtility*
+ElectronRenderFrameObserver::GetWebContentsUtility() {
+  if (!web_contents_utility_remote_.is_bound()) {
     render_frame_->GetRemoteAssociatedInterfaces()->GetInterface(
-        &web_contents_utility_remote);
-    web_contents_utility_remote->OnFirstNonEmptyLayout();
+        &web_contents_utility_remote_);
   }
+  return web_contents_utility_remote_.get();
 }
 
 void ElectronRenderFrameObserver::CreateIsolatedWorldContext() {
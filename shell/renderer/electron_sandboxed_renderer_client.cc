@@ -23,6 +23,7 @@
 #include "shell/common/node_includes.h"
 #include "shell/common/node_util.h"
 #include "shell/common/options_switches.h"
+#include "shell/common/startup_marks.h"
 #include "shell/renderer/electron_render_frame_observer.h"
 #include "third_party/blink/public/common/web_preferences/web_preferences.h"
 #include "third_party/blink/public/web/blink.h"
@@ -213,9 +214,13 @@ void ElectronSandboxedRendererClient::DidCreateScriptContext(
 
   std::vector<v8::Local<v8::Value>> sandbox_preload_bundle_args = {binding};
 
-  util::CompileAndCall(
-      isolate->GetCurrentContext(), "electron/js2c/sandbox_bundle",
-      &sandbox_preload_bundle_params, &sandbox_preload_bundle_args, nullptr);
+  {
+    // The bundle runs the preload scripts.
+    ScopedStartupPhase startup_phase("SandboxedRenderer::RunPreloadBundle");
+    util::CompileAndCall(
+        isolate->GetCurrentContext(), "electron/js2c/sandbox_bundle",
+        &sandbox_preload_bundle_params, &sandbox_preload_bundle_args, nullptr);
+  }
 
   v8::HandleScope handle_scope(isolate);
   v8::Context::Scope context_scope(context);
@@ -15,6 +15,7 @@
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/node_bindings.h"
 #include "shell/common/node_includes.h"
+#include "shell/common/startup_marks.h"
 #include "shell/services/node/parent_port.h"
 
 namespace electron {
@@ -41,6 +42,7 @@ void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
   if (NodeBindings::IsInitialized())
     return;
 
+  ScopedStartupPhase startup_phase("NodeService::Initialize");
   ParentPort::GetInstance()->Initialize(std::move(params->port));
 
   js_env_ = std::make_unique<JavascriptEnvironment>(node_bindings_->uv_loop());
@@ -101,4 +103,19 @@ void NodeService::Initialize(node::mojom::NodeServiceParamsPtr params) {
   node_bindings_->StartPolling();
 }
 
+void NodeService::OpenSharedMemoryChannel(
+    node::mojom::SharedMemoryChannelParamsPtr params) {
+  if (!node_env_ || node_env_stopped_)
+    return;
+  ParentPort::GetInstance()->OpenSharedMemoryChannel(std::move(params));
+}
+
+void NodeService::GetStartupMarks(GetStartupMarksCallback callback) {
+  std::vector<electron::mojom::StartupMarkPtr> marks;
+  for (const auto& mark : electron::GetStartupMarks())
+    marks.push_back(electron::mojom::StartupMark::New(mark.name, mark.start,
+                                                      mark.duration));
+  std::move(callback).Run(std::move(marks));
+}
+
 }  // namespace electron
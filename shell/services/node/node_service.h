@@ -29,6 +29,9 @@ class NodeService : public node::mojom::NodeService {
 
   // mojom::NodeService implementation:
   void Initialize(node::mojom::NodeServiceParamsPtr params) override;
+  void OpenSharedMemoryChannel(
+      node::mojom::SharedMemoryChannelParamsPtr params) override;
+  void GetStartupMarks(GetStartupMarksCallback callback) override;
 
  private:
   bool node_env_stopped_ = false;
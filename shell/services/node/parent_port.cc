@@ -10,6 +10,7 @@
 #include "gin/data_object_builder.h"
 #include "gin/handle.h"
 #include "shell/browser/api/message_port.h"
+#include "shell/browser/api/shared_memory_channel.h"
 #include "shell/common/gin_helper/dictionary.h"
 #include "shell/common/gin_helper/event_emitter_caller.h"
 #include "shell/common/node_includes.h"
@@ -40,6 +41,25 @@ void ParentPort::Initialize(blink::MessagePortDescriptor port) {
       base::BindOnce(&ParentPort::Close, base::Unretained(this)));
 }
 
+void ParentPort::OpenSharedMemoryChannel(
+    node::mojom::SharedMemoryChannelParamsPtr params) {
+  v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
+  v8::HandleScope handle_scope(isolate);
+  // Dropping the params disconnects the browser end when the channel can't
+  // be opened.
+  auto channel = SharedMemoryChannel::Open(isolate, std::move(params));
+  if (channel.IsEmpty())
+    return;
+  v8::Local<v8::Object> self;
+  if (!GetWrapper(isolate).ToLocal(&self)) {
+    // Nothing can receive the channel, so close it instead of keeping it
+    // pinned forever while the browser waits on it.
+    channel->Close();
+    return;
+  }
+  gin_helper::EmitEvent(isolate, self, "channel", channel);
+}
+
 void ParentPort::PostMessage(v8::Local<v8::Value> message_value) {
   if (!connector_closed_ && connector_ && connector_->is_valid()) {
     v8::Isolate* isolate = JavascriptEnvironment::GetIsolate();
@@ -11,6 +11,7 @@
 #include "mojo/public/cpp/bindings/connector.h"
 #include "mojo/public/cpp/bindings/message.h"
 #include "shell/browser/event_emitter_mixin.h"
+#include "shell/services/node/public/mojom/node_service.mojom.h"
 
 namespace v8 {
 template <class T>
@@ -42,6 +43,9 @@ class ParentPort : public gin::Wrappable<ParentPort>,
   ParentPort();
   ~ParentPort() override;
   void Initialize(blink::MessagePortDescriptor port);
+  // Emits a 'channel' event with the end of a shared memory channel.
+  void OpenSharedMemoryChannel(
+      node::mojom::SharedMemoryChannelParamsPtr params);
 
   // gin::Wrappable
   static gin::WrapperInfo kWrapperInfo;
@@ -6,10 +6,10 @@ import * as net from 'net';
 import * as fs from 'fs-extra';
 import * as path from 'path';
 import { promisify } from 'util';
-import { app, BrowserWindow, Menu, session, net as electronNet } from 'electron/main';
+import { app, BrowserWindow, Menu, session, net as electronNet, utilityProcess } from 'electron/main';
 import { emittedOnce } from './events-helpers';
 import { closeWindow, closeAllWindows } from './window-helpers';
-import { ifdescribe, ifit, waitUntil } from './spec-helpers';
+import { delay, ifdescribe, ifit, waitUntil } from './spec-helpers';
 import split = require('split')
 
 const fixturesPath = path.resolve(__dirname, 'fixtures');
@@ -1368,7 +1368,11 @@ describe('app module', () => {
   });
 
   describe('getAppMetrics() API', () => {
-    it('returns memory and cpu stats of all running electron processes', () => {
+    it('returns memory and cpu stats of all running electron processes', async () => {
+      if (process.platform === 'linux') {
+        // The memory is read in the background after the first call.
+        await waitUntil(() => app.getAppMetrics().every(entry => entry.memory != null));
+      }
       const appMetrics = app.getAppMetrics();
       expect(appMetrics).to.be.an('array').and.have.lengthOf.at.least(1, 'App memory info object is not > 0');
 
@@ -1397,6 +1401,16 @@ describe('app module', () => {
           expect(entry.memory).to.have.property('privateBytes').that.is.greaterThan(0);
         }
 
+        if (process.platform === 'linux') {
+          expect(entry.memory).to.have.property('swap').that.is.a('number');
+          if (entry.type === 'Browser') {
+            expect(entry.memory).to.have.property('proportionalSetSize').that.is.greaterThan(0);
+            expect(entry.memory).to.have.property('uniqueSetSize').that.is.greaterThan(0);
+            expect(entry.memory).to.have.property('privateDirty').that.is.greaterThan(0);
+            expect(entry.memory).to.have.property('sharedDirty').that.is.a('number');
+          }
+        }
+
         if (process.platform !== 'linux') {
           expect(entry.sandboxed).to.be.a('boolean');
         }
@@ -1414,6 +1428,160 @@ describe('app module', () => {
     });
   });
 
+  describe('startAppMetricsSampling() API', () => {
+    afterEach(() => {
+      app.stopAppMetricsSampling();
+    });
+
+    it('emits app-metrics with the metrics of all processes', async () => {
+      app.startAppMetricsSampling(10);
+      const [, metrics] = await emittedOnce(app, 'app-metrics');
+      expect(metrics).to.be.an('array').and.have.lengthOf.at.least(1);
+      const browser = metrics.find((entry: Electron.ProcessMetric) => entry.type === 'Browser');
+      expect(browser).to.have.property('pid', process.pid);
+      expect(browser.cpu).to.have.ownProperty('percentCPUUsage').that.is.a('number');
+      expect(browser.memory).to.have.property('workingSetSize').that.is.greaterThan(0);
+    });
+
+    it('stops emitting once stopped', async () => {
+      app.startAppMetricsSampling(10);
+      await emittedOnce(app, 'app-metrics');
+      app.stopAppMetricsSampling();
+      let emitted = false;
+      const listener = () => { emitted = true; };
+      app.on('app-metrics', listener);
+      await delay(100);
+      app.off('app-metrics', listener);
+      expect(emitted).to.be.false();
+    });
+
+    it('throws for an invalid interval', () => {
+      expect(() => app.startAppMetricsSampling(0)).to.throw(/interval must be a positive number/);
+    });
+  });
+
+  describe('startResourceSampling() API', () => {
+    afterEach(() => {
+      app.stopResourceSampling();
+    });
+
+    it('keeps the last samples of each process', async () => {
+      app.startResourceSampling({ interval: 10, capacity: 3 });
+      for (let i = 0; i < 5; i++) {
+        await emittedOnce(app, 'resource-usage');
+      }
+      const samples = app.getResourceSamples(process.pid)!;
+      expect(samples).to.have.property('type', 'Browser');
+      expect(samples.fields).to.include.members(['timestamp', 'percentCPUUsage', 'workingSetSize']);
+      expect(samples.samples).to.be.an.instanceOf(Float64Array);
+      expect(samples.samples.length).to.equal(3 * samples.fields.length);
+      const timestamps = [0, 1, 2].map(i => samples.samples[i * samples.fields.length]);
+      expect(timestamps[0]).to.be.below(timestamps[1]);
+      expect(timestamps[1]).to.be.below(timestamps[2]);
+      const workingSetSize = samples.samples[samples.fields.indexOf('workingSetSize')];
+      expect(workingSetSize).to.be.greaterThan(0);
+    });
+
+    it('emits the total usage of all processes', async () => {
+      app.startResourceSampling({ interval: 10 });
+      const [, usage] = await emittedOnce(app, 'resource-usage');
+      expect(usage.processCount).to.be.at.least(1);
+      expect(usage.percentCPUUsage).to.be.a('number');
+      expect(usage.workingSetSize).to.be.greaterThan(0);
+    });
+
+    it('returns null for processes that are not sampled', () => {
+      expect(app.getResourceSamples(process.pid)).to.be.null();
+      app.startResourceSampling();
+      expect(app.getResourceSamples(-1)).to.be.null();
+    });
+
+    it('throws for an invalid capacity', () => {
+      expect(() => app.startResourceSampling({ capacity: 0 })).to.throw(/must be positive numbers/);
+      expect(() => app.startResourceSampling({ capacity: -1 })).to.throw(/must be positive numbers/);
+      expect(() => app.startResourceSampling({ capacity: 3601 })).to.throw(/must not be greater than 3600/);
+    });
+  });
+
+  describe('startMainThreadWatchdog() API', () => {
+    afterEach(() => {
+      app.stopMainThreadWatchdog();
+    });
+
+    const blockMainThread = (duration: number) => {
+      setTimeout(function blockingTimer () {
+        const end = Date.now() + duration;
+        while (Date.now() < end) { /* block */ }
+      });
+    };
+
+    it('emits main-thread-blocked for long tasks', async () => {
+      app.startMainThreadWatchdog({ threshold: 50 });
+      const blocked = emittedOnce(app, 'main-thread-blocked');
+      blockMainThread(300);
+      const [, details] = await blocked;
+      expect(details.duration).to.be.at.least(50);
+      expect(details.startTime).to.be.a('number').that.is.greaterThan(0);
+      expect(details.location).to.be.a('string');
+      expect(details.jsStack).to.include('blockingTimer');
+      expect(details.nativeStack).to.be.a('string');
+    });
+
+    it('does not sample stacks when sampleStacks is false', async () => {
+      app.startMainThreadWatchdog({ threshold: 50, sampleStacks: false });
+      const blocked = emittedOnce(app, 'main-thread-blocked');
+      blockMainThread(300);
+      const [, details] = await blocked;
+      expect(details).to.not.have.property('jsStack');
+      expect(details).to.not.have.property('nativeStack');
+    });
+
+    it('does not report tasks once stopped', async () => {
+      app.startMainThreadWatchdog({ threshold: 50 });
+      app.stopMainThreadWatchdog();
+      let emitted = false;
+      const listener = () => { emitted = true; };
+      app.on('main-thread-blocked', listener);
+      blockMainThread(100);
+      await delay(100);
+      app.off('main-thread-blocked', listener);
+      expect(emitted).to.be.false();
+    });
+  });
+
+  describe('getStartupTimeline() API', () => {
+    afterEach(closeAllWindows);
+
+    it('reports the startup phases of the browser process first', async () => {
+      const timeline = await app.getStartupTimeline();
+      expect(timeline[0]).to.have.property('type', 'browser');
+      expect(timeline[0]).to.have.property('pid', process.pid);
+      const names = timeline[0].marks.map(mark => mark.name);
+      expect(names).to.include('ElectronBrowserMainParts::PreMainMessageLoopRun');
+      expect(names).to.include('NodeBindings::LoadEnvironment');
+      const startTimes = timeline[0].marks.map(mark => mark.startTime);
+      expect(startTimes).to.deep.equal([...startTimes].sort((a, b) => a - b));
+      expect(startTimes[0]).to.equal(0);
+    });
+
+    it('reports the startup phases of renderer and utility processes', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const child = utilityProcess.fork(path.join(fixturesPath, 'api', 'utility-process', 'endless.js'));
+      await emittedOnce(child, 'spawn');
+      try {
+        const timeline = await app.getStartupTimeline();
+        const renderer = timeline.find(p => p.pid === w.webContents.getOSProcessId());
+        expect(renderer).to.have.property('type', 'renderer');
+        const utility = timeline.find(p => p.pid === child.pid);
+        expect(utility).to.have.property('type', 'utility');
+        expect(utility!.marks.map(mark => mark.name)).to.include('NodeService::Initialize');
+      } finally {
+        child.kill();
+      }
+    });
+  });
+
   describe('getGPUFeatureStatus() API', () => {
     it('returns the graphic features statuses', () => {
       const features = app.getGPUFeatureStatus();
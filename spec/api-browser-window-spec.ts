@@ -5,10 +5,10 @@ import * as fs from 'fs';
 import * as qs from 'querystring';
 import * as http from 'http';
 import { AddressInfo } from 'net';
-import { app, BrowserWindow, BrowserView, dialog, ipcMain, OnBeforeSendHeadersListenerDetails, protocol, screen, webContents, session, WebContents } from 'electron/main';
+import { app, BrowserWindow, BrowserView, dialog, ipcMain, nativeImage, OnBeforeSendHeadersListenerDetails, protocol, screen, webContents, session, WebContents } from 'electron/main';
 
 import { emittedOnce, emittedUntil, emittedNTimes } from './events-helpers';
-import { ifit, ifdescribe, defer, delay } from './spec-helpers';
+import { ifit, ifdescribe, defer, delay, waitUntil } from './spec-helpers';
 import { closeWindow, closeAllWindows } from './window-helpers';
 import { areColorsSimilar, captureScreen, CHROMA_COLOR_HEX, getPixelColor } from './screen-helpers';
 
@@ -1787,6 +1787,64 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('BrowserWindow.webContents.captureScreenshot(options)', () => {
+    afterEach(closeAllWindows);
+
+    it('rejects invalid options', async () => {
+      const w = new BrowserWindow({ show: false });
+      await expect(w.webContents.captureScreenshot({ format: 'gif' })).to.eventually.be.rejectedWith('Invalid format gif');
+      await expect(w.webContents.captureScreenshot({ quality: 101 })).to.eventually.be.rejectedWith(/quality must be a Number/);
+      await expect(w.webContents.captureScreenshot({ fullPage: true, rect: { x: 0, y: 0, width: 10, height: 10 } })).to.eventually.be.rejectedWith(/rect can not be used/);
+    });
+
+    it('resolves with an encoded image of the visible page', async () => {
+      const w = new BrowserWindow({ show: false, width: 200, height: 200 });
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'));
+      await emittedOnce(w, 'ready-to-show');
+      w.show();
+
+      const data = await w.webContents.captureScreenshot({ format: 'jpeg', quality: 50 }) as Buffer;
+      const image = nativeImage.createFromBuffer(data);
+      expect(image.isEmpty()).to.be.false();
+      expect(image.getSize().width).to.be.at.least(w.getContentSize()[0]);
+    });
+
+    it('captures the whole page', async () => {
+      const w = new BrowserWindow({ show: false, width: 200, height: 200 });
+      await w.loadURL('data:text/html,<body style="margin:0"><div style="height:1000px;background:red"></div></body>');
+      w.show();
+
+      const data = await w.webContents.captureScreenshot({ fullPage: true }) as Buffer;
+      const image = nativeImage.createFromBuffer(data);
+      const scaleFactor = screen.getPrimaryDisplay().scaleFactor;
+      expect(image.getSize().height).to.be.at.least(1000 * scaleFactor);
+      expect(await w.webContents.executeJavaScript('window.scrollY')).to.equal(0);
+    });
+
+    it('rejects capturing the whole page of an empty viewport', async () => {
+      const w = new BrowserWindow({ show: false, width: 200, height: 200 });
+      const bv = new BrowserView();
+      defer(() => (bv.webContents as any).destroy());
+      w.setBrowserView(bv);
+      bv.setBounds({ x: 0, y: 0, width: 0, height: 0 });
+      await bv.webContents.loadURL('data:text/html,<div style="height:1000px"></div>');
+      await expect(bv.webContents.captureScreenshot({ fullPage: true })).to.eventually.be.rejectedWith(/empty viewport/);
+    });
+
+    it('writes the image to a file', async () => {
+      const w = new BrowserWindow({ show: false, width: 200, height: 200 });
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'));
+      await emittedOnce(w, 'ready-to-show');
+      w.show();
+
+      const filePath = path.join(app.getPath('temp'), `capture-${Date.now()}.png`);
+      defer(() => fs.rmSync(filePath, { force: true }));
+      const result = await w.webContents.captureScreenshot({ path: filePath });
+      expect(result).to.equal(filePath);
+      expect(nativeImage.createFromPath(filePath).isEmpty()).to.be.false();
+    });
+  });
+
   describe('BrowserWindow.setProgressBar(progress)', () => {
     let w = null as unknown as BrowserWindow;
     before(() => {
@@ -2152,6 +2210,48 @@ describe('BrowserWindow module', () => {
     });
   });
 
+  describe('BrowserWindow.createTemplate(options)', () => {
+    let template: Electron.BrowserWindowTemplate | null = null;
+    afterEach(async () => {
+      if (template) template.destroy();
+      template = null;
+      await closeAllWindows();
+    });
+
+    it('claims a window that already loaded the page', async () => {
+      const file = path.join(fixtures, 'pages', 'blank.html');
+      template = BrowserWindow.createTemplate({ show: false, file, poolSize: 2 });
+      await waitUntil(() => template!.warmCount === 2);
+      const w = template.claim();
+      expect(w.isVisible()).to.be.false();
+      expect(w.webContents.isLoading()).to.be.false();
+      expect(w.webContents.getURL()).to.match(/blank\.html$/);
+      expect(template.warmCount).to.equal(1);
+      await waitUntil(() => template!.warmCount === 2);
+    });
+
+    it('creates a window when none is warm', () => {
+      template = BrowserWindow.createTemplate({ show: false, poolSize: 0 });
+      const w = template.claim();
+      expect(w).to.be.an.instanceOf(BrowserWindow);
+      expect(template.warmCount).to.equal(0);
+    });
+
+    it('destroys the warm windows', async () => {
+      template = BrowserWindow.createTemplate({ show: false });
+      await waitUntil(() => template!.warmCount === 1);
+      template.destroy();
+      expect(template.warmCount).to.equal(0);
+      await waitUntil(() => BrowserWindow.getAllWindows().length === 0);
+      expect(() => template!.claim()).to.throw(/destroyed/);
+    });
+
+    it('validates its options', () => {
+      expect(() => BrowserWindow.createTemplate({ poolSize: -1 })).to.throw(/poolSize/);
+      expect(() => BrowserWindow.createTemplate({ url: 'about:blank', file: 'index.html' })).to.throw(/Only one of url and file/);
+    });
+  });
+
   describe('Opening a BrowserWindow from a link', () => {
     let appProcess: childProcess.ChildProcessWithoutNullStreams | undefined;
 
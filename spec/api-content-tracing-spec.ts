@@ -1,8 +1,10 @@
 import { expect } from 'chai';
-import { app, contentTracing, TraceConfig, TraceCategoriesAndOptions } from 'electron/main';
+import { app, BrowserWindow, contentTracing, TraceConfig, TraceCategoriesAndOptions } from 'electron/main';
 import * as fs from 'fs';
 import * as path from 'path';
+import * as zlib from 'zlib';
 import { ifdescribe, delay } from './spec-helpers';
+import { closeAllWindows } from './window-helpers';
 
 // FIXME: The tests are skipped on arm/arm64 and ia32.
 ifdescribe(!(['arm', 'arm64', 'ia32'].includes(process.arch)))('contentTracing', () => {
@@ -117,7 +119,57 @@ ifdescribe(!(['arm', 'arm64', 'ia32'].includes(process.arch)))('contentTracing',
     });
   });
 
+  describe('flight recorder', function () {
+    this.timeout(5e3);
+
+    afterEach(async () => {
+      if (contentTracing.isFlightRecorderRunning()) {
+        await contentTracing.stopFlightRecorder();
+      }
+    });
+
+    it('keeps recording after a snapshot', async () => {
+      await app.whenReady();
+      await contentTracing.startFlightRecorder({ trace_buffer_size_in_kb: 1024 });
+      await delay(10);
+      const resultFilePath = await contentTracing.snapshot(outputFilePath);
+      expect(resultFilePath).to.equal(outputFilePath);
+      expect(JSON.parse(fs.readFileSync(outputFilePath, 'utf8'))).to.have.property('traceEvents');
+      expect(contentTracing.isFlightRecorderRunning()).to.be.true('flight recorder running');
+      await delay(10);
+      await expect(contentTracing.snapshot()).to.eventually.be.a('string');
+    });
+
+    it('streams a gzip-compressed snapshot', async () => {
+      await app.whenReady();
+      await contentTracing.startFlightRecorder({ trace_buffer_size_in_kb: 1024 });
+      await delay(10);
+      const chunks: Buffer[] = [];
+      for await (const chunk of contentTracing.createSnapshotStream()) {
+        chunks.push(chunk);
+      }
+      const data = zlib.gunzipSync(Buffer.concat(chunks)).toString('utf8');
+      expect(JSON.parse(data)).to.have.property('traceEvents');
+    });
+
+    it('rejects a snapshot when it is not running', async () => {
+      await expect(contentTracing.snapshot()).to.be.rejected();
+    });
+
+    it('rejects starting while a trace is in progress', async () => {
+      await app.whenReady();
+      await contentTracing.startRecording({});
+      try {
+        await expect(contentTracing.startFlightRecorder({})).to.be.rejected();
+      } finally {
+        await contentTracing.stopRecording();
+      }
+    });
+  });
+
   describe('captured events', () => {
+    afterEach(closeAllWindows);
+
     it('include V8 samples from the main process', async function () {
       // This test is flaky on macOS CI.
       this.retries(3);
@@ -141,5 +193,21 @@ ifdescribe(!(['arm', 'arm64', 'ia32'].includes(process.arch)))('contentTracing',
       const parsed = JSON.parse(data);
       expect(parsed.traceEvents.some((x: any) => x.cat === 'disabled-by-default-v8.cpu_profiler' && x.name === 'ProfileChunk')).to.be.true();
     });
+
+    it('include the creation of Node.js environments in renderers', async () => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: { nodeIntegration: true, nodeIntegrationInSubFrames: true, contextIsolation: false }
+      });
+      await contentTracing.startRecording({
+        categoryFilter: 'electron',
+        traceOptions: 'record-until-full'
+      });
+      await w.loadURL('data:text/html,<iframe srcdoc="a"></iframe><iframe srcdoc="b"></iframe>');
+      const path = await contentTracing.stopRecording();
+      const parsed = JSON.parse(fs.readFileSync(path, 'utf8'));
+      const creations = parsed.traceEvents.filter((x: any) => x.name === 'NodeBindings::CreateEnvironment' && x.args.process_type === 'renderer');
+      expect(creations).to.have.lengthOf.at.least(3);
+    });
   });
 });
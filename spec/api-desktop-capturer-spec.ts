@@ -249,4 +249,36 @@ ifdescribe(!process.arch.includes('arm') && process.platform !== 'win32')('deskt
       destroyWindows();
     }
   });
+
+  describe('watchSources()', () => {
+    it('throws an error for invalid options', () => {
+      expect(() => desktopCapturer.watchSources(['screen'] as any)).to.throw('Invalid options');
+      expect(() => desktopCapturer.watchSources({ types: ['screen'], updateInterval: 0 })).to.throw('updateInterval must be a positive number');
+    });
+
+    it('reports the existing sources as added', async () => {
+      const watcher = desktopCapturer.watchSources({ types: ['screen'], updateInterval: 100 });
+      try {
+        const [, source] = await emittedOnce(watcher, 'source-added');
+        expect(source.id).to.be.a('string').that.matches(/^screen:/);
+        expect(source.thumbnail.isEmpty()).to.be.true();
+        expect(watcher.getSources().map(s => s.id)).to.include(source.id);
+      } finally {
+        watcher.stop();
+      }
+    });
+
+    it('emits thumbnails for visible sources', async () => {
+      const watcher = desktopCapturer.watchSources({ types: ['screen'], updateInterval: 100 });
+      try {
+        const [, source] = await emittedOnce(watcher, 'source-added');
+        watcher.setVisibleSources([source.id]);
+        const [, id, thumbnail] = await emittedOnce(watcher, 'thumbnail-changed');
+        expect(id).to.equal(source.id);
+        expect(thumbnail.isEmpty()).to.be.false();
+      } finally {
+        watcher.stop();
+      }
+    });
+  });
 });
@@ -126,6 +126,40 @@ describe('ipc module', () => {
     });
   });
 
+  describe('ipcMain.getChannelStats', () => {
+    let w = (null as unknown as BrowserWindow);
+
+    before(async () => {
+      w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+    });
+    after(async () => {
+      w.destroy();
+    });
+
+    it('records incoming invoke messages per channel', async () => {
+      ipcMain.resetChannelStats();
+      ipcMain.handle('stats-test', () => 'ok');
+      defer(() => ipcMain.removeHandler('stats-test'));
+      await w.webContents.executeJavaScript(`(async () => {
+        const { ipcRenderer } = require('electron');
+        await ipcRenderer.invoke('stats-test', 'hello');
+        await ipcRenderer.invoke('stats-test', 'world');
+      })()`);
+      const stats = ipcMain.getChannelStats().find(s => s.channel === 'stats-test' && s.direction === 'incoming');
+      expect(stats).to.not.be.undefined();
+      expect(stats!.count).to.equal(2);
+      expect(stats!.bytes).to.be.greaterThan(0);
+      expect(stats!.handlerTimeHistogram).to.have.lengthOf(6);
+      expect(stats!.handlerTimeHistogram!.reduce((a, b) => a + b, 0)).to.equal(2);
+    });
+
+    it('can be reset', () => {
+      ipcMain.resetChannelStats();
+      expect(ipcMain.getChannelStats().find(s => s.channel === 'stats-test')).to.be.undefined();
+    });
+  });
+
   describe('ordering', () => {
     let w = (null as unknown as BrowserWindow);
 
@@ -664,6 +698,32 @@ describe('ipc module', () => {
       expect(result).to.equal(42 * 2);
     });
 
+    it('falls back to ipcMain handlers after the handler is removed', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      w.loadURL('about:blank');
+      w.webContents.ipc.handle('test', () => { throw new Error('should not be called'); });
+      w.webContents.ipc.removeHandler('test');
+      ipcMain.handle('test', (_event, arg) => { return arg * 2; });
+      defer(() => ipcMain.removeHandler('test'));
+      const result = await w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.invoke(\'test\', 42)');
+      expect(result).to.equal(42 * 2);
+    });
+
+    it('provides the sender and frame to ipcMain handlers', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { nodeIntegration: true, contextIsolation: false } });
+      await w.loadURL('about:blank');
+      ipcMain.handle('test', (event) => {
+        expect(event.sender).to.equal(w.webContents);
+        expect(event.senderFrame).to.equal(w.webContents.mainFrame);
+        expect(event.processId).to.equal(w.webContents.mainFrame.processId);
+        expect(event.frameId).to.equal(w.webContents.mainFrame.routingId);
+        return 'ok';
+      });
+      defer(() => ipcMain.removeHandler('test'));
+      const result = await w.webContents.executeJavaScript('require(\'electron\').ipcRenderer.invoke(\'test\')');
+      expect(result).to.equal('ok');
+    });
+
     it('receives ipcs from child frames', async () => {
       const server = http.createServer((req, res) => {
         res.setHeader('content-type', 'text/html');
@@ -936,4 +936,67 @@ describe('Menu module', function () {
       expect(output).to.include('Window has no menu');
     });
   });
+
+  describe('native item state', () => {
+    const queryMethods = [
+      '_isCommandIdChecked',
+      '_isCommandIdEnabled',
+      '_isCommandIdVisible',
+      '_shouldCommandIdWorkWhenHidden',
+      '_getAcceleratorForCommandId',
+      '_shouldRegisterAcceleratorForCommandId'
+    ];
+
+    const countQueries = (menu: any) => {
+      const counter = { calls: 0 };
+      for (const method of queryMethods) {
+        const original = menu[method];
+        menu[method] = function (...args: any[]) {
+          counter.calls++;
+          return original.apply(this, args);
+        };
+      }
+      return counter;
+    };
+
+    it('answers queries of a large menu without calling into JavaScript', () => {
+      const template = [];
+      for (let i = 0; i < 1500; i++) {
+        template.push({ label: `${i}`, accelerator: `CmdOrCtrl+Shift+F${(i % 12) + 1}`, enabled: i % 2 === 0 });
+      }
+      const menu = Menu.buildFromTemplate(template) as any;
+      const counter = countQueries(menu);
+      for (let i = 0; i < 1500; i++) {
+        expect(menu.isEnabledAt(i)).to.equal(i % 2 === 0);
+        expect(menu.isVisibleAt(i)).to.be.true();
+        expect(menu._getAcceleratorTextAt(i)).to.not.be.empty();
+      }
+      expect(counter.calls).to.equal(0);
+    });
+
+    it('reflects changes to the items', () => {
+      const menu = Menu.buildFromTemplate([
+        { label: 'a', type: 'checkbox' },
+        { label: 'b', type: 'radio' },
+        { label: 'c', type: 'radio', checked: true }
+      ]) as any;
+      const counter = countQueries(menu);
+      menu.items[0].checked = true;
+      menu.items[0].visible = false;
+      menu.items[1].checked = true;
+      expect(menu.isItemCheckedAt(0)).to.be.true();
+      expect(menu.isVisibleAt(0)).to.be.false();
+      expect(menu.isItemCheckedAt(1)).to.be.true();
+      expect(menu.isItemCheckedAt(2)).to.be.false();
+      expect(counter.calls).to.equal(0);
+    });
+
+    it('reflects items inserted after the menu was built', () => {
+      const menu = Menu.buildFromTemplate([{ label: 'a' }]) as any;
+      menu.append(new MenuItem({ label: 'b', enabled: false }));
+      expect(menu.isEnabledAt(1)).to.be.false();
+      menu.items[1].enabled = true;
+      expect(menu.isEnabledAt(1)).to.be.true();
+    });
+  });
 });
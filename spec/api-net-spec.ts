@@ -1,6 +1,9 @@
 import { expect } from 'chai';
 import { net, session, ClientRequest, BrowserWindow, ClientRequestConstructorOptions } from 'electron/main';
+import * as fs from 'fs';
 import * as http from 'http';
+import * as os from 'os';
+import * as path from 'path';
 import * as url from 'url';
 import { AddressInfo, Socket } from 'net';
 import { emittedOnce } from './events-helpers';
@@ -160,6 +163,32 @@ describe('net module', () => {
       expect(body).to.equal(expectedBodyData);
     });
 
+    it('should pipe the response body to a file', async () => {
+      const bodyData = randomBuffer(kOneMegaByte);
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end(bodyData);
+      });
+      const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-net-spec-'));
+      defer(() => fs.rmSync(dir, { recursive: true, force: true }));
+      const filePath = path.join(dir, 'body.bin');
+      const urlRequest = net.request(serverUrl);
+      const response = await getResponse(urlRequest);
+      response.pipeToFile(filePath);
+      await emittedOnce(response, 'end');
+      expect(fs.readFileSync(filePath).equals(bodyData)).to.equal(true);
+    });
+
+    it('should not allow piping to a file after the body has been read', async () => {
+      const serverUrl = await respondOnce.toSingleURL((request, response) => {
+        response.end('Hello World!');
+      });
+      const urlRequest = net.request(serverUrl);
+      const response = await getResponse(urlRequest);
+      const body = collectStreamBody(response);
+      expect(() => response.pipeToFile(path.join(os.tmpdir(), 'unused'))).to.throw(/must be called before the response body is read/);
+      await body;
+    });
+
     it('should post the correct data in a POST request', async () => {
       const bodyData = 'Hello World!';
       const serverUrl = await respondOnce.toSingleURL(async (request, response) => {
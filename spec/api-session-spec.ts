@@ -165,6 +165,67 @@ describe('session module', () => {
       expect(list.some(cookie => cookie.name === name && cookie.value === value)).to.equal(false);
     });
 
+    it('sets many cookies at once', async () => {
+      const { cookies } = session.defaultSession;
+      const expirationDate = (+new Date()) / 1000 + 120;
+
+      await cookies.setMany([
+        { url, name: 'many1', value: '1', expirationDate },
+        { url, name: 'many2', value: '2', expirationDate }
+      ]);
+      const list = await cookies.get({ url });
+
+      expect(list.find(c => c.name === 'many1')).to.have.property('value', '1');
+      expect(list.find(c => c.name === 'many2')).to.have.property('value', '2');
+    });
+
+    it('does not set any cookie when one of many is invalid', async () => {
+      const { cookies } = session.defaultSession;
+
+      await expect(cookies.setMany([
+        { url, name: 'valid', value: '1' },
+        { url: 'asdf', name: 'invalid', value: '1' }
+      ])).to.eventually.be.rejectedWith('Failed to set cookie with an invalid domain attribute');
+      const list = await cookies.get({ url });
+
+      expect(list.some(c => c.name === 'valid')).to.equal(false);
+    });
+
+    it('removes many cookies at once', async () => {
+      const { cookies } = session.defaultSession;
+      const expirationDate = (+new Date()) / 1000 + 120;
+
+      await cookies.setMany([
+        { url, name: 'many1', value: '1', expirationDate },
+        { url, name: 'many2', value: '2', expirationDate },
+        { url, name: 'many3', value: '3', expirationDate }
+      ]);
+      const removed = await cookies.removeMany([
+        { url, name: 'many1' },
+        { url, name: 'many2' }
+      ]);
+      const list = await cookies.get({ url });
+
+      expect(removed).to.equal(2);
+      expect(list.map(c => c.name)).to.deep.equal(['many3']);
+    });
+
+    it('filters cookies by subdomain without url', async () => {
+      const { cookies } = session.fromPartition('cookies-domain-filter');
+      const expirationDate = (+new Date()) / 1000 + 120;
+
+      await cookies.setMany([
+        { url: 'http://example.com', name: 'a', value: '1', domain: 'example.com', expirationDate },
+        { url: 'http://sub.example.com', name: 'b', value: '1', expirationDate },
+        { url: 'http://notexample.com', name: 'c', value: '1', expirationDate }
+      ]);
+
+      const all = await cookies.get({ domain: 'example.com' });
+      expect(all.map(c => c.name).sort()).to.deep.equal(['a', 'b']);
+      const sub = await cookies.get({ domain: 'sub.example.com' });
+      expect(sub.map(c => c.name)).to.deep.equal(['b']);
+    });
+
     it.skip('should set cookie for standard scheme', async () => {
       const { cookies } = session.defaultSession;
       const domain = 'fake-host';
@@ -260,6 +321,53 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.clearStorageDataInBatches(options)', () => {
+    let server: http.Server;
+    let serverUrl: string;
+    before(async () => {
+      server = http.createServer((req, res) => {
+        res.end('<html></html>');
+      });
+      await new Promise<void>(resolve => server.listen(0, '127.0.0.1', resolve));
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    });
+    after(() => server.close());
+    afterEach(closeAllWindows);
+
+    it('clears the localstorage data of the given origins', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL(serverUrl);
+      await w.webContents.executeJavaScript('localStorage.setItem("foo", "bar")');
+      const progress: { completed: number, total: number }[] = [];
+      const result = await w.webContents.session.clearStorageDataInBatches({
+        origins: [serverUrl, 'https://example.com'],
+        storages: ['localstorage'],
+        onProgress: (details) => { progress.push(details); }
+      });
+      expect(result.bytesFreed).to.be.a('number');
+      expect(progress[progress.length - 1]).to.deep.equal({ completed: 2, total: 2 });
+      while (await w.webContents.executeJavaScript('localStorage.length') !== 0) {
+        // The storage clear isn't instantly visible to the renderer, so keep
+        // trying until it is.
+      }
+    });
+
+    it('reports the progress when there is nothing to clear', async () => {
+      const progress: { completed: number, total: number }[] = [];
+      await session.defaultSession.clearStorageDataInBatches({
+        storages: [],
+        onProgress: (details) => { progress.push(details); }
+      });
+      expect(progress).to.deep.equal([{ completed: 0, total: 0 }]);
+    });
+
+    it('rejects opaque origins', async () => {
+      await expect(session.defaultSession.clearStorageDataInBatches({
+        origins: ['not a url']
+      })).to.eventually.be.rejectedWith(/Invalid origin/);
+    });
+  });
+
   describe('will-download event', () => {
     afterEach(closeAllWindows);
     it('can cancel default download behavior', async () => {
@@ -798,6 +906,33 @@ describe('session module', () => {
       session.defaultSession.downloadURL(`${url}:${port}`);
     });
 
+    it('coalesces the updated events as configured on the session', (done) => {
+      const port = address.port;
+      let updates = 0;
+      session.defaultSession.setDownloadProgressOptions({ minBytes: mockPDF.length * 2 });
+      session.defaultSession.once('will-download', function (e, item) {
+        item.savePath = downloadFilePath;
+        item.on('updated', () => { updates++; });
+        item.on('done', function (e, state) {
+          session.defaultSession.setDownloadProgressOptions({});
+          try {
+            assertDownload(state, item);
+            expect(updates).to.be.at.most(1);
+            done();
+          } catch (e) {
+            done(e);
+          }
+        });
+      });
+      session.defaultSession.downloadURL(`${url}:${port}`);
+    });
+
+    it('rejects negative download progress options', () => {
+      expect(() => {
+        session.defaultSession.setDownloadProgressOptions({ minInterval: -1 });
+      }).to.throw(/must not be negative/);
+    });
+
     it('can download using WebContents.downloadURL', (done) => {
       const port = address.port;
       const w = new BrowserWindow({ show: false });
@@ -1248,6 +1383,47 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.setSpareRendererEnabled()', () => {
+    afterEach(closeAllWindows);
+
+    const waitForSpare = async (ses: Session) => {
+      while (ses.getSpareRendererStats().launched === 0) {
+        await delay(10);
+      }
+    };
+
+    it('gives a new window the spare renderer launched for the previous one', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setSpareRendererEnabled(true);
+      const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w1.loadURL('about:blank');
+      await waitForSpare(ses);
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w2.loadURL('about:blank');
+      const stats = ses.getSpareRendererStats();
+      expect(stats.hits).to.equal(1);
+      expect(stats.misses).to.equal(1);
+      expect(w2.webContents.getOSProcessId()).to.not.equal(w1.webContents.getOSProcessId());
+    });
+
+    it('does not use the spare renderer for different webPreferences', async () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      ses.setSpareRendererEnabled(true);
+      const w1 = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: true } });
+      await w1.loadURL('about:blank');
+      await waitForSpare(ses);
+      const w2 = new BrowserWindow({ show: false, webPreferences: { session: ses, sandbox: false, nodeIntegration: true, contextIsolation: false } });
+      await w2.loadURL('about:blank');
+      expect(ses.getSpareRendererStats().hits).to.equal(0);
+      expect(await w2.webContents.executeJavaScript('typeof require')).to.equal('function');
+    });
+
+    it('reports no activity when it is not enabled', () => {
+      const ses = session.fromPartition(`${Math.random()}`);
+      expect(ses.getSpareRendererStats()).to.deep.equal({ hits: 0, misses: 0, launched: 0 });
+    });
+  });
+
   describe('ses.setUserAgent()', () => {
     afterEach(closeAllWindows);
 
@@ -1317,6 +1493,36 @@ describe('session module', () => {
     });
   });
 
+  describe('ses.getCacheStats()', () => {
+    let server: http.Server;
+    let serverUrl: string;
+    before(async () => {
+      server = http.createServer((req, res) => {
+        res.setHeader('Cache-Control', 'max-age=3600');
+        res.end('<html></html>');
+      });
+      await new Promise<void>(resolve => server.listen(0, '127.0.0.1', resolve));
+      serverUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    });
+    after(() => server.close());
+    afterEach(closeAllWindows);
+
+    it('reports the loads of the session', async () => {
+      const ses = session.fromPartition(`persist:cache-stats-${Math.random()}`, {
+        cacheInMemory: true,
+        cacheSize: 1024 * 1024,
+        codeCacheInMemory: true
+      });
+      const w = new BrowserWindow({ show: false, webPreferences: { session: ses } });
+      await w.loadURL(serverUrl);
+      const stats = await ses.getCacheStats();
+      expect(stats.httpCache.size).to.be.a('number');
+      expect(stats.httpCache.hits + stats.httpCache.misses).to.be.greaterThan(0);
+      expect(stats.httpCache.hitRate).to.be.within(0, 1);
+      expect(stats.codeCache.size).to.equal(0);
+    });
+  });
+
   describe('ses.setSSLConfig()', () => {
     it('can disable cipher suites', async () => {
       const ses = session.fromPartition('' + Math.random());
@@ -1,9 +1,11 @@
 import { expect } from 'chai';
 import * as childProcess from 'child_process';
+import * as fs from 'fs';
+import * as os from 'os';
 import * as path from 'path';
 import { BrowserWindow, MessageChannelMain, utilityProcess } from 'electron/main';
 import { emittedOnce } from './events-helpers';
-import { ifit } from './spec-helpers';
+import { delay, ifit, waitUntil } from './spec-helpers';
 import { closeWindow } from './window-helpers';
 
 const fixturesPath = path.resolve(__dirname, 'fixtures', 'api', 'utility-process');
@@ -185,6 +187,78 @@ describe('utilityProcess module', () => {
     });
   });
 
+  describe('output option', () => {
+    const fixture = path.join(fixturesPath, 'chatty-output.js');
+    const lines = Array.from({ length: 1000 }, (_, i) => `line ${i}`);
+
+    type OutputDetails = { stream: string, records: (string | Buffer)[], droppedBytes: number };
+    const collectOutput = (child: Electron.UtilityProcess) => {
+      const events: OutputDetails[] = [];
+      child.on('output', (details: OutputDetails) => events.push(details));
+      return events;
+    };
+    const recordsOf = (events: OutputDetails[], stream: string) =>
+      events.filter(event => event.stream === stream).flatMap(event => event.records);
+
+    it('throws when options.output is not valid', () => {
+      expect(() => {
+        utilityProcess.fork(fixture, [], { stdio: 'pipe', output: { framing: 'words' as any } });
+      }).to.throw(/output.framing must be of the following values/);
+      expect(() => {
+        utilityProcess.fork(fixture, [], { stdio: 'pipe', output: { maxBytesPerSecond: -1 } });
+      }).to.throw(/output.maxBytesPerSecond must be a non-negative number/);
+    });
+
+    it('emits the lines of the piped streams in batches', async () => {
+      const child = utilityProcess.fork(fixture, ['lines'], {
+        stdio: 'pipe',
+        output: {}
+      });
+      expect(child.stdout).to.be.null();
+      expect(child.stderr).to.be.null();
+      const events = collectOutput(child);
+      await waitUntil(() => recordsOf(events, 'stdout').length >= lines.length && recordsOf(events, 'stderr').length > 0);
+      expect(recordsOf(events, 'stdout')).to.deep.equal(lines);
+      // The unterminated last line is emitted when the stream ends.
+      expect(recordsOf(events, 'stderr')).to.deep.equal(['world']);
+      expect(events.filter(event => event.stream === 'stdout')).to.have.length.below(lines.length / 10);
+    });
+
+    it('splits length-prefixed records', async () => {
+      const child = utilityProcess.fork(fixture, ['records'], {
+        stdio: ['ignore', 'pipe', 'ignore'],
+        output: { framing: 'length-prefixed', flushInterval: 10 }
+      });
+      const events = collectOutput(child);
+      await waitUntil(() => recordsOf(events, 'stdout').length >= 1000);
+      const records = recordsOf(events, 'stdout');
+      expect(records.every(record => Buffer.isBuffer(record))).to.be.true();
+      expect(records.map(record => record.toString())).to.deep.equal(lines.map(line => line.replace('line', 'record')));
+    });
+
+    it('drops the records past maxBytesPerSecond and writes everything to logFile', async () => {
+      const logFile = path.join(os.tmpdir(), `utility-output-${Date.now()}.log`);
+      const child = utilityProcess.fork(fixture, ['lines'], {
+        stdio: ['ignore', 'pipe', 'ignore'],
+        output: { maxBytesPerSecond: 100, logFile }
+      });
+      const events = collectOutput(child);
+      await emittedOnce(child, 'exit');
+      await waitUntil(() => fs.existsSync(logFile) && fs.readFileSync(logFile, 'utf8').length >= lines.join('\n').length + 1);
+      try {
+        expect(fs.readFileSync(logFile, 'utf8')).to.equal(lines.join('\n') + '\n');
+      } finally {
+        fs.unlinkSync(logFile);
+      }
+      // Each record is either emitted or counted as dropped.
+      const total = lines.join('').length;
+      const countBytes = () => recordsOf(events, 'stdout').join('').length + events.reduce((dropped, event) => dropped + event.droppedBytes, 0);
+      await waitUntil(() => countBytes() >= total);
+      expect(countBytes()).to.equal(total);
+      expect(recordsOf(events, 'stdout')).to.have.length.below(lines.length);
+    });
+  });
+
   describe('postMessage() API', () => {
     it('establishes a default ipc channel with the child process', async () => {
       const result = 'I will be echoed.';
@@ -375,4 +449,151 @@ describe('utilityProcess module', () => {
       await exit;
     });
   });
+
+  describe('createPool() API', () => {
+    const workerPath = path.join(fixturesPath, 'pool-worker.js');
+
+    it('validates the options', () => {
+      expect(() => utilityProcess.createPool(workerPath, [], { size: 0 })).to.throw(/size must be a positive integer/);
+      expect(() => utilityProcess.createPool(workerPath, [], { spares: -1 })).to.throw(/spares must be a non-negative integer/);
+      expect(() => utilityProcess.createPool(workerPath, [], { strategy: 'random' as any })).to.throw(/strategy must be one of/);
+    });
+
+    it('resolves tasks with the replies of the workers', async () => {
+      const pool = utilityProcess.createPool(workerPath, [], { size: 2, spares: 0 });
+      try {
+        const replies = await Promise.all([1, 2, 3, 4].map(n => pool.run({ n })));
+        expect(replies.map(r => r.data.n)).to.deep.equal([1, 2, 3, 4]);
+        expect(new Set(replies.map(r => r.pid)).size).to.equal(2);
+        const metrics = pool.getWorkerMetrics();
+        expect(metrics).to.have.lengthOf(2);
+        expect(metrics.map(m => m.completedTasks)).to.deep.equal([2, 2]);
+        expect(metrics.map(m => m.queueDepth)).to.deep.equal([0, 0]);
+      } finally {
+        pool.close();
+      }
+    });
+
+    it('dispatches to the least loaded worker', async () => {
+      const pool = utilityProcess.createPool(workerPath, [], { size: 2, spares: 0 });
+      try {
+        const slow = pool.run({ delay: 1000 });
+        await pool.run({});
+        // The first worker is busy, so both tasks go to the second one.
+        const tasks = [pool.run({}), pool.run({})];
+        expect(pool.getWorkerMetrics().map(m => m.queueDepth)).to.deep.equal([1, 2]);
+        await Promise.all([slow, ...tasks]);
+      } finally {
+        pool.close();
+      }
+    });
+
+    it('replaces a worker that exits with a spare', async () => {
+      const pool = utilityProcess.createPool(workerPath, [], { size: 1, spares: 1 });
+      try {
+        const { pid } = await pool.run({});
+        const exited = emittedOnce(pool, 'worker-exit');
+        await expect(pool.run('exit')).to.eventually.be.rejectedWith(/exited with code 1/);
+        await exited;
+        const reply = await pool.run({});
+        expect(reply.pid).to.not.equal(pid);
+        expect(pool.getWorkerMetrics()).to.have.lengthOf(1);
+      } finally {
+        pool.close();
+      }
+    });
+
+    it('gives up when the workers keep failing to start', async function () {
+      this.timeout(20000);
+      const pool = utilityProcess.createPool(path.join(fixturesPath, 'exception.js'), [], { size: 1, spares: 0 });
+      const task = pool.run({});
+      const [error] = await emittedOnce(pool, 'error');
+      expect(error.message).to.match(/failed to start 5 times in a row/);
+      await expect(task).to.eventually.be.rejectedWith(/exited with code|pool was closed/);
+      await expect(pool.run({})).to.eventually.be.rejectedWith(/pool is closed/);
+    });
+
+    it('rejects pending tasks when closed', async () => {
+      const pool = utilityProcess.createPool(workerPath, [], { size: 1 });
+      const task = pool.run({ delay: 1000 });
+      pool.close();
+      await expect(task).to.eventually.be.rejectedWith(/pool was closed/);
+      await expect(pool.run({})).to.eventually.be.rejectedWith(/pool is closed/);
+    });
+  });
+
+  describe('createSharedMemoryChannel() API', () => {
+    const fixture = path.join(fixturesPath, 'shared-memory-channel.js');
+
+    it('validates the capacity', async () => {
+      const child = utilityProcess.fork(fixture, ['echo']);
+      await emittedOnce(child, 'spawn');
+      expect(() => child.createSharedMemoryChannel({ capacity: 0 })).to.throw(/capacity must be between/);
+      const exit = emittedOnce(child, 'exit');
+      child.kill();
+      await exit;
+      expect(() => child.createSharedMemoryChannel()).to.throw(/utility process has exited/);
+    });
+
+    it('streams data in both directions', async () => {
+      const child = utilityProcess.fork(fixture, ['echo']);
+      // A small ring makes the ends wait on each other.
+      const channel = child.createSharedMemoryChannel({ capacity: 1024 });
+      const data = Buffer.alloc(256 * 1024);
+      for (let i = 0; i < data.length; i++) data[i] = i % 251;
+      const chunks: Buffer[] = [];
+      channel.on('data', (chunk: Buffer) => chunks.push(chunk));
+      channel.write(data);
+      await waitUntil(() => chunks.reduce((size, chunk) => size + chunk.length, 0) >= data.length);
+      expect(Buffer.concat(chunks).equals(data)).to.be.true();
+      channel.end();
+      const exit = emittedOnce(child, 'exit');
+      child.kill();
+      await exit;
+    });
+
+    it('keeps the data written before the peer closed while paused', async () => {
+      const size = 512 * 1024;
+      const child = utilityProcess.fork(fixture, ['send', String(size)]);
+      const channel = child.createSharedMemoryChannel({ capacity: 1024 * 1024 });
+      channel.pause();
+      await emittedOnce(child, 'message');
+      // Lets the end of the peer reach this end before reading.
+      await delay(500);
+      const chunks: Buffer[] = [];
+      channel.on('data', (chunk: Buffer) => chunks.push(chunk));
+      const end = emittedOnce(channel, 'end');
+      channel.resume();
+      await end;
+      const data = Buffer.concat(chunks);
+      expect(data.length).to.equal(size);
+      for (let i = 0; i < data.length; i++) {
+        if (data[i] !== i % 251) expect.fail(`byte ${i} differs`);
+      }
+      const exit = emittedOnce(child, 'exit');
+      child.kill();
+      await exit;
+    });
+
+    it('transfers large data intact', async () => {
+      const child = utilityProcess.fork(fixture, ['checksum']);
+      await emittedOnce(child, 'spawn');
+      const channel = child.createSharedMemoryChannel({ capacity: 4 * 1024 * 1024 });
+      let checksum = 0;
+      for (let i = 0; i < 16; i++) {
+        const chunk = Buffer.alloc(1024 * 1024);
+        for (let j = 0; j < chunk.length; j++) {
+          chunk[j] = (i * 7 + j) % 253;
+          checksum = (checksum * 31 + chunk[j]) >>> 0;
+        }
+        channel.write(chunk);
+      }
+      channel.end();
+      const [result] = await emittedOnce(child, 'message');
+      expect(result).to.deep.equal({ size: 16 * 1024 * 1024, checksum });
+      const exit = emittedOnce(child, 'exit');
+      child.kill();
+      await exit;
+    });
+  });
 });
@@ -2,7 +2,9 @@ import { expect } from 'chai';
 import { AddressInfo } from 'net';
 import * as path from 'path';
 import * as fs from 'fs';
+import * as os from 'os';
 import * as http from 'http';
+import * as zlib from 'zlib';
 import { BrowserWindow, ipcMain, webContents, session, WebContents, app, BrowserView } from 'electron/main';
 import { emittedOnce } from './events-helpers';
 import { closeAllWindows } from './window-helpers';
@@ -1857,6 +1859,76 @@ describe('webContents module', () => {
     });
   });
 
+  describe('createHeapSnapshotStream()', () => {
+    afterEach(closeAllWindows);
+
+    const readStream = (stream: NodeJS.ReadableStream) => new Promise<Buffer>((resolve, reject) => {
+      const chunks: Buffer[] = [];
+      stream.on('data', (chunk: Buffer) => chunks.push(chunk));
+      stream.on('end', () => resolve(Buffer.concat(chunks)));
+      stream.on('error', reject);
+    });
+
+    it('streams a gzip-compressed snapshot', async () => {
+      const w = new BrowserWindow({ show: false, webPreferences: { sandbox: true } });
+      await w.loadURL('about:blank');
+      const stream = w.webContents.createHeapSnapshotStream();
+      const progress: Electron.HeapSnapshotProgress[] = [];
+      stream.on('progress', (p) => { progress.push(p); });
+      const data = await readStream(stream);
+      const snapshot = JSON.parse(zlib.gunzipSync(data).toString());
+      expect(snapshot).to.have.property('snapshot');
+      expect(progress).to.not.be.empty();
+      const last = progress[progress.length - 1];
+      expect(last.bytesWritten).to.equal(data.length);
+      expect(last.bytesSerialized).to.be.greaterThan(data.length);
+    });
+
+    it('streams an uncompressed snapshot', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const data = await readStream(w.webContents.createHeapSnapshotStream({ compress: false }));
+      expect(JSON.parse(data.toString())).to.have.property('snapshot');
+    });
+
+    it('keeps the snapshot intact while the stream is paused', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      const stream = w.webContents.createHeapSnapshotStream({ compress: false });
+      stream.pause();
+      await delay(500);
+      const data = await readStream(stream);
+      expect(JSON.parse(data.toString())).to.have.property('snapshot');
+    });
+
+    it('fails with invalid render process', async () => {
+      const w = new BrowserWindow({ show: false });
+      w.webContents.destroy();
+      const stream = w.webContents.createHeapSnapshotStream();
+      await expect(readStream(stream)).to.eventually.be.rejectedWith(Error, 'Failed to take heap snapshot with nonexistent render frame');
+    });
+  });
+
+  describe('startSamplingHeapProfiler()', () => {
+    afterEach(closeAllWindows);
+
+    it('records a heap profile', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await w.webContents.startSamplingHeapProfiler({ samplingInterval: 1024 });
+      await w.webContents.executeJavaScript('window.retained = Array.from({ length: 10000 }, (_, i) => ({ i })); null');
+      const profile = JSON.parse(await w.webContents.stopSamplingHeapProfiler());
+      expect(profile).to.have.nested.property('head.callFrame');
+      expect(profile.samples).to.be.an('array').that.is.not.empty();
+    });
+
+    it('rejects when the profiler is not running', async () => {
+      const w = new BrowserWindow({ show: false });
+      await w.loadURL('about:blank');
+      await expect(w.webContents.stopSamplingHeapProfiler()).to.eventually.be.rejectedWith(Error, 'The heap profiler is not running');
+    });
+  });
+
   describe('setBackgroundThrottling()', () => {
     afterEach(closeAllWindows);
     it('does not crash when allowing', () => {
@@ -2084,6 +2156,59 @@ describe('webContents module', () => {
       // Check that correct # of pages are rendered.
       expect(doc.numPages).to.equal(3);
     });
+
+    it('prints in parallel across WebContents', async () => {
+      const w2 = new BrowserWindow({ show: false, webPreferences: { sandbox: true } });
+      await Promise.all([
+        w.loadURL('data:text/html,<h1>Hello, World!</h1>'),
+        w2.loadURL('data:text/html,<h1>Hello, Again!</h1>')
+      ]);
+
+      const results = await Promise.all([
+        w.webContents.printToPDF({}),
+        w2.webContents.printToPDF({})
+      ]);
+      for (const data of results) {
+        expect(data).to.be.an.instanceof(Buffer).that.is.not.empty();
+      }
+    });
+
+    describe('printToPDFFile()', () => {
+      let tmpDir: string;
+
+      beforeEach(() => {
+        tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-print-'));
+      });
+
+      afterEach(() => {
+        fs.rmSync(tmpDir, { recursive: true, force: true });
+      });
+
+      it('writes the PDF to a file', async () => {
+        await w.loadFile(path.join(__dirname, 'fixtures', 'api', 'print-to-pdf-large.html'));
+
+        const filePath = path.join(tmpDir, 'out.pdf');
+        const result = await w.webContents.printToPDFFile(filePath, { pageRanges: '1-3' });
+        expect(result).to.be.undefined();
+
+        const doc = await pdfjs.getDocument(fs.readFileSync(filePath)).promise;
+        expect(doc.numPages).to.equal(3);
+      });
+
+      it('rejects when the file can not be written', async () => {
+        await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
+
+        const filePath = path.join(tmpDir, 'missing', 'out.pdf');
+        await expect(w.webContents.printToPDFFile(filePath)).to.eventually.be.rejectedWith(/Failed to write PDF/);
+      });
+
+      it('rejects on incorrectly typed parameters', async () => {
+        await w.loadURL('data:text/html,<h1>Hello, World!</h1>');
+
+        await expect(w.webContents.printToPDFFile(1 as any)).to.eventually.be.rejectedWith('filePath must be a String');
+        await expect(w.webContents.printToPDFFile(path.join(tmpDir, 'out.pdf'), { scale: 'big' } as any)).to.eventually.be.rejectedWith('scale must be a Number');
+      });
+    });
   });
 
   describe('PictureInPicture video', () => {
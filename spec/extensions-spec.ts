@@ -122,6 +122,68 @@ describe('chrome extensions', () => {
     await expect(promise).to.eventually.be.rejected();
   });
 
+  describe('ses.loadExtensions()', () => {
+    it('loads extensions in one batch', async () => {
+      const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+      const extensions = await customSession.loadExtensions([
+        path.join(fixtures, 'extensions', 'red-bg'),
+        path.join(fixtures, 'extensions', 'chrome-i18n')
+      ]);
+      expect(extensions.map(extension => extension.name)).to.deep.equal(['red-bg', 'chrome-i18n']);
+      expect(customSession.getAllExtensions().map(extension => extension.id)).to.have.members(extensions.map(extension => extension.id));
+    });
+
+    it('does not add any extension when one of them fails to load', async () => {
+      const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+      const promise = customSession.loadExtensions([
+        path.join(fixtures, 'extensions', 'red-bg'),
+        path.join(fixtures, 'extensions', 'missing-manifest')
+      ]);
+      await expect(promise).to.eventually.be.rejectedWith(/Manifest file is missing or unreadable/);
+      expect(customSession.getAllExtensions()).to.deep.equal([]);
+    });
+
+    it('rejects duplicate paths', async () => {
+      const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+      const extensionPath = path.join(fixtures, 'extensions', 'red-bg');
+      await expect(customSession.loadExtensions([extensionPath, extensionPath])).to.eventually.be.rejectedWith(/must be unique/);
+    });
+  });
+
+  it('reloads the cached manifest only while the extension is unchanged', async () => {
+    const extensionPath = fs.mkdtempSync(path.join(app.getPath('temp'), 'electron-extension-'));
+    const manifestPath = path.join(extensionPath, 'manifest.json');
+    // The fingerprint of the directory is made from the size and modification
+    // time of its files, so rewriting the manifest with the same size and time
+    // goes unnoticed, which shows whether the cached copy was used.
+    const mtime = new Date(2020, 0, 1);
+    const writeManifest = (name: string) => {
+      fs.writeFileSync(manifestPath, JSON.stringify({ name, version: '1.0', manifest_version: 2 }));
+      fs.utimesSync(manifestPath, mtime, mtime);
+    };
+    try {
+      writeManifest('cached-a');
+      const customSession = session.fromPartition(`persist:${uuid.v4()}`);
+      // A failed batch adds none of the extensions, but the ones that loaded
+      // are still cached.
+      await expect(customSession.loadExtensions([
+        extensionPath,
+        path.join(fixtures, 'extensions', 'missing-manifest')
+      ])).to.eventually.be.rejected();
+
+      writeManifest('cached-b');
+      const cached = await customSession.loadExtension(extensionPath);
+      expect(cached.name).to.equal('cached-a');
+      customSession.removeExtension(cached.id);
+
+      writeManifest('not cached');
+      const extension = await customSession.loadExtension(extensionPath);
+      expect(extension.name).to.equal('not cached');
+    } finally {
+      fs.rmSync(extensionPath, { recursive: true, force: true });
+    }
+  });
+
   it('serializes a loaded extension', async () => {
     const extensionPath = path.join(fixtures, 'extensions', 'red-bg');
     const manifest = JSON.parse(fs.readFileSync(path.join(extensionPath, 'manifest.json'), 'utf-8'));
@@ -0,0 +1,16 @@
+const mode = process.argv[2];
+const count = 1000;
+
+if (mode === 'lines') {
+  for (let i = 0; i < count; i++) {
+    process.stdout.write(`line ${i}\n`);
+  }
+  process.stderr.write('world');
+} else if (mode === 'records') {
+  for (let i = 0; i < count; i++) {
+    const record = Buffer.from(`record ${i}`);
+    const size = Buffer.alloc(4);
+    size.writeUInt32BE(record.length);
+    process.stdout.write(Buffer.concat([size, record]));
+  }
+}
@@ -0,0 +1,8 @@
+process.parentPort.on('message', (e) => {
+  if (e.data === 'exit') {
+    process.exit(1);
+  }
+  setTimeout(() => {
+    process.parentPort.postMessage({ data: e.data, pid: process.pid });
+  }, e.data.delay || 0);
+});
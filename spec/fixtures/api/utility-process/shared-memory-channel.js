@@ -0,0 +1,19 @@
+const mode = process.argv[2];
+
+process.parentPort.on('channel', (channel) => {
+  if (mode === 'echo') {
+    channel.pipe(channel);
+  } else if (mode === 'send') {
+    const data = Buffer.alloc(Number(process.argv[3]));
+    for (let i = 0; i < data.length; i++) data[i] = i % 251;
+    channel.end(data, () => process.parentPort.postMessage('sent'));
+  } else {
+    let size = 0;
+    let checksum = 0;
+    channel.on('data', (chunk) => {
+      size += chunk.length;
+      for (let i = 0; i < chunk.length; i++) checksum = (checksum * 31 + chunk[i]) >>> 0;
+    });
+    channel.on('end', () => process.parentPort.postMessage({ size, checksum }));
+  }
+});
@@ -159,7 +159,8 @@ declare namespace NodeJS {
 
   interface URLLoader extends EventEmitter {
     cancel(): void;
-    on(eventName: 'data', listener: (event: any, data: ArrayBuffer, resume: () => void) => void): this;
+    pipeToFile(filePath: string): void;
+    on(eventName: 'data', listener: (event: any, data: Buffer, resume: () => void) => void): this;
     on(eventName: 'response-started', listener: (event: any, finalUrl: string, responseHead: ResponseHead) => void): this;
     on(eventName: 'complete', listener: (event: any) => void): this;
     on(eventName: 'error', listener: (event: any, netErrorString: string) => void): this;
@@ -195,6 +196,7 @@ declare namespace NodeJS {
     };
     _linkedBinding(name: 'electron_browser_desktop_capturer'): {
       createDesktopCapturer(): ElectronInternal.DesktopCapturer;
+      createSourceWatcher(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean, updateInterval: number): Electron.DesktopCapturerSourceWatcher;
     };
     _linkedBinding(name: 'electron_browser_event'): {
       createWithSender(sender: Electron.WebContents): Electron.Event;
@@ -206,6 +208,26 @@ declare namespace NodeJS {
     _linkedBinding(name: 'electron_browser_global_shortcut'): { globalShortcut: Electron.GlobalShortcut };
     _linkedBinding(name: 'electron_browser_image_view'): { ImageView: any };
     _linkedBinding(name: 'electron_browser_in_app_purchase'): { inAppPurchase: Electron.InAppPurchase };
+    _linkedBinding(name: 'electron_browser_content_tracing'): {
+      getCategories(): Promise<string[]>;
+      startRecording(options: Electron.TraceConfig | Electron.TraceCategoriesAndOptions): Promise<void>;
+      stopRecording(resultFilePath?: string): Promise<string>;
+      getTraceBufferUsage(): Promise<Electron.TraceBufferUsageReturnValue>;
+      startFlightRecorder(options: Electron.TraceConfig | Electron.TraceCategoriesAndOptions): Promise<void>;
+      stopFlightRecorder(): Promise<void>;
+      isFlightRecorderRunning(): boolean;
+      snapshot(resultFilePath?: string): Promise<string>;
+      snapshotStream(onData: (chunk: Buffer) => void, onEnd: (error: string) => void): boolean;
+    };
+    _linkedBinding(name: 'electron_browser_ipc_main'): {
+      setInvokeDispatcher(dispatcher: (event: Electron.IpcMainInvokeEvent, channel: string, handler: Function, args: any[]) => void): void;
+      addInvokeHandler(channel: string, handler: (event: Electron.IpcMainInvokeEvent, ...args: any[]) => void): void;
+      removeInvokeHandler(channel: string): void;
+      addScopedInvokeHandler(channel: string): void;
+      removeScopedInvokeHandler(channel: string): void;
+      getChannelStats(): Electron.IpcChannelStats[];
+      resetChannelStats(): void;
+    };
     _linkedBinding(name: 'electron_browser_message_port'): {
       createPair(): { port1: Electron.MessagePortMain, port2: Electron.MessagePortMain };
     };
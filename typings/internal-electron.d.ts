@@ -69,6 +69,9 @@ declare namespace Electron {
     _send(internal: boolean, channel: string, args: any): boolean;
     _sendInternal(channel: string, ...args: any[]): void;
     _printToPDF(options: any): Promise<Buffer>;
+    _printToPDFFile(options: any, filePath: string): Promise<void>;
+    _streamHeapSnapshot(compress: boolean, onData: (chunk: Buffer) => boolean, onProgress: (progress: Electron.HeapSnapshotProgress) => void, onEnd: (error: string) => void): () => void;
+    _createPageCapture(pageSize: Electron.Size): ElectronInternal.PageCapture;
     _print(options: any, callback?: (success: boolean, failureReason: string) => void): void;
     _getPrinters(): Electron.PrinterInfo[];
     _getPrintersAsync(): Promise<Electron.PrinterInfo[]>;
@@ -112,6 +115,10 @@ declare namespace Electron {
     _callMenuWillShow(): void;
     _executeCommand(event: any, id: number): void;
     _menuWillShow(): void;
+    _setCommandStates(states: MenuItemCommandState[]): void;
+    _updateCommandStates(items: MenuItem[]): void;
+    _flushCommandStates(): void;
+    _pendingCommandStates: MenuItem[];
     commandsMap: Record<string, MenuItem>;
     groupsMap: Record<string, MenuItem[]>;
     getItemCount(): number;
@@ -135,9 +142,22 @@ declare namespace Electron {
     groupId: number;
     getDefaultRoleAccelerator(): Accelerator | undefined;
     getCheckStatus(): boolean;
+    getCommandState(): MenuItemCommandState;
     acceleratorWorksWhenHidden?: boolean;
   }
 
+  interface MenuItemCommandState {
+    commandId: number;
+    checked: boolean;
+    dynamicChecked: boolean;
+    enabled: boolean;
+    visible: boolean;
+    acceleratorWorksWhenHidden: boolean;
+    registerAccelerator: boolean;
+    accelerator?: Accelerator;
+    defaultAccelerator?: Accelerator;
+  }
+
   interface IpcMainEvent {
     sendReply(value: any): void;
   }
@@ -188,6 +208,11 @@ declare namespace Electron {
 }
 
 declare namespace ElectronInternal {
+  interface PageCapture {
+    captureTile(viewRect: Electron.Rectangle, offset: Electron.Point): Promise<void>;
+    encode(format: string, quality: number, filePath?: string): Promise<Buffer | string>;
+  }
+
   interface DesktopCapturer {
     startHandling(captureWindow: boolean, captureScreen: boolean, thumbnailSize: Electron.Size, fetchWindowIcons: boolean): void;
     _onerror?: (error: string) => void;
@@ -259,6 +284,14 @@ declare namespace ElectronInternal {
     readonly pid: (number) | (undefined);
     kill(): boolean;
     postMessage(message: any, transfer?: any[]): void;
+    createSharedMemoryChannel(options?: Electron.CreateSharedMemoryChannelOptions): SharedMemoryChannel;
+  }
+
+  interface SharedMemoryChannel extends NodeJS.EventEmitter {
+    readonly capacity: number;
+    write(data: Buffer): number;
+    read(): Buffer | null;
+    close(): void;
   }
 
   interface ParentPort extends NodeJS.EventEmitter {